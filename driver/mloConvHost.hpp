@@ -27,10 +27,13 @@
 #ifndef MLO_CONVHOST_H_
 #define MLO_CONVHOST_H_
 
+#include <miopen/par_for.hpp>
 #include <miopen/tensor.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 #include "calcerr.hpp"
 
@@ -40,6 +43,86 @@
 //
 ///////////////////////////////////////////////////////////
 #define ADNN_MM_TRANSPOSE 1
+
+namespace adnn_mm_detail {
+
+// Block sizes of the host GEMM. A tile of C (MC x NC) is computed by one thread,
+// walking K in KC steps over packed, contiguous copies of the A and B blocks so
+// the innermost loop is a unit stride axpy the compiler can vectorize.
+constexpr std::size_t MC = 64;
+constexpr std::size_t NC = 128;
+constexpr std::size_t KC = 256;
+
+template <typename Dtype>
+void gemm_tile(const Dtype* a_ptr,
+               size_t a_stride,
+               bool a_trans,
+               const Dtype* b_ptr,
+               size_t b_stride,
+               bool b_trans,
+               Dtype* c_ptr,
+               size_t c_stride,
+               size_t row0,
+               size_t rows,
+               size_t col0,
+               size_t cols,
+               size_t inner_loop,
+               Dtype alpha,
+               Dtype beta)
+{
+    std::vector<Dtype> acc(rows * cols, static_cast<Dtype>(0));
+    std::vector<Dtype> a_pack(rows * std::min(KC, inner_loop));
+    std::vector<Dtype> b_pack(std::min(KC, inner_loop) * cols);
+
+    for(size_t k0 = 0; k0 < inner_loop; k0 += KC)
+    {
+        const auto depth = std::min(KC, inner_loop - k0);
+
+        // a_pack is op(A) rows x depth, row-major
+        for(size_t n = 0; n < rows; ++n)
+        {
+            for(size_t m = 0; m < depth; ++m)
+            {
+                a_pack[n * depth + m] = a_trans ? a_ptr[(k0 + m) * a_stride + row0 + n]
+                                                : a_ptr[(row0 + n) * a_stride + k0 + m];
+            }
+        }
+
+        // b_pack is op(B) depth x cols, row-major
+        for(size_t m = 0; m < depth; ++m)
+        {
+            for(size_t k = 0; k < cols; ++k)
+            {
+                b_pack[m * cols + k] = b_trans ? b_ptr[(col0 + k) * b_stride + k0 + m]
+                                               : b_ptr[(k0 + m) * b_stride + col0 + k];
+            }
+        }
+
+        for(size_t n = 0; n < rows; ++n)
+        {
+            Dtype* acc_row = &acc[n * cols];
+            for(size_t m = 0; m < depth; ++m)
+            {
+                const Dtype a      = a_pack[n * depth + m];
+                const Dtype* b_row = &b_pack[m * cols];
+                for(size_t k = 0; k < cols; ++k)
+                    acc_row[k] += a * b_row[k];
+            }
+        }
+    }
+
+    for(size_t n = 0; n < rows; ++n)
+    {
+        Dtype* c_row = &c_ptr[(row0 + n) * c_stride + col0];
+        for(size_t k = 0; k < cols; ++k)
+            c_row[k] = beta * c_row[k] + alpha * acc[n * cols + k];
+    }
+}
+
+} // namespace adnn_mm_detail
+
+// C = alpha * op(A) * op(B) + beta * C, where op transposes the matrix if its flags
+// have ADNN_MM_TRANSPOSE. Tiles of C are computed in parallel on the par_for pool.
 template <typename Dtype>
 void ADNN_mm_cpu(const Dtype* a_ptr,
                  size_t a_cols,
@@ -59,11 +142,6 @@ void ADNN_mm_cpu(const Dtype* a_ptr,
                  double d_alpha,
                  double d_beta)
 {
-    // mA
-
-    // mB
-
-    // mC
     Dtype alpha = Dtype(d_alpha);
     Dtype beta  = Dtype(d_beta);
     if((!(a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE) &&
@@ -85,92 +163,32 @@ void ADNN_mm_cpu(const Dtype* a_ptr,
         return;
     }
 
-    size_t inner_loop = (!(a_flags & ADNN_MM_TRANSPOSE)) ? a_cols : a_rows;
-
-    if(!(a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[m * b_stride + k];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if((a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[m * a_stride + n] * b_ptr[m * b_stride + k];
-#if 0
-                    if (
-                        (n == 0 && k == 33
-                        || n == 1 && k == 32
-                        || n == 3 && k == 1
-                        || n == 4 && k == 0
-
-                        )
-                        && a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k] != 0
-                        )
-                    {
-                        printf("C:mm:%d %d %d   %11.9f %11.9f %11.9f %11.9f\n",
-                            n, k, m,
-                            mm_e, a_ptr[m*a_stride + n], b_ptr[m*b_stride + k], a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k]);
-                    }
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if(!(a_flags & ADNN_MM_TRANSPOSE) && (b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[k * b_stride + m];
-#if 0
-                    if (n == 0 && k == 6 && a_ptr[n*a_stride + m] * b_ptr[k*b_stride + m] != 0)
-                    {
-                        printf("%4d  %11.9f %11.9f %11.9f\n", m, mm_e, a_ptr[n*a_stride + m], b_ptr[k*b_stride + m]);
-                    }
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    c_ptr[n * c_stride + k] += a_ptr[m * a_stride + n] * b_ptr[k * b_stride + m];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
+    const bool a_trans      = (a_flags & ADNN_MM_TRANSPOSE) != 0;
+    const bool b_trans      = (b_flags & ADNN_MM_TRANSPOSE) != 0;
+    const size_t inner_loop = !a_trans ? a_cols : a_rows;
+
+    const size_t row_tiles = (c_rows + adnn_mm_detail::MC - 1) / adnn_mm_detail::MC;
+    const size_t col_tiles = (c_cols + adnn_mm_detail::NC - 1) / adnn_mm_detail::NC;
+
+    miopen::par_for(row_tiles * col_tiles, 1, [&](std::size_t tile) {
+        const auto row0 = (tile / col_tiles) * adnn_mm_detail::MC;
+        const auto col0 = (tile % col_tiles) * adnn_mm_detail::NC;
+        adnn_mm_detail::gemm_tile(a_ptr,
+                                  a_stride,
+                                  a_trans,
+                                  b_ptr,
+                                  b_stride,
+                                  b_trans,
+                                  c_ptr,
+                                  c_stride,
+                                  row0,
+                                  std::min(adnn_mm_detail::MC, c_rows - row0),
+                                  col0,
+                                  std::min(adnn_mm_detail::NC, c_cols - col0),
+                                  inner_loop,
+                                  alpha,
+                                  beta);
+    });
 }
 
 template <typename Dtype>
@@ -1049,50 +1067,77 @@ bool mloVerify(const miopenTensorDescriptor_t& cpu_,
     std::tie(g_batch_stride, g_channel_stride, g_depth_stride, g_height_stride, g_width_stride) =
         miopen::GetNCDHW(spatial_dim, gpu.GetStrides());
 
-    bool match          = true;
-    double rms_accum    = 0.0;
-    Tcheck_ worst_c_val = static_cast<Tcheck_>(0);
-    Tcheck_ worst_g_val = static_cast<Tcheck_>(0);
-    Tcheck_ worst_diff  = static_cast<Tcheck_>(0);
-    size_t worst_b = 0, worst_c = 0, worst_i = 0, worst_j = 0, worst_k = 0;
+    bool match = true;
 
-    for(size_t b = 0; b < n_batchs; ++b)
+    // Partial results of one (batch, channel) slab. Slabs are reduced in order after
+    // the parallel pass, so the worst error reported is the first one, as in a serial loop.
+    struct slab_error
     {
-        for(size_t c = 0; c < n_channels; ++c)
+        double rms_accum    = 0.0;
+        Tcheck_ worst_c_val = static_cast<Tcheck_>(0);
+        Tcheck_ worst_g_val = static_cast<Tcheck_>(0);
+        Tcheck_ worst_diff  = static_cast<Tcheck_>(0);
+        size_t worst_k = 0, worst_j = 0, worst_i = 0;
+    };
+    std::vector<slab_error> slabs(n_batchs * n_channels);
+
+    miopen::par_for(slabs.size(), 1, [&](size_t slab) {
+        const auto b = slab / n_channels;
+        const auto c = slab % n_channels;
+        auto& e      = slabs[slab];
+        for(size_t k = 0; k < depth; ++k)
         {
-            for(size_t k = 0; k < depth; ++k)
+            for(size_t j = 0; j < height; ++j)
             {
-                for(size_t j = 0; j < height; ++j)
+                for(size_t i = 0; i < width; ++i)
                 {
-                    for(size_t i = 0; i < width; ++i)
+                    Tcheck_ c_val = c_ptr[b * c_batch_stride + c * c_channel_stride +
+                                          k * c_depth_stride + j * c_height_stride +
+                                          i * c_width_stride];
+                    Tcheck_ g_val = static_cast<Tcheck_>(
+                        g_ptr[b * g_batch_stride + c * g_channel_stride + k * g_depth_stride +
+                              j * g_height_stride + i * g_width_stride]);
+
+                    Tcheck_ diff = std::abs(c_val - g_val);
+                    e.rms_accum += diff * diff;
+                    // Register worst (max) abs error and its position.
+                    // This info will be used to show additional diagnostics,
+                    // but only if sgr_accum is too big.
+                    if(diff > e.worst_diff)
                     {
-                        Tcheck_ c_val =
-                            c_ptr[b * c_batch_stride + c * c_channel_stride + k * c_depth_stride +
-                                  j * c_height_stride + i * c_width_stride];
-                        Tcheck_ g_val = static_cast<Tcheck_>(
-                            g_ptr[b * g_batch_stride + c * g_channel_stride + k * g_depth_stride +
-                                  j * g_height_stride + i * g_width_stride]);
-
-                        Tcheck_ diff = std::abs(c_val - g_val);
-                        rms_accum += diff * diff;
-                        // Register worst (max) abs error and its position.
-                        // This info will be used to show additional diagnostics,
-                        // but only if sgr_accum is too big.
-                        if(diff > worst_diff)
-                        {
-                            worst_diff  = diff;
-                            worst_c_val = c_val;
-                            worst_g_val = g_val;
-                            worst_b     = b;
-                            worst_c     = c;
-                            worst_i     = i;
-                            worst_j     = j;
-                            worst_k     = k;
-                        }
+                        e.worst_diff  = diff;
+                        e.worst_c_val = c_val;
+                        e.worst_g_val = g_val;
+                        e.worst_k     = k;
+                        e.worst_j     = j;
+                        e.worst_i     = i;
                     }
                 }
             }
         }
+    });
+
+    double rms_accum    = 0.0;
+    Tcheck_ worst_c_val = static_cast<Tcheck_>(0);
+    Tcheck_ worst_g_val = static_cast<Tcheck_>(0);
+    Tcheck_ worst_diff  = static_cast<Tcheck_>(0);
+    size_t worst_b = 0, worst_c = 0, worst_i = 0, worst_j = 0, worst_k = 0;
+
+    for(size_t slab = 0; slab < slabs.size(); ++slab)
+    {
+        const auto& e = slabs[slab];
+        rms_accum += e.rms_accum;
+        if(e.worst_diff > worst_diff)
+        {
+            worst_diff  = e.worst_diff;
+            worst_c_val = e.worst_c_val;
+            worst_g_val = e.worst_g_val;
+            worst_b     = slab / n_channels;
+            worst_c     = slab % n_channels;
+            worst_k     = e.worst_k;
+            worst_j     = e.worst_j;
+            worst_i     = e.worst_i;
+        }
     }
 
     const double rms = std::sqrt(
@@ -5503,6 +5503,19 @@ typedef enum
     miopenFindResultsOrderByWorkspaceSize = 1,
 } miopenFindResultsOrder_t;
 
+#ifdef MIOPEN_BETA_API
+/*! @enum miopenFindTimingPolicy_t
+ * Different ways to measure the execution time of solutions during the find call.
+ */
+typedef enum
+{
+    miopenFindTimingPolicyDefault  = 0, /*!< Set by MIOPEN_FIND_TIMING_POLICY, adaptive if unset */
+    miopenFindTimingPolicyFixed    = 1, /*!< Up to 8 runs, mean of the runs after warm-up */
+    miopenFindTimingPolicyAdaptive = 2, /*!< Median of as many runs as needed to rank solutions.
+                                             Clearly slower solutions are abandoned early. */
+} miopenFindTimingPolicy_t;
+#endif
+
 /*! @brief Initializes a problem object describing a convolution operation.
  *
  * @param problem      Pointer to the problem to initialize
@@ -5704,6 +5717,18 @@ MIOPEN_EXPORT miopenStatus_t miopenSetFindOptionPreallocatedTensor(miopenFindOpt
 MIOPEN_EXPORT miopenStatus_t miopenSetFindOptionAttachBinaries(miopenFindOptions_t options,
                                                                unsigned attach);
 
+#ifdef MIOPEN_BETA_API
+/*! @brief Sets the policy used to measure the execution time of solutions during the find call.
+ * Default value is miopenFindTimingPolicyDefault.
+ *
+ * @param options    Options object to update
+ * @param value      Specifies the timing policy
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetFindOptionTimingPolicy(miopenFindOptions_t options,
+                                                             miopenFindTimingPolicy_t value);
+#endif
+
 /*! @brief The miopenSolution object describes a prepared solution.
  */
 MIOPEN_DECLARE_OBJECT(miopenSolution);
@@ -5726,6 +5751,33 @@ MIOPEN_EXPORT miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
                                                  size_t* numSolutions,
                                                  size_t maxSolutions);
 
+#ifdef MIOPEN_BETA_API
+/*! @brief Finds solutions to several problems at once. Memory is automatically allocated.
+ *
+ * Convolution problems with equal configurations are searched once, and the kernels of all
+ * searched convolutions are compiled before any of them is benchmarked. Other problems are
+ * searched one by one. Preallocated tensors and workspace from the options are shared by all
+ * problems and must be large enough for each of them.
+ *
+ * @param handle       Handle to execute the kernels
+ * @param problems     Array of the problems to solve. Must not be null unless numProblems is 0
+ * @param numProblems  Amount of the problems
+ * @param options      Find options. When null default values would be used
+ * @param solutions    Pointer to the first result. Results of the i-th problem start at
+ *                     solutions + i * maxSolutions. Must not be null unless numProblems is 0
+ * @param numSolutions Array of the amounts of results of each problem. Ignored if null
+ * @param maxSolutions Limits the amount of results of each problem
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenFindSolutionsBatch(miopenHandle_t handle,
+                                                      const miopenProblem_t* problems,
+                                                      size_t numProblems,
+                                                      miopenFindOptions_t options,
+                                                      miopenSolution_t* solutions,
+                                                      size_t* numSolutions,
+                                                      size_t maxSolutions);
+#endif
+
 /*! @brief Values of a tensor or scalar argument for the miopenRunSolution function.
  */
 struct miopenTensorArgument_t
@@ -5771,6 +5823,8 @@ MIOPEN_EXPORT miopenStatus_t miopenRunSolution(miopenHandle_t handle,
 MIOPEN_EXPORT miopenStatus_t miopenDestroySolution(miopenSolution_t solution);
 
 /*! @brief Loads solution object from binary data.
+ *
+ * Accepts data saved by miopenSaveSolution in either format, see miopenSaveSolution.
  *
  * @param solution   Pointer to the solution to load
  * @param data       Data to load the solution from
@@ -5782,6 +5836,12 @@ MIOPEN_EXPORT miopenStatus_t miopenLoadSolution(miopenSolution_t* solution,
                                                 size_t size);
 
 /*! @brief Saves a solution object as binary data.
+ *
+ * By default the solution is saved as msgpack encoded json, the format used by all previous
+ * versions. If the MIOPEN_SAVE_SOLUTION_AS_BINARY environment variable is set, a versioned binary
+ * container is produced instead: code objects are stored as raw bytes aligned to 64 bytes, which
+ * makes saving and loading solutions with large kernels cheaper. Data in this format can't be
+ * loaded by versions of the library that predate it.
  *
  * @param solution   Solution to save
  * @param data       Pointer to a buffer to save soltuion to
@@ -0,0 +1,95 @@
+#include <cpu_conv.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace cpu_conv_speedtest {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(n, "n");
+        add(c, "c");
+        add(k, "k");
+        add(hw, "hw");
+        add(filter, "filter");
+        add(nhwc, "nhwc", flag());
+    }
+
+    void run()
+    {
+        const auto layout = nhwc ? miopenTensorNHWC : miopenTensorNCHW;
+        const auto pad    = filter / 2;
+
+        auto in  = tensor<float>{layout, std::vector<int>{n, c, hw, hw}};
+        auto wei = tensor<float>{layout, std::vector<int>{k, c, filter, filter}};
+        auto out = tensor<float>{layout, std::vector<int>{n, k, hw, hw}};
+        in.generate(tensor_elem_gen_integer{17});
+        wei.generate(tensor_elem_gen_integer{17});
+        out.generate(tensor_elem_gen_integer{17});
+
+        const auto pads      = std::vector<int>{pad, pad};
+        const auto strides   = std::vector<int>{1, 1};
+        const auto dilations = std::vector<int>{1, 1};
+
+        std::cout << std::setw(10) << "algo" << std::setw(10) << "fwd, ms" << std::setw(10)
+                  << "bwd, ms" << std::setw(10) << "wrw, ms" << std::endl;
+
+        for(const auto* algo : {"naive", "direct", "fast"})
+        {
+            env::update(MIOPEN_DEBUG_TEST_CPU_CONV_ALGO, std::string{algo});
+
+            const auto fwd = Measure([&] {
+                cpu_convolution_forward(2, in, wei, out, pads, strides, dilations, 1);
+            });
+            const auto bwd = Measure([&] {
+                cpu_convolution_backward_data(2, in, wei, out, pads, strides, dilations, 1);
+            });
+            const auto wrw = Measure([&] {
+                cpu_convolution_backward_weight(2, in, wei, out, pads, strides, dilations, 1);
+            });
+
+            std::cout << std::setw(10) << algo << std::setw(10) << fwd << std::setw(10) << bwd
+                      << std::setw(10) << wrw << std::endl;
+        }
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Compares the algorithms of the CPU reference convolutions." << std::endl;
+    }
+
+private:
+    int n      = 4;
+    int c      = 64;
+    int k      = 64;
+    int hw     = 28;
+    int filter = 3;
+    bool nhwc  = false;
+
+    template <class F>
+    static double Measure(F f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+};
+
+} // namespace cpu_conv_speedtest
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::cpu_conv_speedtest::SpeedTestDriver>(argc, argv);
+    return 0;
+}
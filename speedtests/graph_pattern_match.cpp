@@ -0,0 +1,171 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/graphapi/pattern_registry.hpp>
+#include <miopen/graphapi/util.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace graph_pattern_match {
+
+using graphapi::GraphPatternMatcher;
+using graphapi::GraphPatternRegistry;
+using graphapi::OpGraph;
+using graphapi::PatternGraphGenerator;
+
+class SyntheticPattern : public GraphPatternMatcher
+{
+    std::string mName;
+    std::unique_ptr<PatternGraphGenerator> mGraphGen;
+
+public:
+    SyntheticPattern(std::string name, std::unique_ptr<PatternGraphGenerator> graph_gen)
+        : mName(std::move(name)), mGraphGen(std::move(graph_gen))
+    {
+    }
+
+    bool matches(const OpGraph* graph) const final
+    {
+        return graphapi::isIsomorphic(*graph, mGraphGen->graph());
+    }
+
+    std::vector<graphapi::Engine> getEngines(OpGraph*) const final { return {}; }
+
+    std::string_view name() const final { return mName; }
+
+    const OpGraph& patternGraph() const final { return mGraphGen->graph(); }
+};
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(patterns, "patterns");
+        add(nodes, "nodes");
+        add(graphs, "graphs");
+        add(runs, "runs");
+    }
+
+    void run()
+    {
+        // Graphs are generated from seeds, so a query made from the seed of a pattern matches it.
+        auto registry = GraphPatternRegistry{};
+        for(auto i = 0; i < patterns; ++i)
+        {
+            registry.add(
+                std::make_unique<SyntheticPattern>("pattern_" + std::to_string(i), MakeGraph(i)));
+        }
+
+        // Every other query matches a pattern, the rest most likely match nothing.
+        auto queries = std::vector<std::unique_ptr<PatternGraphGenerator>>{};
+        for(auto i = 0; i < graphs; ++i)
+            queries.push_back(MakeGraph(i % 2 == 0 && patterns > 0 ? i / 2 % patterns : -1 - i));
+
+        std::cout << std::setw(10) << "patterns" << std::setw(8) << "nodes" << std::setw(20)
+                  << "linear, graph/s" << std::setw(20) << "indexed, graph/s" << std::endl;
+        Compare(std::to_string(patterns), registry, queries);
+        Compare("built-in", GraphPatternRegistry::global(), queries);
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Matches random tree-shaped graphs against random patterns, trying each"
+                  << " pattern in turn and using the signature index, then does the same with"
+                  << " the patterns built into the library." << std::endl;
+    }
+
+private:
+    int patterns = 64;
+    int nodes    = 16;
+    int graphs   = 200;
+    int runs     = 20;
+
+    std::unique_ptr<PatternGraphGenerator> MakeGraph(int seed) const
+    {
+        static const auto names = std::vector<std::string>{"OP_MATMUL",
+                                                           "OP_POINTWISE:ADD",
+                                                           "OP_POINTWISE:MUL",
+                                                           "OP_POINTWISE:EXP",
+                                                           "OP_REDUCTION:MAX",
+                                                           "OP_RNG"};
+
+        // Each node consumes the output of one earlier node, and maybe a graph input.
+        // The graph is a tree, so the number of its paths stays linear in its size.
+        auto rng   = std::mt19937(seed);
+        auto specs = std::vector<PatternGraphGenerator::DummyNodeGenSpec>{};
+        for(auto i = 0; i < nodes; ++i)
+        {
+            auto ins = std::vector<std::string>{};
+            ins.push_back(i == 0 ? "in" : "t_" + std::to_string(rng() % i));
+            if(rng() % 2 == 0)
+                ins.push_back("in_" + std::to_string(i));
+            specs.push_back({names[rng() % names.size()], ins, {"t_" + std::to_string(i)}});
+        }
+        return PatternGraphGenerator::Make(specs);
+    }
+
+    void Compare(const std::string& title,
+                 const GraphPatternRegistry& registry,
+                 const std::vector<std::unique_ptr<PatternGraphGenerator>>& queries) const
+    {
+        auto linear_matches  = std::vector<const GraphPatternMatcher*>{};
+        auto indexed_matches = std::vector<const GraphPatternMatcher*>{};
+
+        const auto linear = Measure(queries, linear_matches, [&](const OpGraph& graph) {
+            for(const auto& pattern : registry.getPatterns())
+            {
+                if(pattern->matches(&graph))
+                    return static_cast<const GraphPatternMatcher*>(pattern.get());
+            }
+            return static_cast<const GraphPatternMatcher*>(nullptr);
+        });
+        const auto indexed = Measure(queries, indexed_matches, [&](const OpGraph& graph) {
+            return registry.findMatch(graph);
+        });
+
+        if(linear_matches != indexed_matches)
+        {
+            std::cerr << "Indexed matching differs from the linear one" << std::endl;
+            std::abort();
+        }
+
+        std::cout << std::setw(10) << title << std::setw(8) << nodes << std::setw(20) << linear
+                  << std::setw(20) << indexed << std::endl;
+    }
+
+    template <class F>
+    double Measure(const std::vector<std::unique_ptr<PatternGraphGenerator>>& queries,
+                   std::vector<const GraphPatternMatcher*>& matches,
+                   F&& find) const
+    {
+        matches.assign(queries.size(), nullptr);
+        const auto start = std::chrono::steady_clock::now();
+        for(auto run = 0; run < runs; ++run)
+        {
+            for(std::size_t i = 0; i < queries.size(); ++i)
+                matches[i] = find(queries[i]->graph());
+        }
+        const auto seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        return static_cast<double>(queries.size()) * runs / seconds;
+    }
+};
+
+} // namespace graph_pattern_match
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::graph_pattern_match::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <../driver/mloConvHost.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace host_gemm_speedtest {
+
+// ADNN_mm_cpu as it was before blocking: one dot product per element of C.
+template <typename Dtype>
+void naive_mm_cpu(const Dtype* a_ptr,
+                  size_t a_stride,
+                  bool a_trans,
+                  const Dtype* b_ptr,
+                  size_t b_stride,
+                  bool b_trans,
+                  Dtype* c_ptr,
+                  size_t c_stride,
+                  size_t c_rows,
+                  size_t c_cols,
+                  size_t inner_loop)
+{
+    for(size_t n = 0; n < c_rows; ++n)
+    {
+        for(size_t k = 0; k < c_cols; ++k)
+        {
+            Dtype mm_e = static_cast<Dtype>(0);
+            for(size_t m = 0; m < inner_loop; ++m)
+            {
+                mm_e += (a_trans ? a_ptr[m * a_stride + n] : a_ptr[n * a_stride + m]) *
+                        (b_trans ? b_ptr[k * b_stride + m] : b_ptr[m * b_stride + k]);
+            }
+            c_ptr[n * c_stride + k] = mm_e;
+        }
+    }
+}
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(m, "m");
+        add(n, "n");
+        add(k, "k");
+    }
+
+    void run()
+    {
+        std::cout << std::setw(8) << "a, b" << std::setw(16) << "naive, GFLOP/s" << std::setw(18)
+                  << "blocked, GFLOP/s" << std::setw(12) << "max diff" << std::endl;
+
+        for(auto a_trans : {false, true})
+            for(auto b_trans : {false, true})
+                Compare(a_trans, b_trans);
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Compares the naive host GEMM with the blocked ADNN_mm_cpu "
+                     "for every transposition of A and B."
+                  << std::endl;
+    }
+
+private:
+    int m = 512;
+    int n = 512;
+    int k = 512;
+
+    void Compare(bool a_trans, bool b_trans) const
+    {
+        const auto a_rows = static_cast<size_t>(a_trans ? k : m);
+        const auto a_cols = static_cast<size_t>(a_trans ? m : k);
+        const auto b_rows = static_cast<size_t>(b_trans ? n : k);
+        const auto b_cols = static_cast<size_t>(b_trans ? k : n);
+
+        auto gen  = std::mt19937{};
+        auto dist = std::uniform_real_distribution<double>{-1.0, 1.0};
+        auto a    = std::vector<double>(a_rows * a_cols);
+        auto b    = std::vector<double>(b_rows * b_cols);
+        for(auto& v : a)
+            v = dist(gen);
+        for(auto& v : b)
+            v = dist(gen);
+
+        auto naive_c   = std::vector<double>(static_cast<size_t>(m) * n);
+        auto blocked_c = std::vector<double>(static_cast<size_t>(m) * n);
+
+        const auto naive = Measure([&] {
+            naive_mm_cpu(
+                a.data(), a_cols, a_trans, b.data(), b_cols, b_trans, naive_c.data(), n, m, n, k);
+        });
+        const auto blocked = Measure([&] {
+            ADNN_mm_cpu(a.data(),
+                        a_cols,
+                        a_rows,
+                        a_cols,
+                        a_trans ? ADNN_MM_TRANSPOSE : 0,
+                        b.data(),
+                        b_cols,
+                        b_rows,
+                        b_cols,
+                        b_trans ? ADNN_MM_TRANSPOSE : 0,
+                        blocked_c.data(),
+                        n,
+                        m,
+                        n,
+                        0,
+                        1.0,
+                        0.0);
+        });
+
+        auto max_diff = 0.0;
+        for(size_t i = 0; i < naive_c.size(); ++i)
+            max_diff = std::max(max_diff, std::abs(naive_c[i] - blocked_c[i]));
+
+        const auto flop   = 2.0 * m * n * k;
+        const auto layout = std::string{a_trans ? "t" : "n"} + ", " + (b_trans ? "t" : "n");
+        std::cout << std::setw(8) << layout << std::setw(16) << flop / naive * 1e-9 << std::setw(18)
+                  << flop / blocked * 1e-9 << std::setw(12) << max_diff << std::endl;
+    }
+
+    template <class F>
+    static double Measure(F f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+} // namespace host_gemm_speedtest
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::host_gemm_speedtest::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/bz2.hpp>
+#include <miopen/kern_db.hpp>
+#include <miopen/zstd.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace kern_db_codec {
+
+using Blob = std::vector<char>;
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(db, "db");
+        add(max_records, "records");
+        add(dict_size, "dict-size");
+        add(level, "level");
+    }
+
+    void run()
+    {
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        auto kern_db = KernDb{DbKinds::KernelDb, db, true};
+        auto corpus  = std::vector<Blob>{};
+        auto total   = std::size_t{0};
+        for(auto& record : kern_db.LoadRecords(max_records))
+        {
+            total += record.kernel_blob.size();
+            corpus.push_back(std::move(record.kernel_blob));
+        }
+        if(corpus.empty())
+        {
+            std::cout << "No records in " << db << std::endl;
+            return;
+        }
+
+        std::cout << corpus.size() << " code object(s), " << total / (1024.0 * 1024.0) << " MiB"
+                  << std::endl;
+        std::cout << std::setw(12) << "codec" << std::setw(10) << "ratio" << std::setw(20)
+                  << "compress, MiB/s" << std::setw(20) << "decompress, MiB/s" << std::endl;
+
+        Compare("bz2",
+                corpus,
+                [](const Blob& b, bool* ok) { return compress(b, ok); },
+                [](const Blob& b, std::size_t size) { return decompress(b, size); });
+#if MIOPEN_USE_ZSTD
+        Compare("zstd",
+                corpus,
+                [&](const Blob& b, bool* ok) { return zstd_compress(b, level, nullptr, ok); },
+                [](const Blob& b, std::size_t size) { return zstd_decompress(b, size); });
+
+        // Trained on every other code object, so that half of them are new to the dictionary.
+        auto samples = std::vector<Blob>{};
+        for(std::size_t i = 0; i < corpus.size(); i += 2)
+            samples.push_back(corpus[i]);
+        const auto data = zstd_train_dictionary(samples, dict_size);
+        if(data.empty())
+        {
+            std::cout << std::setw(12) << "zstd+dict" << "  unable to train a dictionary"
+                      << std::endl;
+            return;
+        }
+        const auto dict = std::make_unique<ZstdDictionary>(data, level);
+        Compare("zstd+dict",
+                corpus,
+                [&](const Blob& b, bool* ok) { return zstd_compress(b, level, dict.get(), ok); },
+                [&](const Blob& b, std::size_t size) {
+                    return zstd_decompress(b, size, dict.get());
+                });
+#endif
+#else
+        std::cout << "MIOpen is built without the SQLite kernel cache." << std::endl;
+#endif
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Compresses up to records code objects of the kernel cache db with every"
+                  << " available codec and reports the compression ratio and the throughput"
+                  << " of compression and decompression." << std::endl;
+    }
+
+private:
+    std::string db;
+    int max_records = 1000;
+    int dict_size   = 112640;
+    int level       = 9;
+
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    static void Compare(const std::string& name,
+                        const std::vector<Blob>& corpus,
+                        const std::function<Blob(const Blob&, bool*)>& compress_fn,
+                        const std::function<Blob(const Blob&, std::size_t)>& decompress_fn)
+    {
+        // Incompressible code objects are stored as is, like KernDb does.
+        auto compressed = std::vector<Blob>{};
+        auto is_stored  = std::vector<bool>{};
+        auto raw_size   = std::size_t{0};
+        auto size       = std::size_t{0};
+
+        const auto compress_time = Measure([&]() {
+            for(const auto& blob : corpus)
+            {
+                auto ok = false;
+                compressed.push_back(compress_fn(blob, &ok));
+                is_stored.push_back(!ok);
+            }
+        });
+        const auto decompress_time = Measure([&]() {
+            for(std::size_t i = 0; i < corpus.size(); ++i)
+            {
+                if(!is_stored[i] && decompress_fn(compressed[i], corpus[i].size()) != corpus[i])
+                    MIOPEN_THROW(name + " round trip failed");
+            }
+        });
+
+        for(std::size_t i = 0; i < corpus.size(); ++i)
+        {
+            raw_size += corpus[i].size();
+            size += compressed[i].size();
+        }
+
+        const auto mib = raw_size / (1024.0 * 1024.0);
+        std::cout << std::setw(12) << name << std::setw(10) << std::setprecision(3)
+                  << static_cast<double>(raw_size) / size << std::setw(20) << mib / compress_time
+                  << std::setw(20) << mib / decompress_time << std::endl;
+    }
+#endif
+
+    template <class F>
+    static double Measure(F f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+} // namespace kern_db_codec
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::kern_db_codec::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/kern_db.hpp>
+#include <miopen/md5.hpp>
+#include <miopen/stringutils.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace kern_db_lookup {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(db, "db");
+        add(records, "records");
+        add(lookups, "lookups");
+    }
+
+    void run()
+    {
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        auto temp_file = std::unique_ptr<TempFile>{};
+        auto path      = fs::path{db};
+        if(db.empty())
+        {
+            temp_file = std::make_unique<TempFile>("kern-db-lookup");
+            path      = *temp_file;
+            Populate(path);
+        }
+
+        auto kern_db = KernDb{DbKinds::KernelDb, path, true};
+        auto keys    = std::vector<KernelConfig>{};
+        for(const auto& row : kern_db.sql.Exec("SELECT kernel_name, kernel_args FROM kern_db;"))
+            keys.push_back({row.at("kernel_name"), row.at("kernel_args"), {}});
+        if(keys.empty())
+        {
+            std::cout << "No records in " << path << std::endl;
+            return;
+        }
+
+        // Like the lookups of the kernels missing from the user cache.
+        auto misses = keys;
+        for(auto& key : misses)
+            key.kernel_args += " -DMISSING";
+
+        auto gen = std::mt19937{};
+        std::shuffle(keys.begin(), keys.end(), gen);
+        std::shuffle(misses.begin(), misses.end(), gen);
+
+        std::cout << keys.size() << " record(s)" << std::endl;
+        std::cout << std::setw(10) << "lookup" << std::setw(16) << "hits/s" << std::setw(16)
+                  << "misses/s" << std::endl;
+
+        // The SQL text of every lookup has the values in it, as FindRecord used to do.
+        Compare("adhoc", keys, misses, [&](const KernelConfig& key) {
+            auto stmt = SQLite::Statement{
+                kern_db.sql,
+                "SELECT kernel_blob, kernel_hash FROM kern_db WHERE (kernel_name = '" +
+                    ReplaceString(key.kernel_name.string(), "'", "''") +
+                    "') AND (kernel_args = '" + ReplaceString(key.kernel_args, "'", "''") +
+                    "');"};
+            if(stmt.Step(kern_db.sql) != SQLITE_ROW)
+                return false;
+            return md5(stmt.ColumnBlob(0)) == stmt.ColumnText(1);
+        });
+        Compare("prepared", keys, misses, [&](const KernelConfig& key) {
+            return kern_db.FindRecordUnsafe(key).has_value();
+        });
+
+        const auto index_time = Measure([&]() { kern_db.BuildIndex(); });
+        Compare("indexed", keys, misses, [&](const KernelConfig& key) {
+            return kern_db.FindRecordUnsafe(key).has_value();
+        });
+        std::cout << "Index built in " << index_time * 1000 << " ms" << std::endl;
+#else
+        std::cout << "MIOpen is built without the SQLite kernel cache." << std::endl;
+#endif
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Looks up every record of the kernel cache db, or of a generated one with"
+                  << " records records, and the same number of missing ones, and reports the"
+                  << " lookups per second with SQL text per lookup, with prepared statements,"
+                  << " and with the in-memory index." << std::endl;
+    }
+
+private:
+    std::string db;
+    int records = 10000;
+    int lookups = 100000;
+
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    void Populate(const fs::path& path) const
+    {
+        auto kern_db = KernDb{DbKinds::KernelDb, path, false, KernDbCodec::None};
+        auto gen     = std::mt19937{};
+        auto blob    = std::vector<char>(1024);
+        for(auto i = 0; i < records; ++i)
+        {
+            // Build options are long and mostly alike.
+            auto args = std::string{" -DMIOPEN_USE_FP32=1 -DMIOPEN_USE_FP16=0 -mcpu=gfx90a"};
+            for(auto j = 0; j < 24; ++j)
+                args += " -DMLO_PARAM_" + std::to_string(j) + "=" + std::to_string(gen() % 64);
+
+            std::generate(blob.begin(), blob.end(), [&]() { return static_cast<char>(gen()); });
+            kern_db.StoreRecordUnsafe(
+                KernelConfig{"kernel" + std::to_string(i % 100) + ".o", args, blob});
+        }
+    }
+
+    template <class F>
+    void Compare(const std::string& name,
+                 const std::vector<KernelConfig>& keys,
+                 const std::vector<KernelConfig>& misses,
+                 F lookup) const
+    {
+        const auto run = [&](const std::vector<KernelConfig>& set, bool expected) {
+            return Measure([&]() {
+                for(auto i = 0; i < lookups; ++i)
+                {
+                    if(lookup(set[i % set.size()]) != expected)
+                        MIOPEN_THROW(name + " lookup returned a wrong result");
+                }
+            });
+        };
+
+        const auto hits_time   = run(keys, true);
+        const auto misses_time = run(misses, false);
+        std::cout << std::setw(10) << name << std::setw(16) << std::setprecision(6)
+                  << lookups / hits_time << std::setw(16) << lookups / misses_time << std::endl;
+    }
+#endif
+
+    template <class F>
+    static double Measure(F f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+} // namespace kern_db_lookup
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::kern_db_lookup::SpeedTestDriver>(argc, argv);
+    return 0;
+}
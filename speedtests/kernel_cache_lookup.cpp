@@ -0,0 +1,95 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/kernel_cache.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace kernel_cache_lookup {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(configs, "configs");
+        add(lookups, "lookups");
+        add(max_threads, "threads");
+    }
+
+    void run()
+    {
+        // Network configs are long, so short string optimization does not hide allocations.
+        auto names = std::vector<std::string>{};
+        for(auto i = 0; i < configs; ++i)
+            names.push_back("64x" + std::to_string(i) + "x3x3x1x1x1x1x1x1x28x28x64xNCHWxFP32xF");
+
+        auto cache = KernelCache{};
+        for(const auto& name : names)
+            cache.AddKernel(algorithm, name, Kernel{}, 0);
+
+        std::cout << std::setw(8) << "threads" << std::setw(20) << "lookup/s" << std::endl;
+
+        // The same lookup as Handle::GetKernels does.
+        for(auto threads = 1; threads <= max_threads; threads *= 2)
+        {
+            const auto rate = Measure(threads, [&](int i) -> const std::vector<Kernel>& {
+                return cache.GetKernels(algorithm, names[i]);
+            });
+            std::cout << std::setw(8) << threads << std::setw(20) << rate << std::endl;
+        }
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Looks up kernels of random network configs from 1, 2, 4 ... threads threads"
+                  << " the way the handle does. Kernels are not built, so the test"
+                  << " is meant for the nogpu backend as well." << std::endl;
+    }
+
+private:
+    int configs     = 1000;
+    int lookups     = 1000000;
+    int max_threads = static_cast<int>(std::thread::hardware_concurrency());
+
+    const std::string algorithm = "miopenConvolutionFwdAlgoDirect";
+
+    template <class F>
+    double Measure(int threads, F&& lookup) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto workers     = std::vector<std::thread>{};
+        for(auto t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]() {
+                for(auto i = 0; i < lookups; ++i)
+                {
+                    if(lookup((i * 7919 + t) % configs).size() != 1)
+                        std::abort();
+                }
+            });
+        }
+        for(auto& worker : workers)
+            worker.join();
+        const auto seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        return static_cast<double>(lookups) * threads / seconds;
+    }
+};
+
+} // namespace kernel_cache_lookup
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::kernel_cache_lookup::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/graphapi/opgraph.hpp>
+#include <miopen/graphapi/util.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace opgraph_isomorphism {
+
+using graphapi::OpGraph;
+using graphapi::PatternGraphGenerator;
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(max_depth, "depth");
+        add(max_width, "width");
+        add(max_paths, "paths");
+    }
+
+    void run()
+    {
+        std::cout << std::setw(6) << "width" << std::setw(6) << "depth" << std::setw(8) << "nodes"
+                  << std::setw(16) << "paths" << std::setw(16) << "paths, ms" << std::setw(16)
+                  << "labels, ms" << std::endl;
+
+        for(auto width = 1; width <= max_width; width *= 2)
+        {
+            for(auto depth = 1; depth <= max_depth; depth *= 2)
+            {
+                const auto left  = MakeGraph(width, depth);
+                const auto right = MakeGraph(width, depth);
+                const auto paths = std::pow(static_cast<double>(width), depth);
+
+                std::cout << std::setw(6) << width << std::setw(6) << depth << std::setw(8)
+                          << left->graph().numNodes() << std::setw(16) << paths;
+
+                if(paths <= max_paths)
+                {
+                    std::cout << std::setw(16) << Measure([&]() {
+                        return SamePaths(left->graph(), right->graph());
+                    });
+                }
+                else
+                {
+                    std::cout << std::setw(16) << "-";
+                }
+
+                std::cout << std::setw(16) << Measure([&]() {
+                    return graphapi::isIsomorphic(left->graph(), right->graph());
+                }) << std::endl;
+            }
+        }
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Compares two equal graphs of depth stages, each fanning out into width"
+                  << " branches and joining them back, so that there are width^depth paths."
+                  << " The comparison of all paths the isomorphism check used to do is skipped"
+                  << " when there are more than paths of them." << std::endl;
+    }
+
+private:
+    int max_depth    = 64;
+    int max_width    = 4;
+    double max_paths = 1 << 20;
+
+    static std::unique_ptr<PatternGraphGenerator> MakeGraph(int width, int depth)
+    {
+        auto specs = std::vector<PatternGraphGenerator::DummyNodeGenSpec>{};
+        for(auto stage = 0; stage < depth; ++stage)
+        {
+            const auto prefix = "s" + std::to_string(stage) + "_";
+            auto branches     = std::vector<std::string>{};
+            auto joined       = std::vector<std::string>{};
+            for(auto branch = 0; branch < width; ++branch)
+            {
+                branches.push_back(prefix + "b" + std::to_string(branch));
+                joined.push_back(prefix + "j" + std::to_string(branch));
+                specs.push_back({"OP_POINTWISE:EXP", {branches.back()}, {joined.back()}});
+            }
+            specs.push_back({"OP_RESHAPE", {"t_" + std::to_string(stage)}, branches});
+            specs.push_back({"OP_POINTWISE:ADD", joined, {"t_" + std::to_string(stage + 1)}});
+        }
+        return PatternGraphGenerator::Make(specs);
+    }
+
+    /// The comparison isIsomorphic used to make after checking nodes and degrees.
+    static bool SamePaths(const OpGraph& left, const OpGraph& right)
+    {
+        const auto to_strings = [](const OpGraph& graph) {
+            auto strings = std::vector<std::string>{};
+            for(const auto& path : graph.getAllPaths())
+                strings.push_back(graphapi::pathToStr(path));
+            std::sort(strings.begin(), strings.end());
+            return strings;
+        };
+        return to_strings(left) == to_strings(right);
+    }
+
+    template <class F>
+    static double Measure(F&& compare)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        if(!compare())
+        {
+            std::cerr << "Equal graphs compared as different" << std::endl;
+            std::abort();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+};
+
+} // namespace opgraph_isomorphism
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::opgraph_isomorphism::SpeedTestDriver>(argc, argv);
+    return 0;
+}
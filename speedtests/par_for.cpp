@@ -0,0 +1,104 @@
+#include <miopen/par_for.hpp>
+
+#include <driver.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace par_for_speedtest {
+
+// par_for as it was before the thread pool: a new thread per block on every call.
+template <class F>
+void spawning_par_for(std::size_t n, F f)
+{
+    const auto threadsize = std::min<std::size_t>(std::thread::hardware_concurrency(), n / 8);
+    if(threadsize <= 1)
+    {
+        for(std::size_t i = 0; i < n; i++)
+            f(i);
+        return;
+    }
+
+    std::vector<joinable_thread> threads(threadsize);
+    const std::size_t grainsize = std::ceil(static_cast<double>(n) / threads.size());
+    std::size_t work            = 0;
+    std::generate(threads.begin(),
+                  threads.end(),
+                  std::bind(thread_factory{}, std::ref(work), n, grainsize, f));
+}
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(calls, "calls");
+        add(size, "size");
+    }
+
+    void run()
+    {
+        std::cout << std::setw(12) << "loop" << std::setw(14) << "spawning, ms" << std::setw(14)
+                  << "pool, ms" << std::endl;
+
+        // Many calls with little work each, like the per-element helpers of the tests.
+        Compare("short", 64, [](auto i) { return static_cast<double>(i); });
+        // Even work per iteration.
+        Compare("balanced", size, [](auto i) { return Work(i, 64); });
+        // Work grows with the index, like reductions over the channels of the last batch.
+        Compare("unbalanced", size, [this](auto i) { return Work(i, 256 * i / size); });
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Compares par_for on a new set of threads per call with the thread pool."
+                  << std::endl;
+    }
+
+private:
+    int calls = 1000;
+    int size  = 4096;
+
+    static double Work(std::size_t i, std::size_t iterations)
+    {
+        auto x = static_cast<double>(i);
+        for(std::size_t k = 0; k < iterations; ++k)
+            x = std::sqrt(x + static_cast<double>(k));
+        return x;
+    }
+
+    template <class F>
+    void Compare(const std::string& name, int n, F f) const
+    {
+        const auto spawning = Measure(n, [&](auto body) { spawning_par_for(n, body); }, f);
+        const auto pool     = Measure(n, [&](auto body) { par_for(n, body); }, f);
+        std::cout << std::setw(12) << name << std::setw(14) << spawning << std::setw(14) << pool
+                  << std::endl;
+    }
+
+    template <class Loop, class F>
+    double Measure(int n, Loop loop, F f) const
+    {
+        auto results     = std::vector<double>(n);
+        const auto start = std::chrono::steady_clock::now();
+        for(auto call = 0; call < calls; ++call)
+            loop([&](std::size_t i) { results[i] = f(i); });
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+};
+
+} // namespace par_for_speedtest
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::par_for_speedtest::SpeedTestDriver>(argc, argv);
+    return 0;
+}
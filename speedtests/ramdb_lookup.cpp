@@ -0,0 +1,107 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/ramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace ramdb_lookup {
+
+struct Values
+{
+    std::string str;
+    bool Deserialize(const std::string& s)
+    {
+        str = s;
+        return true;
+    }
+};
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(records, "records");
+        add(lookups, "lookups");
+        add(max_threads, "threads");
+    }
+
+    void run()
+    {
+        std::cout << std::setw(8) << "threads" << std::setw(20) << "exclusive, lookup/s"
+                  << std::setw(20) << "read-mostly, lookup/s" << std::endl;
+
+        for(auto threads = 1; threads <= max_threads; threads *= 2)
+        {
+            const auto exclusive   = Measure(RamDbMode::Exclusive, threads);
+            const auto read_mostly = Measure(RamDbMode::ReadMostly, threads);
+            std::cout << std::setw(8) << threads << std::setw(20) << exclusive << std::setw(20)
+                      << read_mostly << std::endl;
+        }
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Looks up random keys of a user perf-db from 1, 2, 4 ... threads threads"
+                  << " in both RamDb modes." << std::endl;
+    }
+
+private:
+    int records     = 10000;
+    int lookups     = 100000;
+    int max_threads = static_cast<int>(std::thread::hardware_concurrency());
+
+    static std::string Key(int i) { return "1x" + std::to_string(i) + "x3x3"; }
+
+    // Every measurement uses its own file, because RamDb instances are cached by path forever.
+    double Measure(RamDbMode mode, int threads) const
+    {
+        const auto file = TempFile{"ramdb-lookup"};
+        {
+            auto out = std::ofstream{file.Path()};
+            for(auto i = 0; i < records; ++i)
+                out << Key(i) << "=SolverA:1,2,3,4;SolverB:5,6,7,8" << std::endl;
+        }
+
+        auto& db = RamDb::GetCached(DbKinds::PerfDb, file.Path(), false, mode);
+
+        const auto start = std::chrono::steady_clock::now();
+        auto workers     = std::vector<std::thread>{};
+        for(auto t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]() {
+                auto value = Values{};
+                for(auto i = 0; i < lookups; ++i)
+                {
+                    const auto record = db.FindRecord(Key((i * 7919 + t) % records));
+                    if(!record || !record->GetValues("SolverA", value))
+                        std::abort();
+                }
+            });
+        }
+        for(auto& worker : workers)
+            worker.join();
+        const auto seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        return static_cast<double>(lookups) * threads / seconds;
+    }
+};
+
+} // namespace ramdb_lookup
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::ramdb_lookup::SpeedTestDriver>(argc, argv);
+    return 0;
+}
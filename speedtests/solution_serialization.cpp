@@ -0,0 +1,160 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/errors.hpp>
+#include <miopen/miopen.h>
+#include <miopen/solution.hpp>
+
+#include <driver.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace miopen {
+namespace solution_serialization {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(channels, "channels");
+    }
+
+    void run()
+    {
+        const auto solutions = FindSolutions();
+
+        auto json   = Totals{};
+        auto binary = Totals{};
+        for(auto i = 0; i < iterations; ++i)
+        {
+            for(const auto& solution : solutions)
+            {
+                Measure(json,
+                        [&]() { return nlohmann::json::to_msgpack(nlohmann::json(solution)); });
+                Measure(binary, [&]() { return solution.Save(); });
+            }
+        }
+
+        std::cout << solutions.size() << " solution(s) with embedded binaries, " << iterations
+                  << " iteration(s)" << std::endl;
+        std::cout << std::setw(8) << "format" << std::setw(14) << "bytes" << std::setw(14)
+                  << "save, ms" << std::setw(14) << "load, ms" << std::endl;
+        Print("json", json);
+        Print("binary", binary);
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Finds convolution solutions with attached binaries and measures their"
+                  << " serialization as msgpack encoded json and in the binary format."
+                  << std::endl;
+    }
+
+private:
+    int iterations = 100;
+    int channels   = 64;
+
+    struct Totals
+    {
+        std::size_t bytes = 0;
+        double save       = 0;
+        double load       = 0;
+    };
+
+    template <class F>
+    static void Measure(Totals& totals, F&& save)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const auto data  = save();
+        const auto saved = std::chrono::steady_clock::now();
+        Solution::Load(reinterpret_cast<const char*>(data.data()), data.size());
+        const auto loaded = std::chrono::steady_clock::now();
+
+        totals.bytes += data.size();
+        totals.save += std::chrono::duration<double, std::milli>(saved - start).count();
+        totals.load += std::chrono::duration<double, std::milli>(loaded - saved).count();
+    }
+
+    void Print(const char* format, const Totals& totals) const
+    {
+        std::cout << std::setw(8) << format << std::setw(14) << totals.bytes / iterations
+                  << std::setw(14) << totals.save / iterations << std::setw(14)
+                  << totals.load / iterations << std::endl;
+    }
+
+    static void Check(miopenStatus_t status)
+    {
+        if(status != miopenStatusSuccess)
+        {
+            std::cerr << "MIOpen call has failed: " << miopenGetErrorString(status) << std::endl;
+            std::abort();
+        }
+    }
+
+    static miopenTensorDescriptor_t MakeTensor(int n, int c, int h, int w)
+    {
+        auto desc = miopenTensorDescriptor_t{};
+        Check(miopenCreateTensorDescriptor(&desc));
+        Check(miopenSet4dTensorDescriptor(desc, miopenFloat, n, c, h, w));
+        return desc;
+    }
+
+    std::vector<Solution> FindSolutions() const
+    {
+        auto handle = miopenHandle_t{};
+        Check(miopenCreate(&handle));
+
+        auto conv = miopenConvolutionDescriptor_t{};
+        Check(miopenCreateConvolutionDescriptor(&conv));
+        Check(miopenInitConvolutionDescriptor(conv, miopenConvolution, 1, 1, 1, 1, 1, 1));
+
+        const auto x = MakeTensor(16, channels, 28, 28);
+        const auto w = MakeTensor(channels, channels, 3, 3);
+        const auto y = MakeTensor(16, channels, 28, 28);
+
+        auto problem = miopenProblem_t{};
+        Check(miopenCreateConvProblem(&problem, conv, miopenProblemDirectionForward));
+        Check(miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionX, x));
+        Check(miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionW, w));
+        Check(miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionY, y));
+
+        auto options = miopenFindOptions_t{};
+        Check(miopenCreateFindOptions(&options));
+        Check(miopenSetFindOptionAttachBinaries(options, 1));
+
+        auto found   = std::vector<miopenSolution_t>(16);
+        auto n_found = std::size_t{0};
+        Check(miopenFindSolutions(handle, problem, options, found.data(), &n_found, found.size()));
+
+        auto solutions = std::vector<Solution>{};
+        for(auto i = 0u; i < n_found; ++i)
+        {
+            solutions.push_back(deref(found[i]));
+            Check(miopenDestroySolution(found[i]));
+        }
+
+        Check(miopenDestroyFindOptions(options));
+        Check(miopenDestroyProblem(problem));
+        Check(miopenDestroyTensorDescriptor(x));
+        Check(miopenDestroyTensorDescriptor(w));
+        Check(miopenDestroyTensorDescriptor(y));
+        Check(miopenDestroyConvolutionDescriptor(conv));
+        Check(miopenDestroy(handle));
+        return solutions;
+    }
+};
+
+} // namespace solution_serialization
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::solution_serialization::SpeedTestDriver>(argc, argv);
+    return 0;
+}
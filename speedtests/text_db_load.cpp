@@ -0,0 +1,114 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/ramdb.hpp>
+#include <miopen/temp_file.hpp>
+#include <miopen/text_db_parser.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace miopen {
+namespace text_db_load {
+
+struct Item
+{
+    int line;
+    std::string content;
+};
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver() { add(max_records, "records"); }
+
+    void run()
+    {
+        std::cout << std::setw(10) << "records" << std::setw(10) << "MiB" << std::setw(16)
+                  << "getline, ms" << std::setw(16) << "chunked, ms" << std::setw(16)
+                  << "RamDb, ms" << std::endl;
+
+        for(auto records = 1000; records <= max_records; records *= 4)
+        {
+            const auto file = TempFile{"text-db-load"};
+            {
+                auto out = std::ofstream{file.Path()};
+                for(auto i = 0; i < records; ++i)
+                {
+                    out << "64-" << i << "-28-28-3x3-64-28-28-16-1x1-1x1-1x1-0-NCHW-FP32-F="
+                        << "ConvHipImplicitGemmV4R1Fwd:64,128,32,16,8,4,2,1;"
+                        << "ConvAsm1x1U:1,16,1,64,2,1,1,2;ConvOclDirectFwd1x1:1,64,1,1,0,1,1,1"
+                        << std::endl;
+                }
+            }
+
+            const auto size       = fs::file_size(file.Path()) / (1024.0 * 1024.0);
+            const auto sequential = Measure([&]() { return LoadSequentially(file.Path()); });
+            const auto chunked    = Measure([&]() {
+                auto in = std::ifstream{file.Path()};
+                return ParseTextDb<std::map<std::string, Item>>(ReadTextDb(in), [](int) {});
+            });
+            // RamDb instances are cached by path forever, so it is measured once per file.
+            const auto ramdb = Measure([&]() {
+                RamDb::GetCached(DbKinds::PerfDb, file.Path(), false);
+                return std::map<std::string, Item>{};
+            });
+
+            std::cout << std::setw(10) << records << std::setw(10) << std::setprecision(3)
+                      << size << std::setw(16) << sequential << std::setw(16) << chunked
+                      << std::setw(16) << ramdb << std::endl;
+        }
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Loads perf-db text files of 1000, 4000 ... records records line by line,"
+                  << " with the chunked parallel parser and through RamDb." << std::endl;
+    }
+
+private:
+    int max_records = 1024000;
+
+    /// The way text dbs were loaded before the chunked parser.
+    static std::map<std::string, Item> LoadSequentially(const fs::path& path)
+    {
+        auto items  = std::map<std::string, Item>{};
+        auto file   = std::ifstream{path};
+        auto line   = std::string{};
+        auto n_line = 0;
+
+        while(std::getline(file, line))
+        {
+            ++n_line;
+            const auto key_size = line.find('=');
+            if(key_size == std::string::npos || key_size == 0)
+                continue;
+            items.emplace(line.substr(0, key_size), Item{n_line, line.substr(key_size + 1)});
+        }
+
+        return items;
+    }
+
+    template <class F>
+    static double Measure(F&& load)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const auto items = load();
+        const auto end   = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+};
+
+} // namespace text_db_load
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::text_db_load::SpeedTestDriver>(argc, argv);
+    return 0;
+}
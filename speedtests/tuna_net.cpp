@@ -0,0 +1,98 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/conv/heuristics/ai_heuristics.hpp>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/handle.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace miopen {
+namespace tuna_net {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver() { add(problems, "problems"); }
+
+    void run()
+    {
+#if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
+        auto handle       = Handle{};
+        auto ctx          = ExecutionContext{&handle};
+        const auto device = handle.GetDeviceName();
+
+        const auto load =
+            Measure([&]() { ai::immed_mode::PredictSolver(MakeProblem(0), ctx, device); });
+        std::cout << "Model load and first prediction: " << load << " s" << std::endl;
+
+        // Every mode gets its own problems, so the cache of recent predictions does not interfere.
+        auto single  = std::vector<conv::ProblemDescription>{};
+        auto batched = std::vector<conv::ProblemDescription>{};
+        for(auto i = 0; i < problems; ++i)
+        {
+            single.push_back(MakeProblem(2 * i + 1));
+            batched.push_back(MakeProblem(2 * i + 2));
+        }
+
+        const auto one_by_one = Measure([&]() {
+            for(const auto& problem : single)
+                ai::immed_mode::PredictSolver(problem, ctx, device);
+        });
+        const auto batch =
+            Measure([&]() { ai::immed_mode::PredictSolvers(batched, ctx, device); });
+        const auto cached =
+            Measure([&]() { ai::immed_mode::PredictSolvers(batched, ctx, device); });
+
+        std::cout << std::setw(12) << "mode" << std::setw(16) << "problems/s" << std::endl;
+        std::cout << std::setw(12) << "one by one" << std::setw(16) << problems / one_by_one
+                  << std::endl;
+        std::cout << std::setw(12) << "batched" << std::setw(16) << problems / batch << std::endl;
+        std::cout << std::setw(12) << "cached" << std::setw(16) << problems / cached << std::endl;
+#else
+        std::cout << "TunaNet is disabled in this build." << std::endl;
+#endif
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Measures host time of TunaNet solver predictions for distinct problems made"
+                  << " one by one, in a batch, and from the cache of recent predictions."
+                  << std::endl;
+    }
+
+private:
+    int problems = 512;
+
+    template <class F>
+    static double Measure(F&& f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /// Problems differ in batch size, which is one of the TunaNet features.
+    static conv::ProblemDescription MakeProblem(int i)
+    {
+        const auto x    = TensorDescriptor{miopenFloat, {std::size_t(i + 1), 64, 56, 56}};
+        const auto w    = TensorDescriptor{miopenFloat, {128, 64, 3, 3}};
+        const auto conv = ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+        const auto y    = conv.GetForwardOutputTensor(x, w);
+        return {x, w, y, conv, conv::Direction::Forward};
+    }
+};
+
+} // namespace tuna_net
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::tuna_net::SpeedTestDriver>(argc, argv);
+    return 0;
+}
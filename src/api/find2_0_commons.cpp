@@ -36,7 +36,6 @@
 #include <miopen/solver_id.hpp>
 #include <miopen/type_name.hpp>
 
-#include <nlohmann/json.hpp>
 #include <boost/hof/match.hpp>
 
 template <class OperationDescriptor>
@@ -269,6 +268,17 @@ miopenStatus_t miopenSetFindOptionAttachBinaries(miopenFindOptions_t options, un
     });
 }
 
+miopenStatus_t miopenSetFindOptionTimingPolicy(miopenFindOptions_t options,
+                                               miopenFindTimingPolicy_t value)
+{
+    MIOPEN_LOG_FUNCTION(options, value);
+
+    return miopen::try_([&] {
+        auto& options_deref         = miopen::deref(options);
+        options_deref.timing_policy = value;
+    });
+}
+
 miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
                                    miopenProblem_t problem,
                                    miopenFindOptions_t options,
@@ -304,6 +314,72 @@ miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
     });
 }
 
+miopenStatus_t miopenFindSolutionsBatch(miopenHandle_t handle,
+                                        const miopenProblem_t* problems,
+                                        size_t numProblems,
+                                        miopenFindOptions_t options,
+                                        miopenSolution_t* solutions,
+                                        size_t* numSolutions,
+                                        size_t maxSolutions)
+{
+    MIOPEN_LOG_FUNCTION(
+        handle, problems, numProblems, options, solutions, numSolutions, maxSolutions);
+
+    return miopen::try_([&] {
+        auto& handle_deref = miopen::deref(handle);
+
+        if(numProblems > 0 && problems == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Problems parameter should not be a nullptr.");
+        if(numProblems > 0 && solutions == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Solutions parameter should not be a nullptr.");
+
+        const auto& options_deref =
+            options == nullptr ? miopen::FindOptions{} : miopen::deref(options);
+
+        auto solutions_deref = std::vector<std::vector<miopen::Solution>>(numProblems);
+        auto batched         = std::vector<const miopen::Problem*>{};
+        auto batched_ids     = std::vector<std::size_t>{};
+
+        for(std::size_t i = 0; i < numProblems; ++i)
+        {
+            const auto& problem_deref = miopen::deref(problems[i]).item;
+
+            std::visit([](auto&& problem) { problem.LogDriverCommand(); }, problem_deref);
+
+            if(const auto* problem = std::get_if<miopen::Problem>(&problem_deref))
+            {
+                batched.push_back(problem);
+                batched_ids.push_back(i);
+                continue;
+            }
+
+            solutions_deref[i] = std::visit(
+                [&](auto&& problem) {
+                    return problem.FindSolutions(handle_deref, options_deref, maxSolutions);
+                },
+                problem_deref);
+        }
+
+        auto found =
+            miopen::Problem::FindSolutions(handle_deref, batched, options_deref, maxSolutions);
+
+        for(std::size_t i = 0; i < batched.size(); ++i)
+            solutions_deref[batched_ids[i]] = std::move(found[i]);
+
+        for(std::size_t i = 0; i < numProblems; ++i)
+        {
+            for(std::size_t j = 0; j < solutions_deref[i].size(); ++j)
+            {
+                auto& theSolution = miopen::deref(solutions + i * maxSolutions + j);
+                theSolution       = new miopen::Solution{std::move(solutions_deref[i][j])};
+            }
+
+            if(numSolutions != nullptr)
+                numSolutions[i] = solutions_deref[i].size();
+        }
+    });
+}
+
 inline std::ostream& operator<<(std::ostream& stream, const miopenTensorArgument_t& tensor)
 {
     switch(tensor.id)
@@ -436,9 +512,8 @@ miopenStatus_t miopenLoadSolution(miopenSolution_t* solution, const char* data,
         if(data == nullptr)
             MIOPEN_THROW(miopenStatusBadParm, "Data parameter should not be a nullptr.");
 
-        auto json                = nlohmann::json::from_msgpack(data, data + size);
         auto& solution_ptr_deref = miopen::deref(solution);
-        solution_ptr_deref       = new miopen::Solution{json.get<miopen::Solution>()};
+        solution_ptr_deref       = new miopen::Solution{miopen::Solution::Load(data, size)};
     });
 }
 
@@ -453,10 +528,7 @@ miopenStatus_t miopenSaveSolution(miopenSolution_t solution, char* data)
         auto& solution_deref = miopen::deref(solution);
 
         if(solution_deref.serialization_cache.empty())
-        {
-            const nlohmann::json json          = solution_deref;
-            solution_deref.serialization_cache = nlohmann::json::to_msgpack(json);
-        }
+            solution_deref.serialization_cache = solution_deref.Save();
 
         std::memcpy(data,
                     solution_deref.serialization_cache.data(),
@@ -477,10 +549,7 @@ miopenStatus_t miopenGetSolutionSize(miopenSolution_t solution, size_t* size)
         auto& solution_deref = miopen::deref(solution);
 
         if(solution_deref.serialization_cache.empty())
-        {
-            const nlohmann::json json          = solution_deref;
-            solution_deref.serialization_cache = nlohmann::json::to_msgpack(json);
-        }
+            solution_deref.serialization_cache = solution_deref.Save();
 
         *size = solution_deref.serialization_cache.size();
     });
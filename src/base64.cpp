@@ -0,0 +1,110 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/base64.hpp>
+#include <miopen/errors.hpp>
+
+#include <array>
+
+namespace miopen {
+
+namespace {
+
+constexpr std::string_view Base64Alphabet =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+} // namespace
+
+std::string EncodeBase64(const std::vector<std::uint8_t>& data)
+{
+    std::string encoded;
+    encoded.reserve((data.size() + 2) / 3 * 4);
+
+    for(std::size_t i = 0; i < data.size(); i += 3)
+    {
+        const auto left  = data.size() - i;
+        const auto chunk = (std::uint32_t{data[i]} << 16) |
+                           (left > 1 ? std::uint32_t{data[i + 1]} << 8 : 0) |
+                           (left > 2 ? std::uint32_t{data[i + 2]} : 0);
+
+        encoded += Base64Alphabet[(chunk >> 18) & 0x3F];
+        encoded += Base64Alphabet[(chunk >> 12) & 0x3F];
+        encoded += left > 1 ? Base64Alphabet[(chunk >> 6) & 0x3F] : '=';
+        encoded += left > 2 ? Base64Alphabet[chunk & 0x3F] : '=';
+    }
+
+    return encoded;
+}
+
+std::vector<std::uint8_t> DecodeBase64(std::string_view encoded)
+{
+    static const auto values = [] {
+        std::array<int, 256> tmp{};
+        tmp.fill(-1);
+        for(std::size_t i = 0; i < Base64Alphabet.size(); ++i)
+            tmp[static_cast<unsigned char>(Base64Alphabet[i])] = static_cast<int>(i);
+        return tmp;
+    }();
+
+    if(encoded.size() % 4 != 0)
+        MIOPEN_THROW(miopenStatusBadParm, "Invalid base64 string length");
+
+    std::vector<std::uint8_t> data;
+    data.reserve(encoded.size() / 4 * 3);
+
+    for(std::size_t i = 0; i < encoded.size(); i += 4)
+    {
+        std::uint32_t chunk = 0;
+        auto padding        = 0;
+
+        for(std::size_t j = 0; j < 4; ++j)
+        {
+            const auto c = encoded[i + j];
+            // Padding is only allowed in the last two positions of the last quad
+            if(c == '=' && i + 4 == encoded.size() && j >= 2)
+            {
+                ++padding;
+                chunk <<= 6;
+                continue;
+            }
+
+            const auto value = values[static_cast<unsigned char>(c)];
+            if(value < 0 || padding > 0)
+                MIOPEN_THROW(miopenStatusBadParm, "Invalid base64 string");
+            chunk = (chunk << 6) | static_cast<std::uint32_t>(value);
+        }
+
+        data.push_back(static_cast<std::uint8_t>(chunk >> 16));
+        if(padding < 2)
+            data.push_back(static_cast<std::uint8_t>(chunk >> 8));
+        if(padding < 1)
+            data.push_back(static_cast<std::uint8_t>(chunk));
+    }
+
+    return data;
+}
+
+} // namespace miopen
@@ -37,15 +37,29 @@
 #include <miopen/sqlite_db.hpp>
 #endif
 #include <miopen/kern_db.hpp>
+#include <miopen/kern_pack.hpp>
+#include <miopen/mapped_file.hpp>
 #include <miopen/db.hpp>
 #include <miopen/db_path.hpp>
 #include <miopen/target_properties.hpp>
 #include <miopen/filesystem.hpp>
+#include <miopen/trace.hpp>
+#include <boost/optional.hpp>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DISABLE_CACHE)
 MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_CUSTOM_CACHE_DIR)
+/// Keeps the keys of the system kernel cache in memory, see KernDb::BuildIndex(). On by default.
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_KERN_DB_INDEX)
+/// Makes MIOpen use the system kernel cache even if there is a kernel pack made of it.
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_DISABLE_KERN_PACK)
 
 namespace miopen {
 
@@ -124,22 +138,191 @@ bool IsCacheDisabled()
 }
 
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
-using KDb = DbTimer<MultiFileDb<KernDb, KernDb, false>>;
-KDb GetDb(const TargetProperties& target, size_t num_cu)
+using KDb = DbTimer<KernDb>;
+
+/// The kernel caches are opened once per file and kept open until the process exits,
+/// so their prepared statements, indices and the pending write batch outlive a single call.
+/// The records are decompressed and checked without holding any lock.
+class CachedKDb
 {
-    static const auto user_dir = ComputeUserCachePath();
-    static const auto sys_dir  = ComputeSysCachePath();
-    fs::path user_path         = user_dir / (Handle::GetDbBasename(target, num_cu) + ".ukdb");
-    fs::path sys_path          = sys_dir / (Handle::GetDbBasename(target, num_cu) + ".kdb");
-    if(user_dir.empty())
-        user_path = user_dir;
+public:
+    CachedKDb(const fs::path& path_, bool is_system_)
+        : path(path_), is_system(is_system_), db(DbKinds::KernelDb, path, is_system)
+    {
+        // Other processes may write to the user database, which the index would miss.
+        if(is_system && !env::disabled(MIOPEN_DEBUG_KERN_DB_INDEX))
+            db.BuildIndex();
+    }
+
+    boost::optional<std::vector<char>> Find(const KernelConfig& cfg)
+    {
+        if(is_system)
+        {
+            // The system database is read only, so each thread looking up a kernel gets its
+            // own connection. They share the index.
+            auto connection = Acquire();
+            auto found      = boost::optional<std::vector<char>>{};
+            if(auto record = connection->FetchRecord(cfg))
+                found = connection->DecodeRecord(std::move(*record));
+            Release(std::move(connection));
+            return found;
+        }
+
+        auto record = [&]() {
+            const std::lock_guard<std::mutex> lock{mutex};
+            return db.FetchRecord(cfg);
+        }();
+        if(!record)
+            return boost::none;
+        return db.DecodeRecord(std::move(*record));
+    }
+
+    void Store(const KernelConfig& cfg)
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        db.StoreRecord(cfg);
+    }
+
+private:
+    fs::path path;
+    bool is_system;
+    std::mutex mutex;
+    /// The connection of the user database, or the one the index is built with.
+    KDb db;
+    /// Connections to the system database not used at the moment.
+    std::vector<std::unique_ptr<KDb>> idle;
+
+    std::unique_ptr<KDb> Acquire()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            if(!idle.empty())
+            {
+                auto connection = std::move(idle.back());
+                idle.pop_back();
+                return connection;
+            }
+        }
+        auto connection = std::make_unique<KDb>(DbKinds::KernelDb, path, true);
+        connection->ShareIndex(db);
+        return connection;
+    }
+
+    void Release(std::unique_ptr<KDb> connection)
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        idle.push_back(std::move(connection));
+    }
+};
+
+CachedKDb& GetCachedDb(const fs::path& path, bool is_system)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto instances = std::map<std::pair<fs::path, bool>, std::unique_ptr<CachedKDb>>{};
+
+    const std::lock_guard<std::mutex> lock{mutex};
+    auto& instance = instances[{path, is_system}];
+    if(!instance)
+        instance = std::make_unique<CachedKDb>(path, is_system);
+    return *instance;
+}
+
+CachedKDb& GetSysDb(const TargetProperties& target, size_t num_cu)
+{
+    static const auto sys_dir = ComputeSysCachePath();
+    fs::path sys_path         = sys_dir / (Handle::GetDbBasename(target, num_cu) + ".kdb");
     if(!fs::exists(sys_path))
         sys_path = sys_dir / (target.DbId() + ".kdb");
 #if !MIOPEN_EMBED_DB
     if(!fs::exists(sys_path))
         sys_path = fs::path{};
 #endif
-    return {DbKinds::KernelDb, sys_path, user_path};
+    return GetCachedDb(sys_path, true);
+}
+
+/// Kernel pack made of the system kernel cache by kdb2kpack, see kern_pack.hpp.
+struct KernPack
+{
+    MappedFile file;
+    kpack::PackView view;
+};
+
+std::unique_ptr<KernPack> MapPack(const fs::path& pack_path, const fs::path& kdb_path)
+{
+    try
+    {
+        auto pack       = std::make_unique<KernPack>();
+        pack->file      = MappedFile{pack_path};
+        const auto view = kpack::PackView{pack->file.Data(), pack->file.Size()};
+
+        if(!view.IsValid())
+        {
+            MIOPEN_LOG_W("Ill-formed kernel pack, falling back to the kernel cache: "
+                         << pack_path);
+            return nullptr;
+        }
+
+        // The kernel cache may be updated without making the pack again.
+        auto source = kpack::SourceStamp{};
+        if(kpack::GetSourceStamp(kdb_path.string(), source) && source != view.GetSource())
+        {
+            MIOPEN_LOG_W("Kernel pack does not match the kernel cache, ignored: " << pack_path);
+            return nullptr;
+        }
+
+        pack->view = view;
+        MIOPEN_LOG_I2("Mapped kernel pack: " << pack_path << ", kernels: " << view.Count());
+        return pack;
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to map kernel pack, falling back to the kernel cache: " << ex.what());
+        return nullptr;
+    }
+}
+
+/// Returns nullptr if there is no usable pack, then the system kernel cache is used.
+const KernPack* GetSysPack(const TargetProperties& target, size_t num_cu)
+{
+#if MIOPEN_EMBED_DB
+    std::ignore = target;
+    std::ignore = num_cu;
+    return nullptr;
+#else
+    static const auto sys_dir = ComputeSysCachePath();
+    if(sys_dir.empty() || env::enabled(MIOPEN_DEBUG_DISABLE_KERN_PACK))
+        return nullptr;
+
+    // The same file name as the one of the system kernel cache, see GetSysDb().
+    auto stem = Handle::GetDbBasename(target, num_cu);
+    if(!fs::exists(sys_dir / (stem + ".kdb")) && !fs::exists(sys_dir / (stem + kpack::Extension)))
+        stem = target.DbId();
+    const auto pack_path = sys_dir / (stem + kpack::Extension);
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto instances = std::map<fs::path, std::unique_ptr<KernPack>>{};
+
+    const std::lock_guard<std::mutex> lock{mutex};
+    const auto it = instances.find(pack_path);
+    if(it != instances.end())
+        return it->second.get();
+
+    auto pack = fs::exists(pack_path) ? MapPack(pack_path, sys_dir / (stem + ".kdb")) : nullptr;
+    return instances.emplace(pack_path, std::move(pack)).first->second.get();
+#endif
+}
+
+CachedKDb& GetUserDb(const TargetProperties& target, size_t num_cu)
+{
+    static const auto user_dir = ComputeUserCachePath();
+    fs::path user_path         = user_dir / (Handle::GetDbBasename(target, num_cu) + ".ukdb");
+    if(user_dir.empty() || MIOPEN_DISABLE_USERDB)
+        user_path = fs::path{};
+    return GetCachedDb(user_path, false);
 }
 #endif
 
@@ -150,25 +333,46 @@ fs::path GetCacheFile(const std::string& device, const fs::path& name, const std
 }
 
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
-std::vector<char> LoadBinary(const TargetProperties& target,
-                             const size_t num_cu,
-                             const fs::path& name,
-                             const std::string& args)
+std::string_view LoadBinaryView(const TargetProperties& target,
+                                const size_t num_cu,
+                                const fs::path& name,
+                                const std::string& args,
+                                std::vector<char>& buffer)
 {
+    buffer.clear();
     if(miopen::IsCacheDisabled())
         return {};
 
-    auto db = GetDb(target, num_cu);
+    MIOPEN_TRACE_SCOPE("compile", [&]() { return "LoadBinary " + name.string(); });
 
     const auto filename = make_object_file_name(name);
     const KernelConfig cfg{filename, args, {}};
 
     MIOPEN_LOG_I2("Loading binary for: " << filename << "; args: " << args);
-    auto record = db.FindRecord(cfg);
+    auto record = GetUserDb(target, num_cu).Find(cfg);
+    if(!record)
+    {
+        // The pack replaces the system kernel cache it is made of.
+        if(const auto* pack = GetSysPack(target, num_cu))
+        {
+            auto item = kpack::Item{};
+            if(pack->view.Find(filename.string(), args, item))
+            {
+                MIOPEN_LOG_I2("Successfully loaded binary from the kernel pack for: "
+                              << filename << "; args: " << args);
+                return item.blob;
+            }
+        }
+        else
+        {
+            record = GetSysDb(target, num_cu).Find(cfg);
+        }
+    }
     if(record)
     {
         MIOPEN_LOG_I2("Successfully loaded binary for: " << filename << "; args: " << args);
-        return *record;
+        buffer = std::move(*record);
+        return {buffer.data(), buffer.size()};
     }
     else
     {
@@ -177,6 +381,18 @@ std::vector<char> LoadBinary(const TargetProperties& target,
     }
 }
 
+std::vector<char> LoadBinary(const TargetProperties& target,
+                             const size_t num_cu,
+                             const fs::path& name,
+                             const std::string& args)
+{
+    auto buffer       = std::vector<char>{};
+    const auto binary = LoadBinaryView(target, num_cu, name, args, buffer);
+    if(binary.data() == buffer.data())
+        return buffer;
+    return {binary.begin(), binary.end()};
+}
+
 void SaveBinary(const std::vector<char>& hsaco,
                 const TargetProperties& target,
                 const std::size_t num_cu,
@@ -186,13 +402,13 @@ void SaveBinary(const std::vector<char>& hsaco,
     if(miopen::IsCacheDisabled())
         return;
 
-    auto db = GetDb(target, num_cu);
+    MIOPEN_TRACE_SCOPE("compile", [&]() { return "SaveBinary " + name.string(); });
 
     const auto filename = make_object_file_name(name);
     KernelConfig cfg{filename, args, hsaco};
 
     MIOPEN_LOG_I2("Saving binary for: " << filename << "; args: " << args);
-    db.StoreRecord(cfg);
+    GetUserDb(target, num_cu).Store(cfg);
 }
 #else
 fs::path LoadBinary(const TargetProperties& target,
@@ -203,6 +419,8 @@ fs::path LoadBinary(const TargetProperties& target,
     if(miopen::IsCacheDisabled())
         return {};
 
+    MIOPEN_TRACE_SCOPE("compile", [&]() { return "LoadBinary " + name.string(); });
+
     (void)num_cu;
     auto f = GetCacheFile(target.DbId(), name, args);
     if(fs::exists(f))
@@ -27,7 +27,18 @@
 #include <miopen/conv/heuristics/ai_heuristics.hpp>
 #if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK || MIOPEN_ENABLE_AI_KERNEL_TUNING
 #include <fdeep/fdeep.hpp>
+#include <miopen/env.hpp>
 #include <miopen/filesystem.hpp>
+#include <miopen/par_for.hpp>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_DEBUG_AI_HEURISTICS_CACHE_SIZE, 4096)
 
 namespace miopen {
 namespace ai {
@@ -59,6 +70,55 @@ std::vector<V> LookupValues(const std::vector<U>& keys, const std::unordered_map
     });
     return values;
 }
+
+/// Thread-safe map of a limited size. The least recently used item is evicted on overflow.
+template <class TKey, class TValue>
+class LruCache
+{
+public:
+    explicit LruCache(std::size_t capacity_) : capacity(capacity_) {}
+
+    std::optional<TValue> Get(const TKey& key)
+    {
+        const auto lock = std::lock_guard<std::mutex>{mutex};
+        const auto it   = index.find(key);
+        if(it == index.end())
+            return std::nullopt;
+        items.splice(items.begin(), items, it->second);
+        return it->second->second;
+    }
+
+    void Put(const TKey& key, const TValue& value)
+    {
+        if(capacity == 0)
+            return;
+
+        const auto lock = std::lock_guard<std::mutex>{mutex};
+        const auto it   = index.find(key);
+        if(it != index.end())
+        {
+            it->second->second = value;
+            items.splice(items.begin(), items, it->second);
+            return;
+        }
+
+        items.emplace_front(key, value);
+        index.emplace(key, items.begin());
+        if(items.size() > capacity)
+        {
+            index.erase(items.back().first);
+            items.pop_back();
+        }
+    }
+
+private:
+    using Items = std::list<std::pair<TKey, TValue>>;
+
+    std::mutex mutex;
+    std::size_t capacity;
+    Items items; // most recently used first
+    std::map<TKey, typename Items::iterator> index;
+};
 } // namespace common
 
 #if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
@@ -124,8 +184,11 @@ class Model
 {
 public:
     Metadata metadata;
+    /// Recent predictions (solver ids, the best first) by the feature vector of the problem.
+    mutable common::LruCache<std::vector<float>, std::vector<uint64_t>> predictions;
     Model(const std::string& arch)
         : metadata(Metadata(arch)),
+          predictions(env::value(MIOPEN_DEBUG_AI_HEURISTICS_CACHE_SIZE)),
           model(fdeep::load_model(ModelPath(arch), true, fdeep::dev_null_logger)),
           input_shape(fdeep::tensor_shape(metadata.num_inputs)),
           offset(metadata.num_outputs - metadata.num_solvers)
@@ -145,24 +208,37 @@ public:
      */
     virtual bool IsProblemSupported(const conv::ProblemDescription& problem,
                                     const ExecutionContext& ctx) const = 0;
-    /** Forward (i.e., run inference on) problem through TunaNet
+    /** Forward (i.e., run inference on) problems through TunaNet
      *
-     * This function takes in a problem, converts it to a numeric vector and feeds it TunaNet
-     * for inference. Its output is a numeric vector that represents a probability distribution.
-     * Each index in this vector represents a solver (as given in metadata.solver_map) and the
-     * value at each index represents the probability that that solver is the fastest for given
-     * convolution problem.
+     * This function takes in numeric vectors representing problems (see `ToFeatures`) and
+     * feeds them to TunaNet for inference. For each problem, its output is a numeric vector that
+     * represents a probability distribution. Each index in this vector represents a solver (as
+     * given in metadata.solver_map) and the value at each index represents the probability that
+     * that solver is the fastest for given convolution problem. The problems are evaluated in
+     * parallel, the model is not modified by inference.
      *
-     * @param problem Problem
+     * @param features Feature vectors of problems
      */
-    std::vector<float> Forward(const conv::ProblemDescription& problem) const
+    std::vector<std::vector<float>> Forward(const std::vector<std::vector<float>>& features) const
     {
-        std::vector<float> features       = ToFeatures(problem);
-        std::vector<fdeep::tensor> output = model.predict({fdeep::tensor(input_shape, features)});
-        std::vector<float> output_vector  = output.front().to_vector();
-        std::vector<float> res(output_vector.begin() + offset, output_vector.end());
+        auto res = std::vector<std::vector<float>>(features.size());
+        par_for(features.size(), min_grain{1}, [&](auto i) {
+            const auto output        = model.predict({fdeep::tensor(input_shape, features[i])});
+            const auto output_vector = output.front().to_vector();
+            res[i].assign(output_vector.begin() + offset, output_vector.end());
+        });
         return res;
     }
+    /** Convert given problem to a numeric vector
+     *
+     * TunaNet takes in a numeric vector representing the given problem. The exact details
+     * of this vector vary from one TunaNet model to another, and thus this function, which
+     * converts a problem into a numeric vector that can be fed to TunaNet, must be implemented
+     * by each sub-class of `Model` on its own.
+     *
+     * @param problem Problem
+     */
+    virtual std::vector<float> ToFeatures(const conv::ProblemDescription& problem) const = 0;
 
 protected:
     const fdeep::model model;              // TunaNet model
@@ -184,16 +260,6 @@ protected:
             MIOPEN_THROW(miopenStatusInternalError, "Unable to load AI model file:" + file_path);
         return file_path.string();
     }
-    /** Convert given problem to a numeric vector
-     *
-     * TunaNet takes in a numeric vector representing the given problem. The exact details
-     * of this vector vary from one TunaNet model to another, and thus this function, which
-     * converts a problem into a numeric vector that can be fed to TunaNet, must be implemented
-     * by each sub-class of `Model` on its own.
-     *
-     * @param problem Problem
-     */
-    virtual std::vector<float> ToFeatures(const conv::ProblemDescription& problem) const = 0;
 };
 
 class Gfx908Model final : public Model
@@ -493,84 +559,123 @@ protected:
     }
 };
 
-std::unique_ptr<Model> GetModel(const std::string& device)
+/**
+ * Return the TunaNet model for given device
+ *
+ * Models are loaded on the first use and shared by all handles, so the model files are parsed
+ * once per architecture.
+ *
+ * @param device GPU Architecture
+ */
+std::shared_ptr<const Model> GetModel(const std::string& device)
+{
+    // gfx908 model is the default one if GPU-specific model is not available
+    const auto arch = device == "gfx942" || device == "gfx90a" ? device : std::string{"gfx908"};
+
+    static std::mutex mutex;
+    static std::map<std::string, std::shared_ptr<const Model>> models;
+
+    const auto lock = std::lock_guard<std::mutex>{mutex};
+    auto& model     = models[arch];
+    if(!model)
+    {
+        if(arch == "gfx942")
+            model = std::make_shared<Gfx942Model>();
+        else if(arch == "gfx90a")
+            model = std::make_shared<Gfx90aModel>();
+        else
+            model = std::make_shared<Gfx908Model>();
+    }
+    return model;
+}
+
+static void LogSolvers(const char* what, const std::vector<uint64_t>& solvers)
 {
-    if(device == "gfx942")
-        return std::make_unique<Gfx942Model>();
-    if(device == "gfx90a")
-        return std::make_unique<Gfx90aModel>();
-    return std::make_unique<Gfx908Model>(); // default model if GPU-specific model is not available
+    if(!miopen::IsLogging(LoggingLevel::Info2))
+        return;
+    std::stringstream ss;
+    for(auto& id : solvers)
+        ss << solver::Id{id}.ToString() << " ID:" << id << ", ";
+    MIOPEN_LOG_I2(what << ss.str());
 }
 
 std::vector<uint64_t> PredictSolver(const conv::ProblemDescription& problem,
                                     const ExecutionContext& ctx,
                                     const std::string& device)
 {
-    const static std::unique_ptr<Model> model = GetModel(device);
-    if(!model || !model->IsProblemSupported(problem, ctx))
-        return {};
-
-    std::string est_name = ":memory:" + device;
-    auto& db             = AnyRamDb::GetCached(est_name);
-    auto db_res          = db.FindRecord(problem);
-    if(db_res)
+    return PredictSolvers({problem}, ctx, device).front();
+}
+
+std::vector<std::vector<uint64_t>>
+PredictSolvers(const std::vector<conv::ProblemDescription>& problems,
+               const ExecutionContext& ctx,
+               const std::string& device)
+{
+    auto results     = std::vector<std::vector<uint64_t>>(problems.size());
+    const auto model = GetModel(device);
+
+    // Supported problems missing in the cache are evaluated together.
+    auto features = std::vector<std::vector<float>>{};
+    auto pending  = std::vector<std::size_t>{};
+
+    for(std::size_t i = 0; i < problems.size(); ++i)
     {
-        MIOPEN_LOG_I2("Cached heuristic (TunaNet) result found");
-        std::vector<uint64_t> db_sol(db_res->size());
-        // cast returned record to solver ids
-        std::transform(db_res->begin(), db_res->end(), db_sol.begin(), [](boost::any id) {
-            return boost::any_cast<uint64_t>(id);
-        });
-        if(miopen::IsLogging(LoggingLevel::Info2))
+        if(!model->IsProblemSupported(problems[i], ctx))
+            continue;
+
+        auto problem_features = model->ToFeatures(problems[i]);
+        if(auto cached = model->predictions.Get(problem_features))
         {
-            std::stringstream ss;
-            for(auto& id : db_sol)
-                ss << solver::Id{id}.ToString() << " ID:" << id << ", ";
-            MIOPEN_LOG_I2("Cached solvers: " << ss.str());
+            MIOPEN_LOG_I2("Cached heuristic (TunaNet) result found");
+            LogSolvers("Cached solvers: ", *cached);
+            results[i] = std::move(*cached);
+            continue;
         }
-        return db_sol;
+
+        features.emplace_back(std::move(problem_features));
+        pending.push_back(i);
     }
 
-    MIOPEN_LOG_I2("Evaluating TunaNet");
-    std::vector<float> res = model->Forward(problem); // res[i] gives the probability that the
-                                                      // i-th solver is the fastest for given
-                                                      // problem. ( The exact name of the i-th
-                                                      // solver may be obtained as follows:
-                                                      // model->metadata.solver_map.at(i) )
-
-    // sort solvers in order of their probabilities
-    std::vector<std::pair<int, float>> sort_res(res.size());
-    for(auto idx = 0; idx < res.size(); idx++)
-        sort_res[idx] = {idx, res[idx]};
-    const auto cmp = [](const std::pair<int, float>& a, const std::pair<int, float>& b) -> bool {
-        return a.second > b.second;
-    };
-    std::sort(sort_res.begin(), sort_res.end(), cmp);
-
-    // map solver idx to solver id and then to anysolver
-    std::vector<uint64_t> sol;
-    std::vector<boost::any> any_sol;
-    for(const auto& kinder : sort_res)
+    if(pending.empty())
+        return results;
+
+    MIOPEN_LOG_I2("Evaluating TunaNet for " << pending.size() << " problem(s)");
+    // outputs[k][i] gives the probability that the i-th solver is the fastest for k-th
+    // pending problem. ( The exact name of the i-th solver may be obtained as follows:
+    // model->metadata.solver_map.at(i) )
+    const auto outputs = model->Forward(features);
+
+    for(std::size_t k = 0; k < pending.size(); ++k)
     {
-        const auto id     = kinder.first; // index of solver in probability vector
-        const auto sol_id = solver::Id{model->metadata.solver_map.at(id)};
-        if(!sol_id.IsValid())
+        const auto& res = outputs[k];
+
+        // sort solvers in order of their probabilities
+        std::vector<std::pair<int, float>> sort_res(res.size());
+        for(auto idx = 0; idx < res.size(); idx++)
+            sort_res[idx] = {idx, res[idx]};
+        const auto cmp = [](const std::pair<int, float>& a,
+                            const std::pair<int, float>& b) -> bool { return a.second > b.second; };
+        std::sort(sort_res.begin(), sort_res.end(), cmp);
+
+        // map solver idx to solver id
+        std::vector<uint64_t> sol;
+        for(const auto& kinder : sort_res)
         {
-            MIOPEN_LOG_I2("Invalid solver " << model->metadata.solver_map.at(id) << " removed");
-            continue;
+            const auto id     = kinder.first; // index of solver in probability vector
+            const auto sol_id = solver::Id{model->metadata.solver_map.at(id)};
+            if(!sol_id.IsValid())
+            {
+                MIOPEN_LOG_I2("Invalid solver " << model->metadata.solver_map.at(id)
+                                                << " removed");
+                continue;
+            }
+            sol.push_back(sol_id.Value());
         }
-        sol.push_back(sol_id.Value());
-        any_sol.push_back(sol_id.Value());
+        model->predictions.Put(features[k], sol);
+        LogSolvers("TunaNet Result: ", sol);
+        results[pending[k]] = std::move(sol);
     }
-    db.StoreRecord(problem, any_sol);
-    if(miopen::IsLogging(LoggingLevel::Info2))
-    {
-        std::stringstream ss;
-        for(auto& id : sol)
-            ss << solver::Id{id}.ToString() << " ID:" << id << ", ";
-        MIOPEN_LOG_I2("TunaNet Result: " << ss.str());
-    }
-    return sol;
+    return results;
 }
 } // namespace immed_mode
 #endif // MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
@@ -670,20 +775,23 @@ private:
  * @param arch GPU Architecture
  * @param solver Solver
  */
-std::shared_ptr<Model> GetModel(const std::string& arch, const std::string& solver)
+std::shared_ptr<const Model> GetModel(const std::string& arch, const std::string& solver)
 {
-    static std::map<std::string, std::shared_ptr<Model>> models;
-    auto it = models.find(solver);
-    if(it == models.end())
-    {
-        std::shared_ptr<Model> model = std::make_shared<Model>(arch, solver);
-        models[solver]               = model;
-        return model;
-    }
-    else
-    {
-        return it->second;
-    }
+    static std::mutex mutex;
+    static std::map<std::pair<std::string, std::string>, std::shared_ptr<const Model>> models;
+
+    const auto lock = std::lock_guard<std::mutex>{mutex};
+    auto& model     = models[{arch, solver}];
+    if(!model)
+        model = std::make_shared<Model>(arch, solver);
+    return model;
+}
+
+template <class TMap>
+static typename TMap::mapped_type LookupOrDefault(const TMap& map, const std::string& key)
+{
+    const auto it = map.find(key);
+    return it != map.end() ? it->second : typename TMap::mapped_type{};
 }
 
 /**
@@ -732,7 +840,7 @@ bool ModelSetParams(const std::string& arch,
     {
 
         if(i == 0 && (model->metadata.predict_type == 0u))
-            num_tuning_params = model->metadata.num_tuning_params[dir];
+            num_tuning_params = LookupOrDefault(model->metadata.num_tuning_params, dir);
 
         fdeep::tensors decoder_output = model->Decode(decoder_input, context);
         auto token_scores             = decoder_output[0].to_vector(); // token_scores[k] gives the
@@ -748,7 +856,8 @@ bool ModelSetParams(const std::string& arch,
         {
             // get the token with the highest score and look up its value
             int token         = pq.top().second;
-            std::string value = model->metadata.tuning_decodings[std::to_string(token)];
+            std::string value =
+                LookupOrDefault(model->metadata.tuning_decodings, std::to_string(token));
             pq.pop();
 
             if(value == "-1") // if token-value is "-1", then decoding has finished
@@ -763,7 +872,7 @@ bool ModelSetParams(const std::string& arch,
                 output_token_index =
                     token; // index with largest value that is valid = predicted index
                 if(i == 0 && model->metadata.predict_type != 0u)
-                    num_tuning_params = model->metadata.num_tuning_params[value];
+                    num_tuning_params = LookupOrDefault(model->metadata.num_tuning_params, value);
                 break;
             }
         }
@@ -28,10 +28,20 @@
 
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/config.h>
+#include <miopen/find_controls.hpp>
+#include <miopen/find_timing.hpp>
 #include <miopen/mlo_internal.hpp>
+#include <miopen/par_for.hpp>
 #include <miopen/perf_field.hpp>
 #include <miopen/conv/problem_description.hpp>
 #include <miopen/solution.hpp>
+#include <miopen/trace.hpp>
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
+
+#include <algorithm>
+#include <chrono>
 
 MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_CONV_GEMM)
 MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_CONV_DIRECT)
@@ -220,7 +230,8 @@ static std::vector<Solution> EvaluateInvokers(Handle& handle,
                                               const NetworkConfig& network_config,
                                               const AnyInvokeParams& invoke_ctx,
                                               bool& is_result_optimal,
-                                              bool force_attach_binary)
+                                              bool force_attach_binary,
+                                              miopenFindTimingPolicy_t timing_policy)
 {
     const auto arch = env::value(MIOPEN_DEVICE_ARCH);
     if(!arch.empty())
@@ -255,34 +266,25 @@ static std::vector<Solution> EvaluateInvokers(Handle& handle,
             MIOPEN_THROW("Invoker is not provided by solver " + sol.solver_id);
 
         std::vector<Program> programs;
+        MIOPEN_TRACE_SCOPE("find", [&]() { return "Evaluate " + sol.solver_id; });
+
         const auto invoker = handle.PrepareInvoker(*sol.invoker_factory,
                                                    sol.construction_params,
                                                    force_attach_binary ? &programs : nullptr);
 
         try
         {
-            // Run invoker max 6 times, with ~5 sec time limit.
-            using elapsed_t                 = decltype(handle.GetKernelTime());
-            constexpr elapsed_t TIME_MS_MAX = 5000.0;
-            constexpr int N_RUNS_MAX        = 8;
-            constexpr int N_RUNS_DISCARD    = 3;
-            auto elapsed                    = static_cast<elapsed_t>(0);
-            auto first_elapsed              = static_cast<elapsed_t>(0);
-            int i                           = 0;
-            while(i < N_RUNS_MAX && elapsed < TIME_MS_MAX)
+            auto timing = InvokerTiming{timing_policy, best};
+            do
             {
                 invoker(handle, invoke_ctx);
-                elapsed += handle.GetKernelTime();
-                if(i < N_RUNS_DISCARD)
-                    first_elapsed += elapsed;
-                ++i;
-            }
-            // If the execution time was not too long,
-            // then the 1st run is not counted (assume it's warm-up):
-            if(i > 1)
-                elapsed = (elapsed - first_elapsed) / static_cast<elapsed_t>(i - N_RUNS_DISCARD);
+            } while(timing.Add(handle.GetKernelTime()));
+
+            const auto elapsed = timing.Estimate();
 
-            MIOPEN_LOG_I(sol << ": " << elapsed << (elapsed < best ? " < " : " >= ") << best);
+            MIOPEN_LOG_I(sol << ": " << elapsed << (elapsed < best ? " < " : " >= ") << best
+                             << ", spread: " << timing.Spread() << ", runs: " << timing.Runs()
+                             << (timing.IsAbandoned() ? ", abandoned" : ""));
             if(elapsed < best)
             {
                 best         = elapsed;
@@ -290,9 +292,9 @@ static std::vector<Solution> EvaluateInvokers(Handle& handle,
                 best_invoker = invoker;
             }
 
-            auto solution = Solution{solver::Id{selected.solver_id}, best, selected.workspace_sz};
+            auto solution = Solution{solver::Id{sol.solver_id}, elapsed, sol.workspace_sz};
             if(force_attach_binary)
-                solution.SetInvoker(invoker, programs, selected.construction_params);
+                solution.SetInvoker(invoker, programs, sol.construction_params);
             else
                 solution.SetInvoker(invoker, {}, {});
             ret.emplace_back(std::move(solution));
@@ -321,39 +323,85 @@ FindCoreResult FindCore(const AnyInvokeParams& invoke_ctx,
                         const std::optional<FindOptions>& options,
                         bool force_attach_binary)
 {
-    auto& handle = ctx.GetStream();
+    const auto tasks = std::vector<FindCoreTask>{{invoke_ctx, ctx, problem, parameters}};
+    return std::move(FindCore(tasks, finders, options, force_attach_binary).front());
+}
+
+std::vector<FindCoreResult> FindCore(const std::vector<FindCoreTask>& tasks,
+                                     const std::vector<std::unique_ptr<ISolversFinder>>& finders,
+                                     const std::optional<FindOptions>& options,
+                                     bool force_attach_binary)
+{
+    if(tasks.empty())
+        return {};
+
+    MIOPEN_TRACE_SCOPE("find", "FindCore");
+
+    auto& handle = tasks.front().ctx.GetStream();
+
+    if(std::any_of(tasks.begin(), tasks.end(), [&](auto&& task) {
+           return &task.ctx.GetStream() != &handle;
+       }))
+        MIOPEN_THROW(miopenStatusBadParm, "All problems of a batched find must share a handle.");
 
     // Find
-    auto solutions = std::map<AlgorithmName, std::vector<solver::ConvSolution>>{};
-    std::transform(
-        finders.begin(), finders.end(), std::inserter(solutions, solutions.end()), [&](auto&& f) {
-            return std::make_pair(f->GetAlgorithmName(problem),
-                                  f->Find(ctx, problem, invoke_ctx, parameters, options));
+    // Finders are independent and mostly do host-side work, so they run concurrently unless
+    // a search is possible. Searching benchmarks kernels, which must not overlap.
+    const auto enforce = options && options->find_enforce ? *options->find_enforce : FindEnforce{};
+    const auto is_parallel =
+        IsParallelFindEnabled() && std::none_of(tasks.begin(), tasks.end(), [&](auto&& task) {
+            return task.ctx.do_search || enforce.IsSearch(task.ctx);
         });
 
+    auto found     = std::vector<std::vector<solver::ConvSolution>>(tasks.size() * finders.size());
+    const auto run = [&](auto i) {
+        const auto& task   = tasks[i / finders.size()];
+        const auto& finder = finders[i % finders.size()];
+        MIOPEN_TRACE_SCOPE("find", [&]() {
+            return "Find " + finder->GetAlgorithmName(task.problem).ToString();
+        });
+        const auto start = std::chrono::steady_clock::now();
+        found[i] = finder->Find(task.ctx, task.problem, task.invoke_ctx, task.parameters, options);
+        const auto end = std::chrono::steady_clock::now();
+        MIOPEN_LOG_I(finder->GetAlgorithmName(task.problem).ToString()
+                     << ": " << found[i].size() << " solution(s), host time: "
+                     << std::chrono::duration<double, std::milli>(end - start).count() << " ms");
+    };
+
+    if(is_parallel)
+        par_for(found.size(), min_grain{1}, run);
+    else
+        for(std::size_t i = 0; i < found.size(); ++i)
+            run(i);
+
+    // Results are collected in the order of finders, whatever the order of completion was.
+    using Solutions   = std::map<AlgorithmName, std::vector<solver::ConvSolution>>;
+    auto solutions    = std::vector<Solutions>(tasks.size());
     std::size_t total = 0;
 
-    for(auto it = solutions.begin(); it != solutions.end();)
+    for(std::size_t t = 0; t < tasks.size(); ++t)
     {
-        if(it->second.empty())
+        for(std::size_t i = 0; i < finders.size(); ++i)
         {
-            it = solutions.erase(it);
-            continue;
+            auto& ss = found[t * finders.size() + i];
+            if(ss.empty())
+                continue;
+            total += ss.size();
+            solutions[t].emplace(finders[i]->GetAlgorithmName(tasks[t].problem), std::move(ss));
         }
-
-        total += it->second.size();
-        ++it;
     }
 
     // Precompile
     {
+        MIOPEN_TRACE_SCOPE("find", "PrecompileSolutions");
         auto all = std::vector<const miopen::solver::ConvSolution*>{};
         all.reserve(total);
-        for(const auto& ss : solutions)
-            std::transform(ss.second.begin(),
-                           ss.second.end(),
-                           std::back_inserter(all),
-                           [](auto&& s) { return &s; });
+        for(const auto& task_solutions : solutions)
+            for(const auto& ss : task_solutions)
+                std::transform(ss.second.begin(),
+                               ss.second.end(),
+                               std::back_inserter(all),
+                               [](auto&& s) { return &s; });
         PrecompileSolutions(handle, all, force_attach_binary);
     }
 
@@ -364,27 +412,38 @@ FindCoreResult FindCore(const AnyInvokeParams& invoke_ctx,
 
     // Evaluate Invokers
     AutoEnableProfiling enableProfiling{handle};
-    const auto network_config = problem.MakeNetworkConfig();
-    auto ret                  = FindCoreResult();
-    ret.is_optimal            = true;
+    const auto timing_policy =
+        InvokerTiming::Resolve(options ? options->timing_policy : miopenFindTimingPolicyDefault);
 
-    ret.solutions.reserve(total);
+    auto ret = std::vector<FindCoreResult>(tasks.size());
 
-    for(const auto& ss : solutions)
+    for(std::size_t t = 0; t < tasks.size(); ++t)
     {
-        auto evaluated = EvaluateInvokers(handle,
-                                          ss.second,
-                                          ss.first,
-                                          network_config,
-                                          invoke_ctx,
-                                          ret.is_optimal,
-                                          force_attach_binary);
-
-        ret.solutions.insert(ret.solutions.end(),
-                             std::make_move_iterator(evaluated.begin()),
-                             std::make_move_iterator(evaluated.end()));
+        MIOPEN_TRACE_SCOPE("find", "EvaluateInvokers");
+        const auto network_config = tasks[t].problem.MakeNetworkConfig();
+        ret[t].is_optimal         = true;
+
+        for(const auto& ss : solutions[t])
+        {
+            auto evaluated = EvaluateInvokers(handle,
+                                              ss.second,
+                                              ss.first,
+                                              network_config,
+                                              tasks[t].invoke_ctx,
+                                              ret[t].is_optimal,
+                                              force_attach_binary,
+                                              timing_policy);
+
+            ret[t].solutions.insert(ret[t].solutions.end(),
+                                    std::make_move_iterator(evaluated.begin()),
+                                    std::make_move_iterator(evaluated.end()));
+        }
     }
 
+#if MIOPEN_ENABLE_SQLITE
+    // Tuning results are not searched for again by the other processes.
+    SQLite::FlushAll();
+#endif
     return ret;
 }
 
@@ -43,6 +43,7 @@
 #include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace miopen {
@@ -102,6 +103,18 @@ bool PlainTextDb::StoreRecord(const DbRecord& record)
     return StoreRecordUnsafe(record);
 }
 
+bool PlainTextDb::StoreRecords(const std::vector<DbRecord>& records)
+{
+    if(DisableUserDbFileIO)
+        return true;
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    auto ok = true;
+    for(const auto& record : records)
+        ok = StoreRecordUnsafe(record) && ok;
+    return ok;
+}
+
 bool PlainTextDb::UpdateRecord(DbRecord& record)
 {
     if(DisableUserDbFileIO)
@@ -157,15 +170,19 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
         return boost::none;
     }
 
-    int n_line = 0;
+    // Positions are tracked by hand, tellg() costs a syscall per line.
+    auto line            = std::string{};
+    auto next_line_begin = std::streamoff{0};
+    int n_line           = 0;
     while(true)
     {
-        std::string line;
-        const auto line_begin = file.tellg();
+        const auto line_begin = next_line_begin;
         if(!std::getline(file, line))
             break;
         ++n_line;
-        const auto next_line_begin = file.tellg();
+        // Mimics tellg(), which fails when the last line is not terminated.
+        next_line_begin = file.eof() ? std::streamoff{-1}
+                                     : line_begin + static_cast<std::streamoff>(line.size()) + 1;
 
         const auto key_size = line.find('=');
         const bool is_key   = (key_size != std::string::npos && key_size != 0);
@@ -177,14 +194,15 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
             }
             continue;
         }
-        const auto current_key = line.substr(0, key_size);
+        // Views do not allocate for every line of the file.
+        const auto current_key = std::string_view{line}.substr(0, key_size);
 
         if(current_key != key)
         {
             continue;
         }
         MIOPEN_LOG_I2("Key match: " << current_key);
-        const auto contents = line.substr(key_size + 1);
+        const auto contents = std::string_view{line}.substr(key_size + 1);
 
         if(contents.empty())
         {
@@ -23,10 +23,13 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <numeric>
 #include <ostream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 
@@ -120,24 +123,33 @@ static bool TransformFindDbItem10to20(std::string& id, std::string& values)
 
 bool DbRecord::ParseContents(std::istream& contents)
 {
-    std::string id_and_values;
+    const auto text = std::string{std::istreambuf_iterator<char>{contents}, {}};
+    return ParseContents(std::string_view{text});
+}
+
+bool DbRecord::ParseContents(std::string_view contents)
+{
     int found = 0;
 
     map.clear();
 
-    while(std::getline(contents, id_and_values, ';'))
+    while(!contents.empty())
     {
+        const auto end           = std::min(contents.find(';'), contents.size());
+        const auto id_and_values = contents.substr(0, end);
+        contents.remove_prefix(std::min(end + 1, contents.size()));
+
         const auto id_size = id_and_values.find(':');
 
         // Empty VALUES is ok, empty ID is not:
-        if(id_size == std::string::npos)
+        if(id_size == std::string_view::npos)
         {
             MIOPEN_LOG_E("Ill-formed file: ID not found; skipped; key: " << key);
             continue;
         }
 
-        auto id     = id_and_values.substr(0, id_size);
-        auto values = id_and_values.substr(id_size + 1);
+        auto id     = std::string{id_and_values.substr(0, id_size)};
+        auto values = std::string{id_and_values.substr(id_size + 1)};
 
 #if WORKAROUND_ISSUE_1987
         // Detect legacy find-db item (v.1.0 ID:VALUES) and transform it to the current format.
@@ -153,13 +165,13 @@ bool DbRecord::ParseContents(std::istream& contents)
         }
 #endif
 
-        if(map.find(id) != map.end())
+        const auto inserted = map.emplace(std::move(id), std::move(values));
+        if(!inserted.second)
         {
-            MIOPEN_LOG_E("Duplicate ID (ignored): " << id << "; key: " << key);
+            MIOPEN_LOG_E("Duplicate ID (ignored): " << inserted.first->first << "; key: " << key);
             continue;
         }
 
-        map.emplace(id, values);
         ++found;
     }
 
@@ -46,6 +46,7 @@ MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_FIND_ENFORCE)
 MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_DEBUG_FIND_ONLY_SOLVER)
 MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_FIND_MODE)
 MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_FIND_MODE_FUSION)
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_PARALLEL_FIND)
 
 namespace miopen {
 
@@ -178,6 +179,8 @@ boost::optional<std::vector<solver::Id>> GetEnvFindOnlySolver()
     return once;
 }
 
+bool IsParallelFindEnabled() { return !env::disabled(MIOPEN_DEBUG_PARALLEL_FIND); }
+
 namespace {
 
 const char* ToCString(const FindMode::Values mode)
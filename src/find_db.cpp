@@ -226,7 +226,9 @@ fs::path FindDbRecord_t<TDb>::GetUserPath(Handle& handle, const std::string& pat
 }
 
 template <class TDb>
-bool FindDbRecord_t<TDb>::Validate(Handle& handle, const NetworkConfig& config) const
+bool FindDbRecord_t<TDb>::Validate(Handle& handle,
+                                   const NetworkConfig& config,
+                                   const std::function<bool(const std::string&)>& prepare) const
 {
     auto unbuilt = false;
     auto any     = false;
@@ -235,7 +237,8 @@ bool FindDbRecord_t<TDb>::Validate(Handle& handle, const NetworkConfig& config)
     {
         if(in_sync)
         {
-            if(!handle.GetInvoker(config, {{pair.first}}))
+            // The invoker may still be restored without running find, e.g. from the warm start db.
+            if(!handle.GetInvoker(config, {{pair.first}}) && !(prepare && prepare(pair.first)))
             {
                 unbuilt = true;
                 // This is not an logged as error because no error was detected.
@@ -0,0 +1,188 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/find_timing.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <iterator>
+#include <numeric>
+#include <string>
+
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_FIND_TIMING_POLICY)
+
+namespace miopen {
+
+namespace {
+
+constexpr float TimeMsMax = 5000.0f;
+
+namespace fixed {
+constexpr std::size_t RunsMax     = 8;
+constexpr std::size_t RunsDiscard = 3;
+} // namespace fixed
+
+namespace adaptive {
+constexpr std::size_t RunsDiscard = 1;
+// Counted runs, i.e. excluding the warm-up one.
+constexpr std::size_t RunsMin = 3;
+constexpr std::size_t RunsMax = 20;
+// Kernel times are mostly disturbed upwards, so the fastest run is a safe lower bound.
+// A single run is trusted less than several ones.
+constexpr float WarmupAbandonRatio = 10.0f;
+constexpr float SingleAbandonRatio = 2.0f;
+constexpr float AbandonRatio       = 1.05f;
+// Differences below that are not worth spending more runs on.
+constexpr float RelativePrecision = 0.01f;
+} // namespace adaptive
+
+float Median(std::vector<float> values)
+{
+    const auto mid = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), mid, values.end());
+    if(values.size() % 2 != 0)
+        return *mid;
+    return (*mid + *std::max_element(values.begin(), mid)) / 2;
+}
+
+} // namespace
+
+InvokerTiming::InvokerTiming(miopenFindTimingPolicy_t policy_, float best_)
+    : policy(Resolve(policy_)), best(best_)
+{
+}
+
+miopenFindTimingPolicy_t InvokerTiming::Resolve(miopenFindTimingPolicy_t policy)
+{
+    if(policy != miopenFindTimingPolicyDefault)
+        return policy;
+
+    auto str = env::value(MIOPEN_FIND_TIMING_POLICY);
+    for(auto& c : str)
+        c = toupper(static_cast<unsigned char>(c));
+
+    if(str.empty() || str == "ADAPTIVE" || str == "2")
+        return miopenFindTimingPolicyAdaptive;
+    if(str == "FIXED" || str == "1")
+        return miopenFindTimingPolicyFixed;
+
+    MIOPEN_LOG_W("Wrong MIOPEN_FIND_TIMING_POLICY, using default.");
+    return miopenFindTimingPolicyAdaptive;
+}
+
+std::size_t InvokerTiming::Discarded() const
+{
+    if(samples.empty())
+        return 0;
+    const auto discard =
+        policy == miopenFindTimingPolicyFixed ? fixed::RunsDiscard : adaptive::RunsDiscard;
+    return std::min(discard, samples.size() - 1);
+}
+
+bool InvokerTiming::Add(float time)
+{
+    samples.push_back(time);
+    total += time;
+
+    if(total >= TimeMsMax)
+        return false;
+    if(policy == miopenFindTimingPolicyFixed)
+        return samples.size() < fixed::RunsMax;
+    return NeedsMoreAdaptive();
+}
+
+bool InvokerTiming::NeedsMoreAdaptive()
+{
+    if(samples.size() <= adaptive::RunsDiscard)
+    {
+        abandoned = samples.back() > best * adaptive::WarmupAbandonRatio;
+        return !abandoned;
+    }
+
+    const auto counted = samples.size() - adaptive::RunsDiscard;
+    const auto fastest = *std::min_element(samples.begin() + adaptive::RunsDiscard, samples.end());
+    const auto ratio   = counted == 1 ? adaptive::SingleAbandonRatio : adaptive::AbandonRatio;
+
+    if(fastest > best * ratio)
+    {
+        abandoned = true;
+        return false;
+    }
+
+    if(counted < adaptive::RunsMin)
+        return true;
+    if(counted >= adaptive::RunsMax)
+        return false;
+
+    // Distribution-free ~95% confidence interval of the median, bounded by order statistics.
+    // Unlike the spread, it doesn't collapse when most of few runs take exactly the same time.
+    auto sorted = std::vector<float>(samples.begin() + adaptive::RunsDiscard, samples.end());
+    std::sort(sorted.begin(), sorted.end());
+    const auto n    = static_cast<float>(counted);
+    const auto k    = std::max(1.0f, std::floor((n + 1) / 2 - 0.98f * std::sqrt(n)));
+    const auto low  = sorted[static_cast<std::size_t>(k) - 1];
+    const auto high = sorted[counted - static_cast<std::size_t>(k)];
+
+    if(high - low <= 2 * adaptive::RelativePrecision * Estimate())
+        return false;
+    return low <= best && best <= high;
+}
+
+float InvokerTiming::Estimate() const
+{
+    if(samples.empty())
+        MIOPEN_THROW("No runs have been timed");
+
+    const auto first = samples.begin() + Discarded();
+
+    if(policy == miopenFindTimingPolicyFixed)
+        return std::accumulate(first, samples.end(), 0.0f) /
+               static_cast<float>(samples.end() - first);
+
+    return Median({first, samples.end()});
+}
+
+float InvokerTiming::Spread() const
+{
+    const auto first = samples.begin() + Discarded();
+    if(samples.end() - first < 2)
+        return 0.0f;
+
+    const auto median = Median({first, samples.end()});
+    auto deviations   = std::vector<float>{};
+    deviations.reserve(samples.end() - first);
+    std::transform(first, samples.end(), std::back_inserter(deviations), [&](auto time) {
+        return std::abs(time - median);
+    });
+    // Makes the median absolute deviation consistent with the standard deviation.
+    return 1.4826f * Median(std::move(deviations));
+}
+
+} // namespace miopen
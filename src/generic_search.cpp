@@ -29,6 +29,7 @@
 
 #include <cstddef>
 #include <chrono>
+#include <string>
 
 namespace miopen {
 namespace solver {
@@ -63,5 +64,22 @@ std::chrono::milliseconds GetTuningTimeMax()
 
 std::size_t GetTuningThreadsMax() { return env::value(MIOPEN_COMPILE_PARALLEL_LEVEL); }
 
+void TuningStats::Log(const std::string& solver_id,
+                      std::size_t n_configs,
+                      std::size_t n_threads) const
+{
+    using ms          = std::chrono::duration<float, std::milli>;
+    const auto total  = std::chrono::duration_cast<ms>(Clock::now() - start).count();
+    const auto n_done = n_compiled.load();
+
+    MIOPEN_LOG_I(solver_id << ": " << total << " ms total; compiled " << n_done << '/' << n_configs
+                           << " configs in " << ms{Clock::duration{compile.load()}}.count()
+                           << " ms on " << n_threads << " thread(s); benchmarked " << n_benchmarked
+                           << " in " << std::chrono::duration_cast<ms>(benchmark).count()
+                           << " ms; waited for compilation "
+                           << std::chrono::duration_cast<ms>(wait).count() << " ms; cancelled "
+                           << (n_configs > n_done ? n_configs - n_done : 0));
+}
+
 } // namespace solver
 } // namespace miopen
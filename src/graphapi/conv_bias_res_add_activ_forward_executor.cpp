@@ -30,6 +30,8 @@
 #include <miopen/handle.hpp>
 #include <miopen/visit_float.hpp>
 
+#include <nlohmann/json.hpp>
+
 namespace miopen {
 
 namespace graphapi {
@@ -58,43 +60,126 @@ ConvolutionDescriptor Convert(const Convolution& conv, int groupCount)
             Convert(conv.getPostPaddings()),
             groupCount};
 }
+
+nlohmann::json ToJson(const Tensor& tensor)
+{
+    return {
+        {"id", tensor.getId()},
+        {"virtual", tensor.isVirtual()},
+        {"type", tensor.GetType()},
+        {"lengths", tensor.GetLengths()},
+        {"strides", tensor.GetStrides()},
+    };
+}
+
+Tensor TensorFromJson(const nlohmann::json& json)
+{
+    return {json.at("type").get<miopenDataType_t>(),
+            json.at("lengths").get<std::vector<std::size_t>>(),
+            json.at("strides").get<std::vector<std::size_t>>(),
+            json.at("id").get<int64_t>(),
+            json.at("virtual").get<bool>()};
+}
+
+nlohmann::json ToJson(const Convolution& conv)
+{
+    return {
+        {"comp_type", conv.getCompType()},
+        {"mode", conv.getMode()},
+        {"spatial_dims", conv.getSpatialDims()},
+        {"pre_paddings", conv.getPrePaddings()},
+        {"filter_strides", conv.getFilterStrides()},
+        {"dilations", conv.getDilations()},
+        {"post_paddings", conv.getPostPaddings()},
+    };
+}
+
+Convolution ConvolutionFromJson(const nlohmann::json& json)
+{
+    return {json.at("comp_type").get<miopenDataType_t>(),
+            json.at("mode").get<miopenConvolutionMode_t>(),
+            json.at("spatial_dims").get<std::size_t>(),
+            json.at("pre_paddings").get<std::vector<int64_t>>(),
+            json.at("filter_strides").get<std::vector<int64_t>>(),
+            json.at("dilations").get<std::vector<int64_t>>(),
+            json.at("post_paddings").get<std::vector<int64_t>>()};
+}
 } // namespace
 
 void ConvBiasResAddActivForwardExecutor::execute(miopenHandle_t handle, const VariantPack& vpk)
 {
-    auto convDesc = Convert(*mConvolution, mGroupCount);
+    auto convDesc = Convert(mConvolution, mGroupCount);
 
     ActivationDescriptor activDesc{miopenActivationRELU, mActivationAlpha, 1.0, 1.0};
 
-    auto* xData    = vpk.getDataPointer(mXTensor->getId());
-    auto* wData    = vpk.getDataPointer(mWTensor->getId());
-    auto* zData    = vpk.getDataPointer(mZTensor->getId());
-    auto* biasData = vpk.getDataPointer(mBiasTensor->getId());
-    auto* yData    = vpk.getDataPointer(mYTensor->getId());
+    auto* xData    = vpk.getDataPointer(mXTensor.getId());
+    auto* wData    = vpk.getDataPointer(mWTensor.getId());
+    auto* zData    = vpk.getDataPointer(mZTensor.getId());
+    auto* biasData = vpk.getDataPointer(mBiasTensor.getId());
+    auto* yData    = vpk.getDataPointer(mYTensor.getId());
 
     auto status =
         ConvBiasActivFusion(miopen::deref(handle),
                             &mAlpha1,
-                            *mXTensor,
+                            mXTensor,
                             xData,
-                            *mWTensor,
+                            mWTensor,
                             wData,
                             convDesc,
                             miopenConvFwdAlgorithm_t::miopenConvolutionFwdAlgoImplicitGEMM,
                             nullptr,
                             0,
                             &mAlpha2,
-                            *mZTensor,
+                            mZTensor,
                             zData,
-                            *mBiasTensor,
+                            mBiasTensor,
                             biasData,
                             activDesc,
-                            *mYTensor,
+                            mYTensor,
                             yData);
 
     MIOPEN_THROW_IF(status != miopenStatusSuccess, "execute failed");
 }
 
+void ConvBiasResAddActivForwardExecutor::toJson(nlohmann::json& json) const
+{
+    json = {
+        {"kind", Kind},
+        {"x", ToJson(mXTensor)},
+        {"w", ToJson(mWTensor)},
+        {"convolution", ToJson(mConvolution)},
+        {"group_count", mGroupCount},
+        {"z", ToJson(mZTensor)},
+        {"bias", ToJson(mBiasTensor)},
+        {"y", ToJson(mYTensor)},
+        {"alpha1", mAlpha1},
+        {"alpha2", mAlpha2},
+        {"activation_alpha", mActivationAlpha},
+    };
+}
+
+std::unique_ptr<GraphPatternExecutor>
+ConvBiasResAddActivForwardExecutor::fromJson(const nlohmann::json& json)
+{
+    auto x           = TensorFromJson(json.at("x"));
+    auto w           = TensorFromJson(json.at("w"));
+    auto convolution = ConvolutionFromJson(json.at("convolution"));
+    auto z           = TensorFromJson(json.at("z"));
+    auto bias        = TensorFromJson(json.at("bias"));
+    auto y           = TensorFromJson(json.at("y"));
+
+    return make(&x,
+                &w,
+                &convolution,
+                json.at("group_count").get<int>(),
+                &z,
+                &bias,
+                &y,
+                json.at("alpha1").get<float>(),
+                json.at("alpha2").get<float>(),
+                json.at("activation_alpha").get<float>());
+}
+
 } // namespace graphapi
 
 } // namespace miopen
@@ -24,16 +24,40 @@
  *
  *******************************************************************************/
 
+#include <miopen/base64.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/graphapi/conv_bias_res_add_activ_forward_executor.hpp>
 #include <miopen/graphapi/engine.hpp>
 #include <miopen/graphapi/opgraph.hpp>
 
+#include <nlohmann/json.hpp>
+
+#include <map>
+#include <string>
+
 namespace miopen {
 
 namespace graphapi {
 
 GraphPatternExecutor::~GraphPatternExecutor() = default;
 
+void GraphPatternExecutor::toJson(nlohmann::json&) const
+{
+    MIOPEN_THROW(miopenStatusNotImplemented, "The engine executor does not support serialization");
+}
+
+std::shared_ptr<GraphPatternExecutor> GraphPatternExecutor::fromJson(const nlohmann::json& json)
+{
+    const auto kind = json.at("kind").get<std::string>();
+
+    if(kind == GraphExecutorFind20::Kind)
+        return GraphExecutorFind20::fromJson(json);
+    if(kind == ConvBiasResAddActivForwardExecutor::Kind)
+        return ConvBiasResAddActivForwardExecutor::fromJson(json);
+
+    MIOPEN_THROW(miopenStatusBadParm, "Unknown engine executor kind: " + kind);
+}
+
 size_t GraphExecutorFind20::getWorkspaceSize() const
 {
     return miopen::deref(mSolution).GetWorkspaceSize();
@@ -92,6 +116,41 @@ void GraphExecutorFind20::execute(miopenHandle_t handle, const VariantPack& vpk)
     }
 }
 
+void GraphExecutorFind20::toJson(nlohmann::json& json) const
+{
+    // Sorted by the id, the map order would make the representation differ between runs
+    auto arguments = std::map<int64_t, miopenTensorArgumentId_t>{};
+    for(const auto& [id, info] : *mTensorInfoMap)
+        arguments.emplace(id, info.mEnumId);
+
+    auto tensors = nlohmann::json::array();
+    for(const auto& [id, argument] : arguments)
+        tensors.push_back({{"id", id}, {"argument", argument}});
+
+    // The solution is stored with its code objects so a restored plan doesn't compile anything
+    json = {
+        {"kind", Kind},
+        {"tensors", std::move(tensors)},
+        {"solution", EncodeBase64(miopen::deref(mSolution).Save())},
+    };
+}
+
+std::unique_ptr<GraphPatternExecutor> GraphExecutorFind20::fromJson(const nlohmann::json& json)
+{
+    auto tensorMap = std::make_shared<TensorInfoMap>();
+    for(const auto& tensor : json.at("tensors"))
+    {
+        tensorMap->emplace(tensor.at("id").get<int64_t>(),
+                           TensorInfo{tensor.at("argument").get<miopenTensorArgumentId_t>()});
+    }
+
+    const auto blob = DecodeBase64(json.at("solution").get<std::string>());
+    auto solution   = std::make_shared<Solution>(
+        Solution::Load(reinterpret_cast<const char*>(blob.data()), blob.size()));
+
+    return std::make_unique<GraphExecutorFind20>(std::move(solution), tensorMap);
+}
+
 EngineBuilder& EngineBuilder::setGraph(OpGraph* g)
 {
     assert(g);
@@ -135,6 +194,26 @@ Engine EngineBuilder::build()
     return e;
 }
 
+void to_json(nlohmann::json& json, const Engine& engine)
+{
+    auto executor = nlohmann::json{};
+    checkPtr(engine.mExecutor.get())->toJson(executor);
+
+    json = {
+        {"global_index", engine.mGlobalIndex},
+        {"sm_count", engine.mSmCount},
+        {"executor", std::move(executor)},
+    };
+}
+
+void from_json(const nlohmann::json& json, Engine& engine)
+{
+    engine              = {};
+    engine.mGlobalIndex = json.at("global_index").get<int64_t>();
+    engine.mSmCount     = json.at("sm_count").get<int32_t>();
+    engine.mExecutor    = GraphPatternExecutor::fromJson(json.at("executor"));
+}
+
 void BackendEngineDescriptor::setAttribute(miopenBackendAttributeName_t attributeName,
                                            miopenBackendAttributeType_t attributeType,
                                            int64_t elementCount,
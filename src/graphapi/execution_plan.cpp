@@ -26,14 +26,27 @@
 
 #include <miopen/graphapi/execution_plan.hpp>
 
+#include <nlohmann/json.hpp>
+
 namespace miopen {
 
 namespace graphapi {
 
+namespace {
+
+// Bumped on any incompatible change of the plan representation
+constexpr int JsonVersion = 1;
+
+} // namespace
+
 std::string ExecutionPlan::getJsonRepresentation() const
 {
-    /// \todo Implement ExecutionPlan::getJsonRepresentation --Sergei May, 2024
-    return {};
+    const auto json = nlohmann::json{
+        {"version", JsonVersion},
+        {"engine", mEngineCfg.getEngine()},
+        {"intermediate_ids", mIntermediateIds},
+    };
+    return json.dump();
 }
 
 ExecutionPlanBuilder& ExecutionPlanBuilder::setHandle(miopenHandle_t handle) &
@@ -70,8 +83,25 @@ ExecutionPlanBuilder& ExecutionPlanBuilder::setIntermediateIds(std::vector<int64
 
 ExecutionPlanBuilder& ExecutionPlanBuilder::setJsonRepresentation(const std::string_view& s) &
 {
-    // TODO: Implement ExecutionPlanBuilder::setJsonRepresentation
-    (void)s;
+    try
+    {
+        const auto json = nlohmann::json::parse(s);
+
+        if(json.at("version").get<int>() != JsonVersion)
+        {
+            MIOPEN_THROW(miopenStatusVersionMismatch,
+                         "Execution plan has been serialized by another version");
+        }
+
+        mExecutionPlan.mEngineCfg       = json.at("engine").get<Engine>();
+        mExecutionPlan.mIntermediateIds = json.at("intermediate_ids").get<std::vector<int64_t>>();
+        mEngineCfgSet                   = true;
+    }
+    catch(const nlohmann::json::exception& ex)
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     std::string{"Invalid execution plan representation: "} + ex.what());
+    }
     return *this;
 }
 
@@ -30,6 +30,7 @@
 #include <miopen/graphapi/engine.hpp>
 #include <miopen/graphapi/matmul.hpp>
 #include <miopen/graphapi/opgraph.hpp>
+#include <miopen/graphapi/pattern_registry.hpp>
 #include <miopen/graphapi/pointwise.hpp>
 #include <miopen/graphapi/reduction.hpp>
 #include <miopen/graphapi/reshape.hpp>
@@ -123,6 +124,8 @@ public:
         return n;
     }
 
+    const OpGraph& patternGraph() const final { return getPatternGraph(); }
+
     bool matches(const OpGraph* graph_ptr) const final
     {
         assert(graph_ptr);
@@ -407,6 +410,8 @@ public:
         return n;
     }
 
+    const OpGraph& patternGraph() const final { return getPatternGraph(); }
+
     bool matches(const OpGraph* graph_ptr) const final
     {
         assert(graph_ptr);
@@ -949,6 +954,8 @@ public:
         return n;
     }
 
+    const OpGraph& patternGraph() const final { return getPatternGraph(); }
+
     bool matches(const OpGraph* graph_ptr) const final
     {
         assert(graph_ptr);
@@ -1013,25 +1020,82 @@ public:
     }
 };
 
-std::vector<Engine> findEngines(OpGraph* graph)
+const GraphPatternRegistry& GraphPatternRegistry::global()
 {
-    assert(graph);
+    static const auto registry = []() {
+        auto tmp = GraphPatternRegistry{};
+        tmp.add(MHA_Fwd_F8_Pattern::Make());
+        tmp.add(MHA_Bwd_F8_Pattern::Make());
+        tmp.add(ConvBiasResAddActive_Fwd_Pattern::Make());
+        return tmp;
+    }();
+
+    return registry;
+}
+
+void GraphPatternRegistry::add(std::unique_ptr<GraphPatternMatcher> pattern)
+{
+    assert(pattern);
+    const auto& graph = pattern->patternGraph();
+    auto signature    = GraphSignature{graph};
+    mSizes.emplace(graph.numNodes(), graph.numEdges());
+    mIndex.emplace(signature.hash(), mPatterns.size());
+    mSignatures.emplace_back(std::move(signature));
+    mPatterns.emplace_back(std::move(pattern));
+}
+
+std::vector<const GraphPatternMatcher*>
+GraphPatternRegistry::getCandidates(const GraphSignature& signature) const
+{
+    std::vector<size_t> indices;
+    auto [begin, end] = mIndex.equal_range(signature.hash());
+    for(auto it = begin; it != end; ++it)
+    {
+        if(mSignatures[it->second] == signature)
+        {
+            indices.emplace_back(it->second);
+        }
+    }
+    std::sort(indices.begin(), indices.end());
 
-    std::vector<std::unique_ptr<GraphPatternMatcher>> patterns;
-    patterns.emplace_back(MHA_Fwd_F8_Pattern::Make());
-    patterns.emplace_back(MHA_Bwd_F8_Pattern::Make());
-    patterns.emplace_back(ConvBiasResAddActive_Fwd_Pattern::Make());
+    std::vector<const GraphPatternMatcher*> candidates;
+    candidates.reserve(indices.size());
+    for(size_t i : indices)
+    {
+        candidates.emplace_back(mPatterns[i].get());
+    }
+    return candidates;
+}
+
+const GraphPatternMatcher* GraphPatternRegistry::findMatch(const OpGraph& graph) const
+{
+    if(mSizes.count({graph.numNodes(), graph.numEdges()}) == 0)
+    {
+        return nullptr;
+    }
 
-    for(const auto& p : patterns)
+    for(const auto* p : getCandidates(GraphSignature{graph}))
     {
-        if(p->matches(graph))
+        if(p->matches(&graph))
         {
-            MIOPEN_LOG_I2("Matched against pattern: " << p->name());
-            return p->getEngines(graph);
+            return p;
         }
     }
+    return nullptr;
+}
+
+std::vector<Engine> findEngines(OpGraph* graph)
+{
+    assert(graph);
+
+    const auto* p = GraphPatternRegistry::global().findMatch(*graph);
+    if(p == nullptr)
+    {
+        return {};
+    }
 
-    return {};
+    MIOPEN_LOG_I2("Matched against pattern: " << p->name());
+    return p->getEngines(graph);
 }
 
 } // end namespace graphapi
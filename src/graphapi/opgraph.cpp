@@ -28,14 +28,218 @@
 #include <miopen/graphapi/opgraph.hpp>
 #include <miopen/graphapi/engine.hpp>
 
-#include <deque>
+#include <algorithm>
+#include <functional>
+#include <map>
 #include <unordered_map>
+#include <utility>
 
 namespace miopen {
 namespace graphapi {
 
 OpNode::~OpNode() = default;
 
+namespace internal {
+
+std::vector<const OpNode*> topologicalOrder(const OpGraph& graph)
+{
+    std::vector<const OpNode*> order;
+    order.reserve(graph.numNodes() + 2);
+
+    std::unordered_map<const OpNode*, size_t> in_degrees;
+    auto visit = [&](const OpNode* n) {
+        auto in_degree = graph.getInEdges(n).size();
+        if(in_degree == 0)
+        {
+            order.emplace_back(n);
+        }
+        else
+        {
+            in_degrees.emplace(n, in_degree);
+        }
+    };
+
+    visit(graph.getSourceNode());
+    for(const OpNode* n : graph.getNodes())
+    {
+        visit(n);
+    }
+    visit(graph.getSinkNode());
+
+    // Kahn's algorithm: order serves as the queue of nodes whose producers are all ordered.
+    for(size_t i = 0; i < order.size(); ++i)
+    {
+        for(const auto& [dst, tens_ptr] : graph.getOutEdges(order[i]))
+        {
+            std::ignore = tens_ptr;
+            if(--in_degrees.at(dst) == 0)
+            {
+                order.emplace_back(dst);
+            }
+        }
+    }
+
+    if(order.size() != graph.numNodes() + 2)
+    {
+        // nodes on a cycle never get ordered
+        return {};
+    }
+    return order;
+}
+
+namespace {
+
+/// Labels are refined like in the Weisfeiler-Lehman test, but along the edges of the DAG.
+/// The forward label of a node is made of its name and the forward labels of its producers,
+/// so it describes all paths from the source to the node. The backward label is the same
+/// towards the sink. Labels are computed in a single pass in either direction, and isomorphic
+/// graphs get equal multisets of labels.
+///
+/// Labeler::name(const std::string&) makes the label of a name,
+/// Labeler::combine(Label, std::vector<Label>&&) the label of a node and its neighbors' labels.
+template <typename Labeler>
+auto labelNodes(const OpGraph& graph, Labeler& labeler)
+{
+    using Label = decltype(labeler.name(std::string{}));
+
+    const auto order = topologicalOrder(graph);
+    assert(!order.empty());
+
+    std::unordered_map<const OpNode*, Label> forward;
+    std::unordered_map<const OpNode*, Label> backward;
+    forward.reserve(order.size());
+    backward.reserve(order.size());
+
+    std::vector<Label> neighbors;
+    for(const OpNode* n : order)
+    {
+        neighbors.clear();
+        for(const auto& [src, tens_ptr] : graph.getInEdges(n))
+        {
+            std::ignore = tens_ptr;
+            neighbors.emplace_back(forward.at(src));
+        }
+        forward.emplace(n, labeler.combine(labeler.name(n->signName()), std::move(neighbors)));
+    }
+
+    for(auto it = order.rbegin(); it != order.rend(); ++it)
+    {
+        const OpNode* n = *it;
+        neighbors.clear();
+        for(const auto& [dst, tens_ptr] : graph.getOutEdges(n))
+        {
+            std::ignore = tens_ptr;
+            neighbors.emplace_back(backward.at(dst));
+        }
+        backward.emplace(n, labeler.combine(labeler.name(n->signName()), std::move(neighbors)));
+    }
+
+    std::unordered_map<const OpNode*, Label> labels;
+    labels.reserve(order.size());
+    for(const OpNode* n : order)
+    {
+        labels.emplace(n, labeler.combine(forward.at(n), {backward.at(n)}));
+    }
+    return std::make_pair(order, labels);
+}
+
+/// Sorted labels of the nodes and of the edges, as (producer label, consumer label).
+template <typename Labeler>
+auto canonicalForm(const OpGraph& graph, Labeler& labeler)
+{
+    auto [order, labels] = labelNodes(graph, labeler);
+    using Label          = typename decltype(labels)::mapped_type;
+
+    std::vector<Label> node_labels;
+    std::vector<std::pair<Label, Label>> edge_labels;
+    node_labels.reserve(order.size());
+    for(const OpNode* n : order)
+    {
+        node_labels.emplace_back(labels.at(n));
+        for(const auto& [dst, tens_ptr] : graph.getOutEdges(n))
+        {
+            std::ignore = tens_ptr;
+            edge_labels.emplace_back(labels.at(n), labels.at(dst));
+        }
+    }
+
+    std::sort(node_labels.begin(), node_labels.end());
+    std::sort(edge_labels.begin(), edge_labels.end());
+    return std::make_pair(std::move(node_labels), std::move(edge_labels));
+}
+
+/// Labels are ids of distinct (label, neighbor labels) pairs. A labeler shared by two graphs
+/// gives them equal labels if and only if the labeled structures are equal.
+class InterningLabeler
+{
+    std::map<std::string, size_t> mNames;
+    std::map<std::pair<size_t, std::vector<size_t>>, size_t> mCombined;
+    size_t mNext = 0;
+
+public:
+    size_t name(const std::string& name) { return intern(mNames, name); }
+
+    size_t combine(size_t own, std::vector<size_t>&& neighbors)
+    {
+        std::sort(neighbors.begin(), neighbors.end());
+        return intern(mCombined, std::make_pair(own, std::move(neighbors)));
+    }
+
+private:
+    template <typename Map, typename Key>
+    size_t intern(Map& map, Key&& key)
+    {
+        auto [it, inserted] = map.try_emplace(std::forward<Key>(key), mNext);
+        if(inserted)
+        {
+            ++mNext;
+        }
+        return it->second;
+    }
+};
+
+/// Labels are hashes, so labels of unrelated graphs can be compared. Equal hashes do not prove
+/// equal structures, but different ones prove different structures.
+struct HashingLabeler
+{
+    static size_t name(const std::string& name) { return std::hash<std::string>{}(name); }
+
+    static size_t combine(size_t own, std::vector<size_t>&& neighbors)
+    {
+        std::sort(neighbors.begin(), neighbors.end());
+        auto h = own;
+        for(size_t value : neighbors)
+        {
+            h ^= value + 0x9e3779b9 + (h << 6) + (h >> 2);
+        }
+        // mix the number of neighbors in, so that a zero label is not a no-op
+        return h ^ (neighbors.size() * 0x9e3779b97f4a7c15ULL);
+    }
+};
+
+} // namespace
+
+bool checkSameLabels(const OpGraph& left, const OpGraph& right)
+{
+    InterningLabeler labeler;
+    return canonicalForm(left, labeler) == canonicalForm(right, labeler);
+}
+
+size_t canonicalHash(const OpGraph& graph)
+{
+    HashingLabeler labeler;
+    auto [node_labels, edge_labels] = canonicalForm(graph, labeler);
+
+    std::vector<size_t> all_labels = std::move(node_labels);
+    for(const auto& [src, dst] : edge_labels)
+    {
+        all_labels.emplace_back(HashingLabeler::combine(src, {dst}));
+    }
+    return HashingLabeler::combine(0, std::move(all_labels));
+}
+
+} // end namespace internal
+
 OpGraph OpGraphBuilder::build() &&
 {
     if(mNodes.empty())
@@ -99,6 +303,11 @@ OpGraph OpGraphBuilder::build() &&
         }
     }
 
+    if(internal::topologicalOrder(graph).empty())
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Operation graph has a cycle");
+    }
+
     return graph;
 }
 
@@ -119,37 +328,37 @@ void OpGraph::initEngines()
 
 VecOfPaths OpGraph::getAllPaths() const
 {
-    /// \todo does not check for cycles. Use DFS to first check for cycles
-    /// at construction time perhaps. --amberhassaan May, 2024
+    // The graph has no cycles, build() rejects them. The number of paths may still grow
+    // exponentially with the size of the graph, so only the finished paths are copied.
     VecOfPaths all_paths;
 
-    std::deque<Path> paths_to_explore;
-    paths_to_explore.emplace_back(Path{mSrcNode.get()});
+    Path path{mSrcNode.get()};
+    std::vector<size_t> next_edge{0};
 
-    while(!paths_to_explore.empty())
+    while(!path.empty())
     {
-        Path path = paths_to_explore.front();
-        paths_to_explore.pop_front();
-
-        assert(!path.empty());
         const OpNode* last_node = path.back();
         assert(last_node);
-        if(last_node->getOutEdges().empty())
+        const auto& out_edges = last_node->getOutEdges();
+
+        if(out_edges.empty())
         {
             // all paths should terminate at the sink
             assert(last_node == mSinkNode.get());
-            all_paths.emplace_back(std::move(path));
+            all_paths.emplace_back(path);
+        }
+
+        if(next_edge.back() < out_edges.size())
+        {
+            path.emplace_back(out_edges[next_edge.back()++].first);
+            next_edge.emplace_back(0);
         }
         else
         {
-            for(const auto& [dst, tens_ptr] : last_node->getOutEdges())
-            {
-                Path newPath{path};
-                newPath.emplace_back(dst);
-                paths_to_explore.emplace_back(std::move(newPath));
-            }
+            path.pop_back();
+            next_edge.pop_back();
         }
-    } // end while
+    }
 
     return all_paths;
 }
@@ -166,8 +375,6 @@ std::string pathToStr(const Path& path)
 
 namespace internal {
 
-using MapSizeToPathVec = std::unordered_map<size_t, VecOfPaths>;
-
 bool checkSameNodesByName(const OpGraph& left, const OpGraph& right)
 {
     auto l_names = left.getNodeNames();
@@ -193,88 +400,6 @@ bool checkSameDegreeVecs(const OpGraph& left, const OpGraph& right)
     return l_degs == r_degs;
 }
 
-auto groupBySize(VecOfPaths&& all_paths)
-{
-    MapSizeToPathVec paths_by_size;
-
-    for(auto& p : all_paths)
-    {
-        auto [it, _ignore] = paths_by_size.emplace(p.size(), VecOfPaths{});
-        it->second.emplace_back(std::move(p));
-    }
-
-    return paths_by_size;
-}
-
-bool checkSamePathVecs(const VecOfPaths& left, const VecOfPaths& right)
-{
-    if(left.size() != right.size())
-    {
-        return false;
-    }
-
-    using VecOfStr = std::vector<std::string>;
-
-    auto pathvec_to_strvec = [](const VecOfPaths& pathvec) {
-        VecOfStr ret;
-        for(const Path& path : pathvec)
-        {
-            ret.emplace_back(pathToStr(path));
-        }
-        return ret;
-    };
-
-    VecOfStr l_paths_as_str = pathvec_to_strvec(left);
-    VecOfStr r_paths_as_str = pathvec_to_strvec(right);
-
-    std::sort(l_paths_as_str.begin(), l_paths_as_str.end());
-    std::sort(r_paths_as_str.begin(), r_paths_as_str.end());
-
-    return l_paths_as_str == r_paths_as_str;
-}
-
-bool checkSamePaths(const OpGraph& left, const OpGraph& right)
-{
-
-    auto l_paths = left.getAllPaths();
-    auto r_paths = right.getAllPaths();
-
-    if(l_paths.size() != r_paths.size())
-    {
-        return false;
-    }
-
-    auto l_paths_by_sz = groupBySize(std::move(l_paths));
-    auto r_paths_by_sz = groupBySize(std::move(r_paths));
-
-    auto get_keys = [](const MapSizeToPathVec& paths_by_size) {
-        std::vector<size_t> keys{};
-        for(const auto& [k, v] : paths_by_size)
-        {
-            keys.emplace_back(k);
-        }
-        return keys;
-    };
-
-    auto l_keys = get_keys(l_paths_by_sz);
-    auto r_keys = get_keys(r_paths_by_sz);
-
-    if(l_keys != r_keys)
-    {
-        return false;
-    }
-
-    for(size_t k : l_keys)
-    {
-        if(!checkSamePathVecs(l_paths_by_sz[k], r_paths_by_sz[k]))
-        {
-            return false;
-        }
-    }
-
-    return true;
-}
-
 } // end namespace internal
 
 bool isIsomorphic(const OpGraph& left, const OpGraph& right)
@@ -303,15 +428,41 @@ bool isIsomorphic(const OpGraph& left, const OpGraph& right)
         return false;
     }
 
-    if(!internal::checkSamePaths(left, right))
+    if(!internal::checkSameLabels(left, right))
     {
-        MIOPEN_LOG_I2("test failed due to paths being different");
+        MIOPEN_LOG_I2("test failed due to node labels being different");
         return false;
     }
 
     return true;
 }
 
+GraphSignature::GraphSignature(const OpGraph& graph)
+    : mNodeNames(graph.getNodeNames()),
+      mDegrees(graph.getInOutDegrees()),
+      mNumEdges(graph.numEdges()),
+      mCanonicalHash(internal::canonicalHash(graph))
+{
+    std::sort(mNodeNames.begin(), mNodeNames.end());
+    std::sort(mDegrees.begin(), mDegrees.end());
+
+    auto combine = [this](size_t value) {
+        mHash ^= value + 0x9e3779b9 + (mHash << 6) + (mHash >> 2);
+    };
+
+    combine(mNumEdges);
+    combine(mCanonicalHash);
+    for(const auto& name : mNodeNames)
+    {
+        combine(std::hash<std::string>{}(name));
+    }
+    for(const auto& [in, out] : mDegrees)
+    {
+        combine(in);
+        combine(out);
+    }
+}
+
 void BackendOperationGraphDescriptor::setAttribute(miopenBackendAttributeName_t attributeName,
                                                    miopenBackendAttributeType_t attributeType,
                                                    int64_t elementCount,
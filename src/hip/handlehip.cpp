@@ -34,9 +34,14 @@
 #include <miopen/invoker.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/program_cache.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/target_properties.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/trace.hpp>
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
 
 #if !MIOPEN_ENABLE_SQLITE_KERN_CACHE
 #include <miopen/write_file.hpp>
@@ -66,6 +71,7 @@
 #define WORKAROUND_FAULTY_HIPMEMGETINFO_VEGA_NAVI2X (HIP_PACKAGE_VERSION_FLAT >= 5007000000ULL)
 
 MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_DEVICE_CU)
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_SHARED_PROGRAM_CACHE)
 
 namespace miopen {
 
@@ -228,6 +234,7 @@ struct HandleImpl
     }
 
     std::shared_timed_mutex stream_pool_mutex;
+    std::once_flag max_mem_alloc_size_once;
     // the main stream and main rocblas_handle rhandle_
 
 #if MIOPEN_USE_ROCBLAS
@@ -343,7 +350,13 @@ Handle::Handle() : impl(std::make_unique<HandleImpl>())
     MIOPEN_LOG_NQI(*this);
 }
 
-Handle::~Handle() {}
+Handle::~Handle()
+{
+    ProgramCache::Global().Release(this->impl.get());
+#if MIOPEN_ENABLE_SQLITE
+    SQLite::FlushAll();
+#endif
+}
 
 // not MT safe
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
@@ -537,6 +550,24 @@ Program Handle::LoadProgram(const fs::path& program_name,
                             std::string params,
                             const std::string& kernel_src,
                             bool force_attach_binary) const
+{
+    MIOPEN_TRACE_SCOPE("compile", [&]() { return "LoadProgram " + program_name.string(); });
+
+    if(env::disabled(MIOPEN_DEBUG_SHARED_PROGRAM_CACHE))
+        return LoadProgramUncached(
+            program_name, std::move(params), kernel_src, force_attach_binary);
+
+    const auto key = ProgramCache::Key{
+        this->impl->device, program_name, params, kernel_src, force_attach_binary};
+    return ProgramCache::Global().GetOrLoad(key, this->impl.get(), [&]() {
+        return LoadProgramUncached(program_name, params, kernel_src, force_attach_binary);
+    });
+}
+
+Program Handle::LoadProgramUncached(const fs::path& program_name,
+                                    std::string params,
+                                    const std::string& kernel_src,
+                                    bool force_attach_binary) const
 {
     this->impl->set_ctx();
     std::string arch_name = this->GetTargetProperties().Name();
@@ -560,8 +591,21 @@ Program Handle::LoadProgram(const fs::path& program_name,
     }
 #endif
 
-    auto hsaco = miopen::LoadBinary(
-        this->GetTargetProperties(), this->GetMaxComputeUnits(), program_name, params);
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    // Code objects of the kernel pack are loaded in place, the others are read into the buffer.
+    auto buffer     = std::vector<char>{};
+    const auto load = [&](const std::string& args) {
+        return miopen::LoadBinaryView(
+            this->GetTargetProperties(), this->GetMaxComputeUnits(), program_name, args, buffer);
+    };
+#else
+    const auto load = [&](const std::string& args) {
+        return miopen::LoadBinary(
+            this->GetTargetProperties(), this->GetMaxComputeUnits(), program_name, args);
+    };
+#endif
+
+    auto hsaco = load(params);
     if(hsaco.empty())
     {
         const auto arch_target_id = miopen::SplitDelim(arch_name, ':');
@@ -569,10 +613,7 @@ Program Handle::LoadProgram(const fs::path& program_name,
         {
             // The target name has target ID in there, fall back on the generic code object
             const auto base_arch = arch_target_id.at(0);
-            hsaco                = miopen::LoadBinary(this->GetTargetProperties(),
-                                       this->GetMaxComputeUnits(),
-                                       program_name,
-                                       orig_params + " -mcpu=" + base_arch);
+            hsaco                = load(orig_params + " -mcpu=" + base_arch);
         }
     }
 
@@ -580,6 +621,7 @@ Program Handle::LoadProgram(const fs::path& program_name,
     // specific code object
     if(hsaco.empty())
     {
+        MIOPEN_TRACE_SCOPE("compile", [&]() { return "Build " + program_name.string(); });
         CompileTimer ct;
         auto p =
             HIPOCProgram{program_name.string(), params, this->GetTargetProperties(), kernel_src};
@@ -664,6 +706,7 @@ void Handle::AddProgram(Program prog, const fs::path& program_name, const std::s
 void Handle::ClearProgram(const fs::path& program_name, const std::string& params) const
 {
     this->impl->cache.ClearProgram(program_name, params);
+    ProgramCache::Global().Erase(this->impl->device, program_name, params);
 }
 
 void Handle::Finish() const
@@ -757,14 +800,14 @@ std::size_t Handle::GetWavefrontWidth() const
 // for a single object.
 std::size_t Handle::GetMaxMemoryAllocSize()
 {
-    if(m_MaxMemoryAllocSizeCached == 0)
-    {
+    // Called by IsApplicable() of solvers, which may run concurrently.
+    std::call_once(this->impl->max_mem_alloc_size_once, [&]() {
         size_t free, total;
         auto status = hip_mem_get_info_wrapper(&free, &total);
         if(status != hipSuccess)
             MIOPEN_THROW_HIP_STATUS(status, "Failed getting available memory");
         m_MaxMemoryAllocSizeCached = floor(total * 0.85);
-    }
+    });
 
     return m_MaxMemoryAllocSizeCached;
 }
@@ -154,7 +154,7 @@ static hipModulePtr CreateModule(const fs::path& hsaco_file)
     return m;
 }
 
-template <typename T> /// intended for std::string and std::vector<char>
+template <typename T> /// intended for std::string, std::string_view and std::vector<char>
 hipModulePtr CreateModuleInMem(const T& blob)
 {
     hipModule_t raw_m;
@@ -190,6 +190,15 @@ HIPOCProgramImpl::HIPOCProgramImpl(const fs::path& program_name,
     module = CreateModuleInMem(blob);
 }
 
+HIPOCProgramImpl::HIPOCProgramImpl(const fs::path& program_name, std::string_view blob)
+    : program(program_name)
+{
+    const auto& arch = env::value(MIOPEN_DEVICE_ARCH);
+    if(!arch.empty())
+        return;
+    module = CreateModuleInMem(blob);
+}
+
 HIPOCProgramImpl::HIPOCProgramImpl(const fs::path& program_name,
                                    std::string params,
                                    const TargetProperties& target_,
@@ -352,6 +361,11 @@ HIPOCProgram::HIPOCProgram(const fs::path& program_name, const std::vector<uint8
 {
 }
 
+HIPOCProgram::HIPOCProgram(const fs::path& program_name, std::string_view hsaco)
+    : impl(std::make_shared<HIPOCProgramImpl>(program_name, hsaco))
+{
+}
+
 hipModule_t HIPOCProgram::GetModule() const { return impl->module.get(); }
 
 fs::path HIPOCProgram::GetCodeObjectPathname() const
@@ -31,6 +31,8 @@
 #include <miopen/target_properties.hpp>
 #include <miopen/filesystem.hpp>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace miopen {
 
@@ -57,6 +59,15 @@ std::vector<char> LoadBinary(const TargetProperties& target,
                              const fs::path& name,
                              const std::string& args);
 
+/// Like LoadBinary(), but a code object of the system kernel pack is not copied: the view
+/// refers to the mapped pack, which stays mapped until the process exits. Other code objects
+/// are loaded into \p buffer, which the view then refers to.
+MIOPEN_INTERNALS_EXPORT std::string_view LoadBinaryView(const TargetProperties& target,
+                                                        std::size_t num_cu,
+                                                        const fs::path& name,
+                                                        const std::string& args,
+                                                        std::vector<char>& buffer);
+
 void SaveBinary(const std::vector<char>& hsaco,
                 const TargetProperties& target,
                 std::size_t num_cu,
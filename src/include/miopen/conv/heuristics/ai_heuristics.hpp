@@ -41,7 +41,6 @@
 #include <miopen/db_path.hpp>
 #include <miopen/any_solver.hpp>
 #include <miopen/filesystem.hpp>
-#include <miopen/anyramdb.hpp>
 
 namespace miopen {
 namespace ai {
@@ -71,9 +70,17 @@ public:
     size_t EncodeLayout(const std::string& layout) const;
 };
 class Model;
+/// Returns ids of the solvers TunaNet expects to be applicable, the fastest first,
+/// or an empty vector if the problem is not supported by the model.
 MIOPEN_INTERNALS_EXPORT std::vector<uint64_t> PredictSolver(const conv::ProblemDescription& problem,
                                                             const ExecutionContext& ctx,
                                                             const std::string& device);
+/// Same as PredictSolver for each of the problems. Problems which are not in the cache
+/// of recent predictions are evaluated in parallel.
+MIOPEN_INTERNALS_EXPORT std::vector<std::vector<uint64_t>>
+PredictSolvers(const std::vector<conv::ProblemDescription>& problems,
+               const ExecutionContext& ctx,
+               const std::string& device);
 } // namespace immed_mode
 
 #endif // MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
@@ -172,6 +172,23 @@ FindCoreResult FindCore(const AnyInvokeParams& invoke_ctx,
                         const std::optional<FindOptions>& options = std::nullopt,
                         bool force_attach_binary                  = false);
 
+/// One problem of a batched FindCore().
+struct FindCoreTask
+{
+    const AnyInvokeParams& invoke_ctx;
+    const ExecutionContext& ctx;
+    const ProblemDescriptionBase& problem;
+    const PrimitiveFindParameters& parameters;
+};
+
+/// Runs the finders for every task, then compiles the solutions of all tasks in a single wave
+/// before any of them is benchmarked. All tasks must share the same handle.
+std::vector<FindCoreResult>
+FindCore(const std::vector<FindCoreTask>& tasks,
+         const std::vector<std::unique_ptr<ISolversFinder>>& finders,
+         const std::optional<FindOptions>& options = std::nullopt,
+         bool force_attach_binary                  = false);
+
 namespace conv {
 bool IsAlgorithmDisabled(miopenConvAlgorithm_t algo);
 bool IsEnoughWorkspace(std::string_view where,
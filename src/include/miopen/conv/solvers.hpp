@@ -898,6 +898,7 @@ private:
 struct ConvMlirIgemmFwd final : ConvTunableSolver<PerformanceConvMlirIgemm>
 {
     const std::string& SolverDbId() const override { return GetSolverDbId<ConvMlirIgemmFwd>(); }
+    bool IsApplicableThreadSafe() const override { return false; }
 
     MIOPEN_INTERNALS_EXPORT bool
     IsApplicable(const ExecutionContext&, const miopen::conv::ProblemDescription&) const override;
@@ -979,6 +980,7 @@ struct ConvMlirIgemmFwdXdlops final : ConvTunableSolver<PerformanceConvMlirIgemm
     {
         return GetSolverDbId<ConvMlirIgemmFwdXdlops>();
     }
+    bool IsApplicableThreadSafe() const override { return false; }
 
     MIOPEN_INTERNALS_EXPORT bool
     IsApplicable(const ExecutionContext&, const miopen::conv::ProblemDescription&) const override;
@@ -1031,6 +1033,7 @@ private:
 struct ConvMlirIgemmWrW final : ConvTunableSolver<PerformanceConvMlirIgemm>
 {
     const std::string& SolverDbId() const override { return GetSolverDbId<ConvMlirIgemmWrW>(); }
+    bool IsApplicableThreadSafe() const override { return false; }
 
     MIOPEN_INTERNALS_EXPORT bool
     IsApplicable(const ExecutionContext&, const miopen::conv::ProblemDescription&) const override;
@@ -1056,6 +1059,7 @@ struct ConvMlirIgemmWrWXdlops final : ConvTunableSolver<PerformanceConvMlirIgemm
     {
         return GetSolverDbId<ConvMlirIgemmWrWXdlops>();
     }
+    bool IsApplicableThreadSafe() const override { return false; }
 
     MIOPEN_INTERNALS_EXPORT bool
     IsApplicable(const ExecutionContext&, const miopen::conv::ProblemDescription&) const override;
@@ -1469,6 +1473,7 @@ private:
 struct ConvMlirIgemmBwd final : ConvTunableSolver<PerformanceConvMlirIgemm>
 {
     const std::string& SolverDbId() const override { return GetSolverDbId<ConvMlirIgemmBwd>(); }
+    bool IsApplicableThreadSafe() const override { return false; }
 
     MIOPEN_INTERNALS_EXPORT bool
     IsApplicable(const ExecutionContext&, const miopen::conv::ProblemDescription&) const override;
@@ -1494,6 +1499,7 @@ struct ConvMlirIgemmBwdXdlops final : ConvTunableSolver<PerformanceConvMlirIgemm
     {
         return GetSolverDbId<ConvMlirIgemmBwdXdlops>();
     }
+    bool IsApplicableThreadSafe() const override { return false; }
 
     MIOPEN_INTERNALS_EXPORT bool
     IsApplicable(const ExecutionContext&, const miopen::conv::ProblemDescription&) const override;
@@ -151,6 +151,20 @@ std::vector<Solution> FindConvolution(const ExecutionContext& ctx,
                                       int requestAlgoCount,
                                       bool force_attach_binary);
 
+/// One problem of a batched FindConvolution().
+struct ConvolutionFindItem
+{
+    const ExecutionContext& ctx;
+    const conv::ProblemDescription& problem;
+    const AnyInvokeParams& invoke_ctx;
+};
+
+/// Finds several convolutions at once. Problems served by the find-db or by the immediate mode are
+/// resolved one by one, the rest are searched together by a single batched FindCore().
+std::vector<std::vector<Solution>> FindConvolution(const std::vector<ConvolutionFindItem>& items,
+                                                   int requestAlgoCount,
+                                                   bool force_attach_binary);
+
 struct MIOPEN_INTERNALS_EXPORT ConvolutionDescriptor : miopenConvolutionDescriptor
 {
     ConvolutionDescriptor(std::size_t spatial_dim,
@@ -29,6 +29,7 @@
 #include <miopen/db_record.hpp>
 #include <miopen/rank.hpp>
 #include <miopen/filesystem.hpp>
+#include <miopen/trace.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
 #include <boost/none.hpp>
@@ -36,6 +37,7 @@
 
 #include <chrono>
 #include <string>
+#include <vector>
 
 namespace miopen {
 
@@ -71,6 +73,11 @@ public:
     /// Returns true if store was successful, false otherwise.
     bool StoreRecord(const DbRecord& record);
 
+    /// Stores provided records in database under a single lock, as StoreRecord() does for each.
+    ///
+    /// Returns true if all stores were successful, false otherwise.
+    bool StoreRecords(const std::vector<DbRecord>& records);
+
     /// Stores provided record in database. If record with same key is already in database it is
     /// updated with values from provided record. Provided records data is also updated via
     /// DbRecord::Merge().
@@ -227,6 +234,12 @@ public:
         return _user.StoreRecord(args...);
     }
 
+    template <typename... U>
+    auto StoreRecords(const U&... args)
+    {
+        return _user.StoreRecords(args...);
+    }
+
     template <typename... U>
     auto UpdateRecord(U&... args)
     {
@@ -307,6 +320,12 @@ public:
         return Measure("StoreRecord", [&]() { return inner.StoreRecord(record...); });
     }
 
+    template <typename... U>
+    auto StoreRecords(const U&... records)
+    {
+        return Measure("StoreRecords", [&]() { return inner.StoreRecords(records...); });
+    }
+
     template <typename... U>
     auto UpdateRecord(U&... args)
     {
@@ -337,12 +356,35 @@ public:
         return Measure("Remove", [&]() { return inner.Remove(args...); });
     }
 
+    template <typename... U>
+    auto FetchRecord(const U&... args)
+    {
+        return Measure("FetchRecord", [&]() { return inner.FetchRecord(args...); });
+    }
+
+    template <typename... U>
+    auto DecodeRecord(U&&... args) const
+    {
+        return Measure("DecodeRecord",
+                       [&]() { return inner.DecodeRecord(std::forward<U>(args)...); });
+    }
+
+    template <typename... U>
+    auto BuildIndex(const U&... args)
+    {
+        return Measure("BuildIndex", [&]() { return inner.BuildIndex(args...); });
+    }
+
+    void ShareIndex(const DbTimer& other) { inner.ShareIndex(other.inner); }
+
 private:
     TInnerDb inner;
 
     template <class TFunc>
     static auto Measure(const std::string& funcName, TFunc&& func)
     {
+        MIOPEN_TRACE_SCOPE("db", [&]() { return "Db::" + funcName; });
+
         if(!miopen::IsLogging(LoggingLevel::Info2))
             return func();
 
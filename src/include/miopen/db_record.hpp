@@ -33,6 +33,7 @@
 #include <istream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace miopen {
@@ -205,11 +206,8 @@ private:
 
     DbRecord(const std::string& key_) : key(key_) {}
 
-    bool ParseContents(const std::string& contents)
-    {
-        auto ss = std::istringstream(contents);
-        return ParseContents(ss);
-    }
+    /// Splits the contents in place, only ids and values stored in the record are copied.
+    bool ParseContents(std::string_view contents);
 
 public:
     DbRecord() : key(""){};
@@ -107,6 +107,10 @@ public:
 
 MIOPEN_INTERNALS_EXPORT boost::optional<std::vector<solver::Id>> GetEnvFindOnlySolver();
 
+/// Host-side work of Find (applicability checks, finders) runs on the thread pool
+/// unless MIOPEN_DEBUG_PARALLEL_FIND is set to 0.
+MIOPEN_INTERNALS_EXPORT bool IsParallelFindEnabled();
+
 class MIOPEN_INTERNALS_EXPORT FindMode
 {
 public:
@@ -147,16 +147,18 @@ public:
     bool empty() const { return !content.is_initialized(); }
 
     template <class TProblemDescription>
-    static std::vector<Solution> TryLoad(Handle& handle,
-                                         const TProblemDescription& problem,
-                                         const std::function<FindCoreResult()>& regenerator,
-                                         const std::string& path_suffix = "")
+    static std::vector<Solution>
+    TryLoad(Handle& handle,
+            const TProblemDescription& problem,
+            const std::function<FindCoreResult()>& regenerator,
+            const std::string& path_suffix                         = "",
+            const std::function<bool(const std::string&)>& prepare = {})
     {
         FindDbRecord_t<TDb> record{handle, problem, path_suffix};
 
         const auto network_config = problem.MakeNetworkConfig();
 
-        if(record.in_sync && !record.Validate(handle, network_config))
+        if(record.in_sync && !record.Validate(handle, network_config, prepare))
         {
             auto solutions = std::vector<Solution>{};
             record.CopyTo(solutions);
@@ -184,6 +186,83 @@ public:
         return result.solutions;
     }
 
+    /// Batched TryLoad(). The regenerator is called once with the indices of all problems
+    /// missing from the find-db and returns their results in the same order. The new records
+    /// are written to the find-db with a single store at the end.
+    template <class TProblemDescription>
+    static std::vector<std::vector<Solution>> TryLoadBatch(
+        Handle& handle,
+        const std::vector<TProblemDescription>& problems,
+        const std::function<std::vector<FindCoreResult>(const std::vector<std::size_t>&)>&
+            regenerator,
+        const std::string& path_suffix                                      = "",
+        const std::function<bool(std::size_t, const std::string&)>& prepare = {})
+    {
+        auto results = std::vector<std::vector<Solution>>(problems.size());
+        auto missing = std::vector<std::size_t>{};
+
+        if(problems.empty())
+            return results;
+
+        for(std::size_t i = 0; i < problems.size(); ++i)
+        {
+            FindDbRecord_t<TDb> record{handle, problems[i], path_suffix};
+            record.dont_store = true;
+
+            const auto prepare_one =
+                prepare ? [&](const std::string& solver_id) { return prepare(i, solver_id); }
+                        : std::function<bool(const std::string&)>{};
+
+            if(record.in_sync &&
+               !record.Validate(handle, problems[i].MakeNetworkConfig(), prepare_one))
+                record.CopyTo(results[i]);
+            else
+                missing.push_back(i);
+        }
+
+        if(missing.empty())
+            return results;
+
+        MIOPEN_LOG_I("Find-db regenerating " << missing.size() << " of " << problems.size()
+                                             << " record(s).");
+
+        auto regenerated = regenerator(missing);
+        if(regenerated.size() != missing.size())
+            MIOPEN_THROW(miopenStatusInternalError, "Find-db regenerator result count mismatch.");
+
+        auto records = std::vector<DbRecord>{};
+
+        for(std::size_t i = 0; i < missing.size(); ++i)
+        {
+            const auto& problem = problems[missing[i]];
+            auto& result        = regenerated[i];
+
+            if(result.is_optimal)
+            {
+                auto& record = records.emplace_back(DbKinds::FindDb, problem);
+                for(const auto& solution : result.solutions)
+                {
+                    const auto algo = solution.GetSolver().GetAlgo(problem.GetDirection());
+                    record.SetValues(
+                        solution.GetSolver().ToString(),
+                        FindDbData{solution.GetTime(), solution.GetWorkspaceSize(), algo});
+                }
+            }
+
+            results[missing[i]] = std::move(result.solutions);
+        }
+
+        if(records.empty())
+            return results;
+
+        FindDbRecord_t<TDb> store{handle, problems[missing.front()], path_suffix};
+        store.dont_store = true;
+        if(store.db.is_initialized() && !store.db->StoreRecords(records))
+            MIOPEN_LOG_E("Failed to store records to find-db at <" << store.path << ">");
+
+        return results;
+    }
+
 private:
     fs::path path;
     fs::path installed_path;
@@ -198,7 +277,9 @@ private:
     static fs::path GetUserPath(Handle& handle, const std::string& path_suffix);
 
     // Returns true if rebuild is required
-    bool Validate(Handle& handle, const NetworkConfig& config) const;
+    bool Validate(Handle& handle,
+                  const NetworkConfig& config,
+                  const std::function<bool(const std::string&)>& prepare) const;
     void CopyTo(std::vector<Solution>& to) const;
 
     void LogFindDbItem(const std::pair<std::string, FindDbData>& item) const;
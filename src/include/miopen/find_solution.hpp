@@ -35,13 +35,17 @@
 #include <miopen/find_controls.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/mlo_internal.hpp>
+#include <miopen/par_for.hpp>
 #include <miopen/search_options.hpp>
 #include <miopen/solver_id.hpp>
 #include <miopen/solver.hpp>
 
+#include <algorithm>
+#include <functional>
 #include <limits>
 #include <type_traits>
 #include <optional>
+#include <thread>
 #include <vector>
 
 namespace miopen {
@@ -281,29 +285,13 @@ struct SolverContainer
                           const std::optional<FindOptions>& options = std::nullopt) const
     {
         std::vector<Solution> ss;
-        std::size_t count    = 0;
-        const auto find_only = GetEnvFindOnlySolver();
+        std::size_t count = 0;
+        auto finds        = std::vector<std::function<void()>>{};
+        finds.reserve(sizeof...(Solvers));
+
         miopen::each_args(
             [&](auto solver) {
-                if(count >= limit)
-                    return;
-                if(find_only &&
-                   (std::find(find_only->begin(), find_only->end(), Id{solver.SolverDbId()}) ==
-                    find_only->end()))
-                { // Do nothing (and keep silence for the sake of Tuna), just skip.
-                }
-                // For better performance, check IsDynamic() first, because
-                // it is much faster than IsApplicable().
-                else if(ctx.use_dynamic_solutions_only && !solver.IsDynamic())
-                {
-                    MIOPEN_LOG_I2(solver.SolverDbId() << ": Skipped (non-dynamic)");
-                }
-                else if(!solver.IsApplicable(ctx, problem))
-                {
-                    MIOPEN_LOG_I2(solver.SolverDbId() << ": Not applicable");
-                }
-                else
-                {
+                finds.emplace_back([&, solver]() {
                     const Solution s =
                         FindSolution(solver, ctx, problem, db, invoke_ctx, "", options);
                     if(s.Succeeded())
@@ -322,12 +310,39 @@ struct SolverContainer
                         MIOPEN_LOG_I(solver.SolverDbId()
                                      << ": [Warning] Applicable Solver not succeeded.");
                     }
-                }
+                });
             },
             Solvers{}...);
+
+        // With a limit, solvers are checked a chunk at a time, so the ones after the limit is
+        // reached are not checked at all. Solutions are made in order, as they may use the db and
+        // the device.
+        const auto checks = GetApplicabilityChecks(ctx, problem);
+        const auto chunk  = limit < checks.size()
+                                ? std::max<std::size_t>(std::thread::hardware_concurrency(), 1)
+                                : checks.size();
+        for(std::size_t begin = 0; begin < checks.size() && count < limit; begin += chunk)
+        {
+            const auto end        = std::min(begin + chunk, checks.size());
+            const auto applicable = RunApplicabilityChecks(checks, begin, end);
+            for(auto i = begin; i < end && count < limit; ++i)
+            {
+                if(applicable[i - begin])
+                    finds[i]();
+            }
+        }
         return ss;
     }
 
+    /// Checks which solvers are applicable to the problem, concurrently.
+    /// The result is indexed in the order of Solvers.
+    template <class Context, class Problem>
+    std::vector<char> CheckApplicability(const Context& ctx, const Problem& problem) const
+    {
+        const auto checks = GetApplicabilityChecks(ctx, problem);
+        return RunApplicabilityChecks(checks, 0, checks.size());
+    }
+
     // Search for all applicable solutions among many solvers
     template <class Problem, class Solution = miopen::solver::ConvSolution>
     std::vector<Solution>
@@ -510,6 +525,75 @@ struct SolverContainer
     {
         return ExecutePrimitive(&handle, problem, algo, invoke_params);
     }
+
+private:
+    struct ApplicabilityCheck
+    {
+        std::function<bool()> check;
+        /// See SolverBase::IsApplicableThreadSafe().
+        bool thread_safe;
+    };
+
+    template <class Context, class Problem>
+    std::vector<ApplicabilityCheck> GetApplicabilityChecks(const Context& ctx,
+                                                           const Problem& problem) const
+    {
+        const auto find_only = GetEnvFindOnlySolver();
+        auto checks          = std::vector<ApplicabilityCheck>{};
+        checks.reserve(sizeof...(Solvers));
+
+        miopen::each_args(
+            [&](auto solver) {
+                auto check = [&ctx, &problem, find_only, solver]() {
+                    if(find_only &&
+                       (std::find(find_only->begin(), find_only->end(), Id{solver.SolverDbId()}) ==
+                        find_only->end()))
+                    { // Do nothing (and keep silence for the sake of Tuna), just skip.
+                        return false;
+                    }
+                    // For better performance, check IsDynamic() first, because
+                    // it is much faster than IsApplicable().
+                    if(ctx.use_dynamic_solutions_only && !solver.IsDynamic())
+                    {
+                        MIOPEN_LOG_I2(solver.SolverDbId() << ": Skipped (non-dynamic)");
+                        return false;
+                    }
+                    if(!solver.IsApplicable(ctx, problem))
+                    {
+                        MIOPEN_LOG_I2(solver.SolverDbId() << ": Not applicable");
+                        return false;
+                    }
+                    return true;
+                };
+                checks.push_back({std::move(check), solver.IsApplicableThreadSafe()});
+            },
+            Solvers{}...);
+        return checks;
+    }
+
+    /// Runs checks [begin, end). Checks which are not thread safe run on the calling thread.
+    static std::vector<char> RunApplicabilityChecks(const std::vector<ApplicabilityCheck>& checks,
+                                                    std::size_t begin,
+                                                    std::size_t end)
+    {
+        // Not vector<bool>, because its elements may not be written concurrently.
+        auto applicable     = std::vector<char>(end - begin);
+        const auto run      = [&](auto i) { applicable[i] = checks[begin + i].check() ? 1 : 0; };
+        const auto parallel = IsParallelFindEnabled();
+        if(parallel)
+        {
+            par_for(applicable.size(), min_grain{1}, [&](auto i) {
+                if(checks[begin + i].thread_safe)
+                    run(i);
+            });
+        }
+        for(std::size_t i = 0; i < applicable.size(); ++i)
+        {
+            if(!parallel || !checks[begin + i].thread_safe)
+                run(i);
+        }
+        return applicable;
+    }
 };
 
 } // namespace solver
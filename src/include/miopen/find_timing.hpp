@@ -0,0 +1,82 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_FIND_TIMING_HPP_
+#define GUARD_MIOPEN_FIND_TIMING_HPP_
+
+#include <miopen/miopen.h>
+#include <miopen/config.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace miopen {
+
+/// Decides how many times a candidate solution is run during Find and what its time is.
+///
+/// Fixed policy: up to 8 runs, the first 3 are warm-up and are not counted, the estimate is
+/// the mean of the rest.
+///
+/// Adaptive policy: the first run is warm-up, the estimate is the median of the rest.
+/// A candidate is abandoned as soon as even its fastest run is clearly slower than the best
+/// known time. Otherwise it is run at least 3 times and then until the confidence interval
+/// of the median no longer includes the best time, or the spread becomes negligible.
+///
+/// Both policies stop after ~5 seconds of accumulated kernel time.
+class MIOPEN_INTERNALS_EXPORT InvokerTiming
+{
+public:
+    /// best is the time of the fastest candidate timed so far, if any.
+    InvokerTiming(miopenFindTimingPolicy_t policy_,
+                  float best_ = std::numeric_limits<float>::max());
+
+    /// Records the time of a run. Returns true if the candidate should be run again.
+    bool Add(float time);
+
+    /// Time to report for the candidate. Requires at least one run.
+    float Estimate() const;
+    /// Robust standard deviation estimate (scaled median absolute deviation) of counted runs.
+    float Spread() const;
+    std::size_t Runs() const { return samples.size(); }
+    bool IsAbandoned() const { return abandoned; }
+    miopenFindTimingPolicy_t GetPolicy() const { return policy; }
+
+    /// Resolves miopenFindTimingPolicyDefault using MIOPEN_FIND_TIMING_POLICY.
+    static miopenFindTimingPolicy_t Resolve(miopenFindTimingPolicy_t policy);
+
+private:
+    miopenFindTimingPolicy_t policy;
+    float best;
+    float total    = 0;
+    bool abandoned = false;
+    std::vector<float> samples;
+
+    std::size_t Discarded() const;
+    bool NeedsMoreAdaptive();
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_FIND_TIMING_HPP_
@@ -36,11 +36,14 @@
 #include <miopen/invoke_params.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/trace.hpp>
 #include <miopen/type_traits.hpp>
 #include <miopen/mt_queue.hpp>
+#include <miopen/par_for.hpp>
 #include <miopen/generic_search_controls.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <vector>
 #include <cstdlib>
 #include <limits>
@@ -48,6 +51,7 @@
 #include <chrono>
 #include <cassert>
 #include <random>
+#include <string>
 
 namespace miopen {
 namespace solver {
@@ -318,22 +322,45 @@ std::size_t GetTuningIterationsMax();
 std::chrono::milliseconds GetTuningTimeMax(); // returns the max allowed time in milliseconds
 std::size_t GetTuningThreadsMax();
 
+/// Time spent in the stages of the tuning pipeline, reported at the end of the search.
+struct MIOPEN_INTERNALS_EXPORT TuningStats
+{
+    using Clock = std::chrono::steady_clock;
+
+    /// Summed over the compile agents.
+    std::atomic<Clock::rep> compile{0};
+    std::atomic<std::size_t> n_compiled{0};
+    /// Time the benchmarking thread has been waiting for compiled configs.
+    Clock::duration wait{};
+    Clock::duration benchmark{};
+    std::size_t n_benchmarked = 0;
+    Clock::time_point start = Clock::now();
+
+    void Log(const std::string& solver_id, std::size_t n_configs, std::size_t n_threads) const;
+};
+
+template <typename PerformanceConfig>
+using CompiledConfigQueue = ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution>>;
+
+/// Compiles configs in the order of DATA. Agents share NEXT_CONFIG, so the configs which go
+/// first are compiled (and benchmarked) first regardless of the number of agents.
+/// Stops when the time budget is exhausted or the queue is closed by the consumer.
 template <typename PerformanceConfig, typename Solver, typename Context, typename Problem>
 void CompileAgent(size_t thread_index,
-                  size_t total_threads,
                   const Solver& s,
                   const Context& context,
                   const Problem& problem,
                   std::vector<PerformanceConfig>& data,
-                  ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution, bool>>& comp_queue)
+                  std::atomic<std::size_t>& next_config,
+                  CompiledConfigQueue<PerformanceConfig>& comp_queue,
+                  TuningStats& stats)
 {
-    const auto start_time =
-        std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now());
+    const auto start_time  = std::chrono::time_point_cast<std::chrono::milliseconds>(stats.start);
     const auto data_size   = data.size();
     const auto time_budget = GetTuningTimeMax();
     const auto& profile_h  = context.GetStream();
-    // start the counter
-    for(auto idx = thread_index; idx < data_size; idx += total_threads)
+
+    while(!comp_queue.closed())
     {
         // Check if we are out of time
         const auto current_time = std::chrono::time_point_cast<std::chrono::milliseconds>(
@@ -341,11 +368,15 @@ void CompileAgent(size_t thread_index,
         if(current_time - start_time > time_budget)
         {
             MIOPEN_LOG_I2("Thread: " << thread_index << " Done, exhausted time budget");
-            auto tmp = std::make_tuple<PerformanceConfig, ConvSolution, bool>({}, {}, true);
-            comp_queue.push(std::move(tmp));
-            break;
+            return;
         }
-        auto& current_config          = data.at(idx);
+
+        const auto idx = next_config++;
+        if(idx >= data_size)
+            break;
+
+        const auto compile_start      = TuningStats::Clock::now();
+        auto& current_config          = data[idx];
         ConvSolution current_solution = s.GetSolution(context, problem, current_config);
         for(const auto& kernel : current_solution.construction_params)
         {
@@ -353,9 +384,19 @@ void CompileAgent(size_t thread_index,
                 continue;
             std::ignore = profile_h.LoadProgram(kernel.kernel_file, kernel.comp_options, "");
         }
-        auto tup = std::make_tuple<PerformanceConfig, ConvSolution, bool>(
-            std::move(current_config), std::move(current_solution), false);
-        comp_queue.push(std::move(tup));
+        const auto compile_end = TuningStats::Clock::now();
+        stats.compile += (compile_end - compile_start).count();
+        ++stats.n_compiled;
+        if(IsTracing())
+            trace::Record("tuning", "Compile #" + std::to_string(idx), compile_start, compile_end);
+
+        // Blocks while the benchmarking thread is too far behind.
+        auto item = std::make_tuple(std::move(current_config), std::move(current_solution));
+        if(!comp_queue.push(std::move(item)))
+        {
+            MIOPEN_LOG_I2("Thread: " << thread_index << " Done, search has ended");
+            return;
+        }
     }
     MIOPEN_LOG_I2("Thread: " << thread_index << " Done, completed tuning");
 }
@@ -372,6 +413,8 @@ auto GenericSearch(const Solver s,
           HasMember<RunAndMeasure_t, Solver, Data_t, ConstData_t>{}),
         "RunAndMeasure is obsolete. Solvers should implement auto-tune evaluation in invoker");
 
+    MIOPEN_TRACE_SCOPE("tuning", [&]() { return "GenericSearch " + s.SolverDbId(); });
+
     auto context                  = context_;
     context.is_for_generic_search = true;
 
@@ -396,6 +439,16 @@ auto GenericSearch(const Solver s,
     std::random_device rd{};
     auto rng = std::default_random_engine{rd()};
     std::shuffle(all_configs.begin(), all_configs.end(), rng);
+    // The default config is what the solver's heuristic would pick, so it is likely to be
+    // among the best ones. Tuning it first sets a good reference time early, and configs
+    // slower than the reference aren't measured repeatedly. Solvers have no way to score
+    // the other configs, so they stay in the random order.
+    {
+        const auto default_config = s.GetDefaultPerformanceConfig(context, problem);
+        const auto it = std::find(all_configs.begin(), all_configs.end(), default_config);
+        if(it != all_configs.end())
+            std::rotate(all_configs.begin(), it, std::next(it));
+    }
     std::size_t n_runs_total = std::min(all_configs.size(), GetTuningIterationsMax());
     all_configs.resize(n_runs_total);
     std::size_t patience = env::value(MIOPEN_TUNING_PATIENCE);
@@ -424,28 +477,36 @@ auto GenericSearch(const Solver s,
     HeartBeat<PerformanceConfig> heartbeat;
     heartbeat.Start();
 
-    const auto total_threads = GetTuningThreadsMax();
-
-    ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution, bool>> solution_queue;
-    std::vector<std::thread> compile_agents;
+    const auto total_threads = std::max<std::size_t>(GetTuningThreadsMax(), 1);
+
+    // Compiled configs wait here to be benchmarked. The bound keeps the compile agents from
+    // running far ahead: configs left in the queue at the end of the search are compiled in vain.
+    CompiledConfigQueue<PerformanceConfig> solution_queue{2 * total_threads};
+    TuningStats stats;
+    std::atomic<std::size_t> next_config{0};
+    std::atomic<std::size_t> agents_running{total_threads};
+    std::vector<joinable_thread> compile_agents;
+    // Agents waiting on the full queue must be released before they are joined,
+    // including the case of an exception.
+    struct QueueCloser
+    {
+        CompiledConfigQueue<PerformanceConfig>& queue;
+        ~QueueCloser() { queue.close(); }
+    } const queue_closer{solution_queue};
     compile_agents.reserve(total_threads);
-    for(auto idx = 0; idx < total_threads; ++idx)
+    for(std::size_t idx = 0; idx < total_threads; ++idx)
     {
-        compile_agents.emplace_back(CompileAgent<PerformanceConfig, Solver, Context, Problem>,
-                                    idx,
-                                    total_threads,
-                                    std::cref(s),
-                                    std::cref(context),
-                                    std::cref(problem),
-                                    std::ref(all_configs),
-                                    std::ref(solution_queue));
+        compile_agents.emplace_back([&, idx]() {
+            CompileAgent(idx, s, context, problem, all_configs, next_config, solution_queue, stats);
+            if(--agents_running == 0)
+                solution_queue.close();
+        });
     }
 
     if(!env::enabled(MIOPEN_DEBUG_COMPILE_ONLY))
     {
-        size_t n_current       = 0;
-        size_t last_imprv      = 0;
-        auto threads_remaining = total_threads;
+        size_t n_current  = 0;
+        size_t last_imprv = 0;
         while(true)
         {
             if(n_current >= n_runs_total)
@@ -461,23 +522,19 @@ auto GenericSearch(const Solver s,
 
             last_imprv++;
             MIOPEN_LOG_I2("Waiting for item in queue");
-            const auto kinder     = solution_queue.pop();
-            auto current_config   = std::get<0>(kinder);
-            auto current_solution = std::get<1>(kinder);
-
-            if(std::get<2>(kinder))
+            const auto wait_start = TuningStats::Clock::now();
+            auto kinder           = solution_queue.pop();
+            stats.wait += TuningStats::Clock::now() - wait_start;
+            if(!kinder)
             {
-                threads_remaining--;
-                if(threads_remaining == 0)
-                {
-                    break;
-                }
-                else
-                {
-                    continue;
-                }
+                MIOPEN_LOG_I2("Ending Search, no more compiled configs");
+                break;
             }
 
+            const auto benchmark_start = TuningStats::Clock::now();
+            auto current_config        = std::move(std::get<0>(*kinder));
+            auto current_solution      = std::move(std::get<1>(*kinder));
+
             float elapsed_time = 0.0f;
             int ret            = 0;
             MIOPEN_LOG_I2('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
@@ -584,18 +641,45 @@ auto GenericSearch(const Solver s,
                               n_failed,
                               n_runs_total,
                               current_config);
+            const auto benchmark_end = TuningStats::Clock::now();
+            if(IsTracing())
+                trace::Record("tuning",
+                              "Benchmark #" + std::to_string(n_current),
+                              benchmark_start,
+                              benchmark_end);
             ++n_current;
+            stats.benchmark += benchmark_end - benchmark_start;
+            ++stats.n_benchmarked;
         }
     }
     else
+    {
+        // Nothing to benchmark, let the compile agents populate the kernel cache.
+        while(const auto kinder = solution_queue.pop())
+        {
+            for(const auto& kernelInfo : std::get<1>(*kinder).construction_params)
+                profile_h.ClearProgram(kernelInfo.kernel_file, kernelInfo.comp_options);
+        }
+    }
+
+    // Cancel the compilations which haven't started yet, and release the programs
+    // which have been compiled but won't be benchmarked.
+    solution_queue.close();
+    compile_agents.clear();
+    while(const auto kinder = solution_queue.pop())
+    {
+        for(const auto& kernelInfo : std::get<1>(*kinder).construction_params)
+            profile_h.ClearProgram(kernelInfo.kernel_file, kernelInfo.comp_options);
+    }
+
+    stats.Log(s.SolverDbId(), n_runs_total, total_threads);
+
+    if(env::enabled(MIOPEN_DEBUG_COMPILE_ONLY))
     {
         MIOPEN_THROW(miopenStatusGpuOperationsSkipped,
                      "Running kernels on GPU is disabled. Search skipped");
     }
 
-    for(auto& agent : compile_agents)
-        agent.join();
-
     MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
                           << n_best << ' ' << best_time << ' ' << best_config);
 
@@ -39,13 +39,15 @@ namespace graphapi {
 
 class ConvBiasResAddActivForwardExecutor : public GraphPatternExecutor
 {
-    Tensor* mXTensor;
-    Tensor* mWTensor;
-    Convolution* mConvolution;
+    // Copies rather than pointers into the graph, so the executor can outlive it
+    // when restored from a serialized plan.
+    Tensor mXTensor;
+    Tensor mWTensor;
+    Convolution mConvolution;
     int mGroupCount;
-    Tensor* mZTensor;
-    Tensor* mBiasTensor;
-    Tensor* mYTensor;
+    Tensor mZTensor;
+    Tensor mBiasTensor;
+    Tensor mYTensor;
     float mAlpha1;
     float mAlpha2;
     float mActivationAlpha;
@@ -62,13 +64,13 @@ public:
                                        float alpha2,
                                        float activationAlpha)
         : GraphPatternExecutor(),
-          mXTensor(xTensor),
-          mWTensor(wTensor),
-          mConvolution(convolution),
+          mXTensor(*xTensor),
+          mWTensor(*wTensor),
+          mConvolution(*convolution),
           mGroupCount(groupCount),
-          mZTensor(zTensor),
-          mBiasTensor(biasTensor),
-          mYTensor(yTensor),
+          mZTensor(*zTensor),
+          mBiasTensor(*biasTensor),
+          mYTensor(*yTensor),
           mAlpha1(alpha1),
           mAlpha2(alpha2),
           mActivationAlpha(activationAlpha)
@@ -79,6 +81,8 @@ public:
 
     size_t getWorkspaceSize() const final { return size_t{0}; }
 
+    void toJson(nlohmann::json& json) const final;
+
     static std::unique_ptr<GraphPatternExecutor> make(Tensor* xTensor,
                                                       Tensor* wTensor,
                                                       Convolution* convolution,
@@ -102,6 +106,9 @@ public:
                                                                          activationAlpha);
         return std::unique_ptr<GraphPatternExecutor>(p);
     }
+
+    static constexpr const char* Kind = "conv_bias_res_add_activ_fwd";
+    static std::unique_ptr<GraphPatternExecutor> fromJson(const nlohmann::json& json);
 };
 
 } // namespace graphapi
@@ -31,6 +31,8 @@
 #include <miopen/graphapi/variant_pack.hpp>
 #include <miopen/solution.hpp>
 
+#include <nlohmann/json_fwd.hpp>
+
 #include <memory>
 #include <string_view>
 
@@ -49,6 +51,8 @@ public:
     virtual bool matches(const OpGraph* graph) const             = 0;
     virtual std::vector<Engine> getEngines(OpGraph* graph) const = 0;
     virtual std::string_view name() const                        = 0;
+    /// The graph matched by the pattern, used to index the pattern by its signature.
+    virtual const OpGraph& patternGraph() const = 0;
 
     virtual ~GraphPatternMatcher();
 };
@@ -66,6 +70,13 @@ struct TensorInfo
         assert(mEnumId != miopenTensorArgumentIdInvalid);
     }
 
+    /// Used by executors restored from a serialized plan, which have no graph tensors
+    /// and need only the argument id to run.
+    explicit TensorInfo(miopenTensorArgumentId_t enum_id) : mEnumId(enum_id)
+    {
+        assert(mEnumId != miopenTensorArgumentIdInvalid);
+    }
+
     void setDevBuf(Data_t ptr)
     {
         assert(ptr);
@@ -83,6 +94,11 @@ public:
     virtual void execute(miopenHandle_t handle, const VariantPack& vpk) = 0;
     virtual size_t getWorkspaceSize() const                             = 0;
     virtual ~GraphPatternExecutor();
+
+    /// Writes everything needed to run the executor without the graph it was made for.
+    /// The "kind" field selects the executor in fromJson.
+    virtual void toJson(nlohmann::json& json) const;
+    static std::shared_ptr<GraphPatternExecutor> fromJson(const nlohmann::json& json);
 };
 
 // generic executor that uses Find 2.0 Solution
@@ -90,6 +106,8 @@ class GraphExecutorFind20 : public GraphPatternExecutor
 {
     miopenSolution_t mSolution;
     std::shared_ptr<TensorInfoMap> mTensorInfoMap;
+    /// Set only when the executor owns the solution, like the ones restored from json.
+    std::shared_ptr<Solution> mOwnedSolution;
 
 public:
     GraphExecutorFind20(miopenSolution_t sol, const std::shared_ptr<TensorInfoMap>& tmap)
@@ -97,16 +115,29 @@ public:
     {
     }
 
+    GraphExecutorFind20(std::shared_ptr<Solution> sol, const std::shared_ptr<TensorInfoMap>& tmap)
+        : GraphPatternExecutor(),
+          mSolution(sol.get()),
+          mTensorInfoMap(tmap),
+          mOwnedSolution(std::move(sol))
+    {
+    }
+
     void execute(miopenHandle_t handle, const VariantPack& vpk) final;
 
     size_t getWorkspaceSize() const final;
 
+    void toJson(nlohmann::json& json) const final;
+
     static std::unique_ptr<GraphPatternExecutor> make(miopenSolution_t sol,
                                                       const std::shared_ptr<TensorInfoMap>& tmap)
     {
         GraphPatternExecutor* p = new GraphExecutorFind20(sol, tmap);
         return std::unique_ptr<GraphPatternExecutor>(p);
     }
+
+    static constexpr const char* Kind = "find20";
+    static std::unique_ptr<GraphPatternExecutor> fromJson(const nlohmann::json& json);
 };
 
 class Engine
@@ -132,8 +163,12 @@ public:
     int64_t getGlobalIndex() const noexcept { return mGlobalIndex; }
     int32_t getSmCount() const noexcept { return mSmCount; }
 
+    /// Is nullptr for engines restored from a serialized plan.
     const OpGraph* getOpGraph() const { return mGraph; }
     OpGraph* getOpGraph() { return mGraph; }
+
+    friend void to_json(nlohmann::json& json, const Engine& engine);
+    friend void from_json(const nlohmann::json& json, Engine& engine);
 };
 
 class MIOPEN_INTERNALS_EXPORT EngineBuilder
@@ -61,6 +61,8 @@ public:
     const EngineCfg& getEngineCfg() const noexcept { return mEngineCfg; }
     EngineCfg& getEngineCfg() noexcept { return mEngineCfg; }
     const std::vector<int64_t>& getIntermediateIds() const noexcept { return mIntermediateIds; }
+    /// Serializes the engine, including the compiled solution it runs, and the intermediate
+    /// ids. The handle is not a part of the representation.
     std::string getJsonRepresentation() const;
 
     void execute(miopenHandle_t handle, const VariantPack& variantPack)
@@ -87,6 +89,8 @@ public:
     ExecutionPlanBuilder& setEngineCfg(EngineCfg&& engineCfg) &;
     ExecutionPlanBuilder& setIntermediateIds(const std::vector<int64_t>& ids) &;
     ExecutionPlanBuilder& setIntermediateIds(std::vector<int64_t>&& ids) &;
+    /// Restores the engine config and intermediate ids saved by getJsonRepresentation
+    /// without searching for engines again. The engine of such a plan has no op graph.
     ExecutionPlanBuilder& setJsonRepresentation(const std::string_view& s) &;
 
     ExecutionPlanBuilder&& setHandle(miopenHandle_t handle) &&
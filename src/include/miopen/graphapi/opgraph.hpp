@@ -433,6 +433,33 @@ public:
 
 MIOPEN_INTERNALS_EXPORT bool isIsomorphic(const OpGraph& left, const OpGraph& right);
 
+/// Invariant of a graph under isomorphism which is cheap to compute and compare: the multiset
+/// of node names, the multiset of node (in, out) degrees, the number of edges and a hash of the
+/// canonical labeling used by isIsomorphic. Isomorphic graphs have equal signatures, graphs with
+/// different ones are never isomorphic.
+class MIOPEN_INTERNALS_EXPORT GraphSignature
+{
+    std::vector<std::string> mNodeNames;
+    std::vector<std::pair<size_t, size_t>> mDegrees;
+    size_t mNumEdges      = 0;
+    size_t mCanonicalHash = 0;
+    size_t mHash          = 0;
+
+public:
+    explicit GraphSignature(const OpGraph& graph);
+
+    size_t hash() const noexcept { return mHash; }
+
+    bool operator==(const GraphSignature& other) const
+    {
+        return mHash == other.mHash && mCanonicalHash == other.mCanonicalHash &&
+               mNumEdges == other.mNumEdges && mDegrees == other.mDegrees &&
+               mNodeNames == other.mNodeNames;
+    }
+
+    bool operator!=(const GraphSignature& other) const { return !(*this == other); }
+};
+
 MIOPEN_INTERNALS_EXPORT std::string pathToStr(const Path& path);
 
 class MIOPEN_INTERNALS_EXPORT BackendOperationGraphDescriptor : public BackendDescriptor
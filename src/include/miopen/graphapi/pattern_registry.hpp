@@ -0,0 +1,71 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/graphapi/engine.hpp>
+#include <miopen/graphapi/opgraph.hpp>
+
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+namespace graphapi {
+
+/// Pattern matchers indexed by the signatures of their pattern graphs, so that a graph is only
+/// checked against the patterns which can match it.
+class MIOPEN_INTERNALS_EXPORT GraphPatternRegistry
+{
+    std::vector<std::unique_ptr<GraphPatternMatcher>> mPatterns;
+    // key = signature hash, value = index in mPatterns
+    std::unordered_multimap<size_t, size_t> mIndex;
+    std::vector<GraphSignature> mSignatures;
+    // (number of nodes, number of edges) of the patterns, to reject most graphs before
+    // computing their signatures
+    std::set<std::pair<size_t, size_t>> mSizes;
+
+public:
+    /// Registry of all patterns supported by the library. The matchers are created once.
+    static const GraphPatternRegistry& global();
+
+    void add(std::unique_ptr<GraphPatternMatcher> pattern);
+
+    /// Patterns which may match a graph with the given signature, in the order of registration.
+    std::vector<const GraphPatternMatcher*> getCandidates(const GraphSignature& signature) const;
+
+    /// First pattern, in the order of registration, which matches the graph.
+    const GraphPatternMatcher* findMatch(const OpGraph& graph) const;
+
+    const std::vector<std::unique_ptr<GraphPatternMatcher>>& getPatterns() const noexcept
+    {
+        return mPatterns;
+    }
+};
+
+} // end namespace graphapi
+} // end namespace miopen
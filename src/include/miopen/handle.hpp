@@ -304,6 +304,12 @@ private:
 #if MIOPEN_USE_HIPBLASLT
     hipblasLt_handle_ptr CreateHipblasLtHandle() const;
 #endif
+#if MIOPEN_BACKEND_HIP
+    Program LoadProgramUncached(const fs::path& program_name,
+                                std::string params,
+                                const std::string& kernel_src,
+                                bool force_attach_binary) const;
+#endif
 
     InvokerCache invokers;
 };
@@ -32,6 +32,7 @@
 #include <miopen/filesystem.hpp>
 #include <hip/hip_runtime_api.h>
 #include <string>
+#include <string_view>
 
 namespace miopen {
 
@@ -52,6 +53,8 @@ struct HIPOCProgram
     HIPOCProgram(const fs::path& program_name, const fs::path& hsaco);
     HIPOCProgram(const fs::path& program_name, const std::vector<char>& hsaco);
     HIPOCProgram(const fs::path& program_name, const std::vector<uint8_t>& hsaco);
+    /// The code object is only used while the module is loaded, e.g. it may be mapped.
+    HIPOCProgram(const fs::path& program_name, std::string_view hsaco);
     std::shared_ptr<HIPOCProgramImpl> impl;
     hipModule_t GetModule() const;
     /// \return Pathname of CO file, if it resides on the filesystem.
@@ -38,12 +38,30 @@
 #include <boost/none.hpp>
 #include <boost/optional/optional.hpp>
 
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <chrono>
 #include <thread>
 
 namespace miopen {
+
+/// Compression of the code objects in the kernel cache. The codec of each record is stored
+/// with it, so records written with different codecs are read back alike.
+enum class KernDbCodec : int64_t
+{
+    None  = 0,
+    BZip2 = 1, ///< All the records of the databases created without the `codec` column.
+    Zstd  = 2, ///< Fast decompression, optionally with a dictionary shared by the records.
+};
+
+MIOPEN_INTERNALS_EXPORT bool IsAvailable(KernDbCodec codec);
+MIOPEN_INTERNALS_EXPORT std::string ToString(KernDbCodec codec);
+
 struct KernelConfig
 {
     static std::string table_name() { return "kern_db"; }
@@ -64,125 +82,137 @@ struct KernelConfig
            << ",`kernel_blob` BLOB NOT NULL"
            << ",`kernel_hash` TEXT NOT NULL"
            << ",`uncompressed_size` INT NOT NULL"
-           << ");"
+           << CodecFieldsQuery() << ");"
            << "CREATE UNIQUE INDEX IF NOT EXISTS "
            << "`idx_" << KernelConfig::table_name() << "` "
-           << "ON " << KernelConfig::table_name() << "(kernel_name, kernel_args);";
+           << "ON " << KernelConfig::table_name() << "(kernel_name, kernel_args);"
+           << DictionaryQuery();
         return ss.str();
     }
-    std::string Where() const
+    /// Added to the original schema, see KernDbCodec. The records stored before have the
+    /// default values.
+    static std::vector<std::string> CodecFieldNames() { return {"codec", "dict_id"}; }
+    static std::string CodecFieldsQuery()
     {
-        std::ostringstream ss;
-        ss << "(kernel_name = '" << kernel_name.string() << "')"
-           << " AND (kernel_args = '" << kernel_args << "')";
-        return ss.str();
+        return ",`codec` INT NOT NULL DEFAULT 1"
+               ",`dict_id` INT NOT NULL DEFAULT 0";
+    }
+    static std::string DictionaryQuery()
+    {
+        return "CREATE TABLE IF NOT EXISTS `kern_db_dict` ("
+               "`id` INTEGER PRIMARY KEY ASC"
+               ",`codec` INT NOT NULL"
+               ",`dict` BLOB NOT NULL"
+               ");";
+    }
+    /// The values are bound to the statements, so they are prepared once per connection.
+    static std::string WhereClause() { return "(kernel_name = ?) AND (kernel_args = ?)"; }
+    std::vector<std::string> WhereValues() const { return {kernel_name.string(), kernel_args}; }
+    /// Key of the in-memory index of KernDb.
+    std::size_t Hash() const { return Hash(kernel_name.string(), kernel_args); }
+    static std::size_t Hash(std::string_view name, std::string_view args)
+    {
+        const auto h = std::hash<std::string_view>{}(name);
+        return h ^ (std::hash<std::string_view>{}(args) + 0x9e3779b9 + (h << 6) + (h >> 2));
     }
 };
 
+class ZstdDictionary;
+
 class KernDb : public SQLiteBase<KernDb>
 {
     std::function<std::vector<char>(const std::vector<char>&, bool*)> compress_fn;
     std::function<std::vector<char>(const std::vector<char>&, unsigned int)> decompress_fn;
+    /// Codec of the new records.
+    KernDbCodec codec = KernDbCodec::BZip2;
+    /// Dictionary of the new records, 0 if there is none.
+    int64_t dict_id = 0;
+    /// False for the databases without the `codec` column: all their records are bz2.
+    bool has_codec_fields = false;
+
+    struct EncodedBlob
+    {
+        std::vector<char> data; ///< Empty if the blob is to be stored uncompressed.
+        KernDbCodec codec = KernDbCodec::None;
+        int64_t dict_id   = 0;
+    };
+
+    MIOPEN_INTERNALS_EXPORT EncodedBlob Encode(const std::vector<char>& blob) const;
+    /// Doesn't use the connection, the dictionary is looked up by FindDictionary().
+    MIOPEN_INTERNALS_EXPORT std::vector<char> Decode(std::vector<char> blob,
+                                                     int64_t codec_,
+                                                     const ZstdDictionary* dict,
+                                                     int64_t size) const;
+    /// Returns nullptr if the record of the codec doesn't use a dictionary.
+    std::shared_ptr<const ZstdDictionary> FindDictionary(int64_t codec_, int64_t dict_id_) const;
 
 public:
+    /// The codec of the new records is set by MIOPEN_DEBUG_KERN_DB_CODEC, zstd by default.
     MIOPEN_INTERNALS_EXPORT KernDb(DbKinds db_kind, const fs::path& filename_, bool is_system);
-    // This constructor is only intended for testing
+    MIOPEN_INTERNALS_EXPORT
+    KernDb(DbKinds db_kind, const fs::path& filename_, bool is_system_, KernDbCodec codec_);
+    // This constructor is only intended for testing. The functions replace bz2.
     MIOPEN_INTERNALS_EXPORT
     KernDb(DbKinds db_kind,
            const fs::path& filename_,
            bool is_system_,
            std::function<std::vector<char>(const std::vector<char>&, bool*)> compress_fn_,
            std::function<std::vector<char>(const std::vector<char>&, unsigned int)> decompress_fn_);
-    template <typename T>
-    bool RemoveRecordUnsafe(const T& problem_config)
-    {
-        if(filename.empty())
-            return true;
-        auto del_query =
-            "DELETE FROM " + T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, del_query};
-        auto rc   = stmt.Step(sql);
-        if(rc == SQLITE_DONE)
-        {
-            return true;
-        }
-        else
-        {
-            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
-            return false;
-        }
-    }
 
-    template <typename T>
-    boost::optional<std::vector<char>> FindRecordUnsafe(const T& problem_config)
-    {
-        if(filename.empty())
-            return boost::none;
-        // Where clause with inserted values defeats the purpose of a prepraed statement
-        auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size FROM " +
-                            T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, select_query};
-        // only one result field
-        // assert one row
-        auto rc = stmt.Step(sql);
-        if(rc == SQLITE_ROW)
-        {
-            auto compressed_blob                 = stmt.ColumnBlob(0);
-            auto md5_hash                        = stmt.ColumnText(1);
-            auto uncompressed_size               = stmt.ColumnInt64(2);
-            std::vector<char>& decompressed_blob = compressed_blob;
-            if(uncompressed_size != 0)
-            {
-                decompressed_blob = decompress_fn(compressed_blob, uncompressed_size);
-            }
-            auto new_md5 = md5(decompressed_blob);
-            if(new_md5 != md5_hash)
-                MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
-            return decompressed_blob;
-        }
-        else if(rc == SQLITE_DONE)
-        {
-            return boost::none;
-        }
-        else
-        {
-            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
-        }
-        return boost::none;
-    }
+    KernDbCodec GetCodec() const { return codec; }
 
-    template <typename T>
-    bool StoreRecordUnsafe(const T& problem_config)
+    /// Trains a zstd dictionary of at most \p max_size bytes on the records of the database and
+    /// recompresses all of them with it. The new zstd records use it as well.
+    /// Shared structure of the code objects of one target (ELF headers, notes, metadata) is
+    /// then stored once, which pays off most for small kernels.
+    /// \return false if zstd is not available, the database is read-only, or the records are
+    /// not suitable for training.
+    MIOPEN_INTERNALS_EXPORT bool TrainDictionary(std::size_t max_size = 112640);
+
+    /// Returns the decompressed records, at most \p max_records of them.
+    MIOPEN_INTERNALS_EXPORT std::vector<KernelConfig>
+    LoadRecords(std::size_t max_records = std::numeric_limits<std::size_t>::max());
+    /// Reads the keys of all the records into memory. A lookup is then a hash probe and a read
+    /// of one row by its id instead of a search of the SQLite index by the long kernel_args.
+    /// The records stored through this connection are indexed as well, but not the ones
+    /// stored by the others, so this is meant for the databases that don't change, like the
+    /// system ones.
+    /// \return The number of records indexed.
+    MIOPEN_INTERNALS_EXPORT std::size_t BuildIndex();
+    /// Uses the index of another connection to the same database, which must not be written to.
+    void ShareIndex(const KernDb& other) { index = other.index; }
+    bool HasIndex() const { return index != nullptr; }
+
+    /// A record as it is stored, see FetchRecordUnsafe().
+    struct StoredRecord
     {
-        if(filename.empty())
-            return false;
-        auto insert_query = "INSERT OR REPLACE INTO " + T::table_name() +
-                            "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
-                            "uncompressed_size) VALUES(?, ?, ?, ?, ?);";
-        auto md5_sum           = md5(problem_config.kernel_blob);
-        auto uncompressed_size = problem_config.kernel_blob.size();
-        bool success           = false;
-        auto compressed_blob   = compress_fn(problem_config.kernel_blob, &success);
-        auto stmt              = SQLite::Statement{sql, insert_query};
-        stmt.BindPath(1, problem_config.kernel_name);
-        stmt.BindText(2, problem_config.kernel_args);
-        if(!success)
-        {
-            stmt.BindBlob(3, problem_config.kernel_blob);
-            stmt.BindInt64(5, 0);
-        }
-        else
-        {
-            stmt.BindBlob(3, compressed_blob);
-            stmt.BindInt64(5, uncompressed_size);
-        }
-        stmt.BindText(4, md5_sum);
-
-        auto rc = stmt.Step(sql);
-        if(rc != SQLITE_DONE)
-            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
-        return true;
-    }
+        std::vector<char> blob;
+        std::string md5;
+        int64_t size  = 0; ///< Of the code object, 0 if the blob is not compressed.
+        int64_t codec = 0;
+        /// Looked up while the record is fetched, so decoding doesn't use the connection.
+        std::shared_ptr<const ZstdDictionary> dict;
+    };
+
+    MIOPEN_INTERNALS_EXPORT bool RemoveRecordUnsafe(const KernelConfig& problem_config);
+    MIOPEN_INTERNALS_EXPORT boost::optional<std::vector<char>>
+    FindRecordUnsafe(const KernelConfig& problem_config);
+    /// FindRecordUnsafe() in two steps. The lock of a connection shared by the threads is only
+    /// needed to fetch the record, which also reads its dictionary. DecodeRecord() decompresses
+    /// and checks it without using the connection.
+    MIOPEN_INTERNALS_EXPORT boost::optional<StoredRecord>
+    FetchRecordUnsafe(const KernelConfig& problem_config);
+    MIOPEN_INTERNALS_EXPORT std::vector<char> DecodeRecord(StoredRecord record) const;
+    MIOPEN_INTERNALS_EXPORT bool StoreRecordUnsafe(const KernelConfig& problem_config);
+
+private:
+    using Index = std::unordered_multimap<std::size_t, int64_t>;
+    /// Row ids of the records by KernelConfig::Hash(), see BuildIndex().
+    std::shared_ptr<Index> index;
+
+    std::string SelectQuery(const std::string& where) const;
+    /// Reads the record the statement is stepped to and resets the statement.
+    StoredRecord ReadRecord(SQLite::Statement& stmt) const;
 };
 } // namespace miopen
 #endif
@@ -0,0 +1,323 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_KERN_PACK_HPP_
+#define GUARD_MIOPEN_KERN_PACK_HPP_
+
+// This header is shared with the offline converter (tools/kdb2kpack),
+// so it shall not depend on anything but the standard library and stat().
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+namespace kpack {
+
+/// Flat, read-only form of an installed system kernel cache (.kdb).
+///
+/// Layout:
+///   Header
+///   Entry[Header::count], sorted by hash, then by name and args
+///   string pool: names and args, not null-terminated
+///   code objects, uncompressed, each at a multiple of Header::alignment
+///
+/// All offsets are counted from the beginning of the pack. Integers are stored in the
+/// native byte order. The pack is intended to be mapped into memory as is, so that the code
+/// objects are handed to the loader straight from the page cache, which is shared by all the
+/// processes using the pack.
+
+constexpr char Magic[8]          = {'M', 'I', 'O', 'K', 'P', 'A', 'C', 'K'};
+constexpr std::uint32_t Version  = 1;
+constexpr const char* Extension  = ".kpack";
+constexpr std::uint64_t PageSize = 4096;
+
+struct Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t count;
+    /// Size of the kernel cache the pack was made of. Used to detect stale packs.
+    std::uint64_t source_size;
+    std::uint64_t entries_offset;
+    std::uint64_t pool_offset;
+    std::uint64_t pool_size;
+    std::uint64_t alignment;
+    /// Modification time of the kernel cache, in seconds since the epoch. Detects stale packs
+    /// when the kernel cache is replaced by one of the same size.
+    std::uint64_t source_mtime;
+};
+
+struct Entry
+{
+    std::uint64_t hash;
+    std::uint64_t key_offset;
+    std::uint32_t name_size;
+    std::uint32_t args_size;
+    std::uint64_t blob_offset;
+    std::uint64_t blob_size;
+};
+
+static_assert(sizeof(Header) == 64, "Header layout is a part of the file format");
+static_assert(sizeof(Entry) == 40, "Entry layout is a part of the file format");
+
+/// Identifies the kernel cache a pack was made of.
+struct SourceStamp
+{
+    std::uint64_t size  = 0;
+    std::uint64_t mtime = 0;
+
+    friend bool operator==(const SourceStamp& l, const SourceStamp& r)
+    {
+        return l.size == r.size && l.mtime == r.mtime;
+    }
+    friend bool operator!=(const SourceStamp& l, const SourceStamp& r) { return !(l == r); }
+};
+
+/// Returns false if the file does not exist.
+inline bool GetSourceStamp(const std::string& path, SourceStamp& stamp)
+{
+    struct stat info = {};
+    if(::stat(path.c_str(), &info) != 0)
+        return false;
+    stamp.size  = static_cast<std::uint64_t>(info.st_size);
+    stamp.mtime = static_cast<std::uint64_t>(info.st_mtime);
+    return true;
+}
+
+/// FNV-1a, which unlike std::hash is the same for every build.
+inline std::uint64_t Hash(std::string_view name, std::string_view args)
+{
+    auto hash        = std::uint64_t{14695981039346656037ull};
+    const auto apply = [&](std::string_view s) {
+        for(const auto c : s)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+    };
+    apply(name);
+    apply({"\0", 1});
+    apply(args);
+    return hash;
+}
+
+struct Item
+{
+    std::string_view name;
+    std::string_view args;
+    std::string_view blob;
+};
+
+/// Non-owning view of a pack. Does not copy anything.
+class PackView
+{
+public:
+    PackView() = default;
+    PackView(const char* data_, std::size_t size_) : data(data_), size(size_) {}
+
+    /// Checks that the buffer is a complete pack of the current version.
+    bool IsValid() const
+    {
+        if(data == nullptr || size < sizeof(Header))
+            return false;
+        const auto& header = GetHeader();
+        if(std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version)
+            return false;
+        if(header.entries_offset % alignof(Entry) != 0 || header.entries_offset > size ||
+           (size - header.entries_offset) / sizeof(Entry) < header.count)
+            return false;
+        if(header.pool_offset > size || size - header.pool_offset < header.pool_size)
+            return false;
+        const auto begin = GetEntries();
+        const auto end   = begin + header.count;
+        const auto valid = [&](const Entry& entry) {
+            const auto key_size = std::uint64_t{entry.name_size} + entry.args_size;
+            return entry.key_offset <= header.pool_size &&
+                   header.pool_size - entry.key_offset >= key_size &&
+                   entry.blob_offset <= size && size - entry.blob_offset >= entry.blob_size;
+        };
+        // Find() relies on the order.
+        const auto by_hash = [](const Entry& l, const Entry& r) { return l.hash < r.hash; };
+        return std::all_of(begin, end, valid) && std::is_sorted(begin, end, by_hash);
+    }
+
+    const Header& GetHeader() const { return *reinterpret_cast<const Header*>(data); }
+    SourceStamp GetSource() const
+    {
+        return {GetHeader().source_size, GetHeader().source_mtime};
+    }
+    std::size_t Count() const { return GetHeader().count; }
+
+    Item Get(std::size_t index) const { return MakeItem(GetEntries()[index]); }
+
+    /// Binary search by the hash over the sorted entry table.
+    bool Find(std::string_view name, std::string_view args, Item& item) const
+    {
+        const auto hash  = Hash(name, args);
+        const auto begin = GetEntries();
+        const auto end   = begin + Count();
+        const auto less  = [](const Entry& entry, std::uint64_t h) { return entry.hash < h; };
+
+        for(auto it = std::lower_bound(begin, end, hash, less); it != end && it->hash == hash;
+            ++it)
+        {
+            const auto candidate = MakeItem(*it);
+            if(candidate.name == name && candidate.args == args)
+            {
+                item = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    const char* data = nullptr;
+    std::size_t size = 0;
+
+    const Entry* GetEntries() const
+    {
+        return reinterpret_cast<const Entry*>(data + GetHeader().entries_offset);
+    }
+
+    Item MakeItem(const Entry& entry) const
+    {
+        const auto* key = data + GetHeader().pool_offset + entry.key_offset;
+        return {{key, entry.name_size},
+                {key + entry.name_size, entry.args_size},
+                {data + entry.blob_offset, static_cast<std::size_t>(entry.blob_size)}};
+    }
+};
+
+struct SourceRecord
+{
+    std::string name;
+    std::string args;
+    /// Uncompressed size of the code object.
+    std::uint64_t size;
+};
+
+/// Writes a pack of the records to the output. The code objects are requested in the order of
+/// the records one at a time, so that only one of them is in memory at once.
+/// If a record appears several times, the first one wins.
+/// Throws std::runtime_error if a code object is not of the size of its record.
+/// Returns the number of records written.
+template <class TReadBlob>
+std::size_t WritePack(const std::vector<SourceRecord>& records,
+                      const SourceStamp& source,
+                      std::ostream& output,
+                      TReadBlob&& read_blob)
+{
+    auto pool    = std::string{};
+    auto entries = std::vector<Entry>{};
+
+    for(const auto& record : records)
+    {
+        auto entry       = Entry{};
+        entry.hash       = Hash(record.name, record.args);
+        entry.key_offset = pool.size();
+        entry.name_size  = static_cast<std::uint32_t>(record.name.size());
+        entry.args_size  = static_cast<std::uint32_t>(record.args.size());
+        entry.blob_size  = record.size;
+        pool.append(record.name).append(record.args);
+        entries.push_back(entry);
+    }
+
+    const auto key = [&](std::size_t i) {
+        return std::make_pair(
+            std::string_view{records[i].name}, std::string_view{records[i].args});
+    };
+
+    // Indices of the records in the search order.
+    auto order = std::vector<std::size_t>(entries.size());
+    for(std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t l, std::size_t r) {
+        return entries[l].hash != entries[r].hash ? entries[l].hash < entries[r].hash
+                                                  : key(l) < key(r);
+    });
+    order.erase(std::unique(order.begin(),
+                            order.end(),
+                            [&](std::size_t l, std::size_t r) { return key(l) == key(r); }),
+                order.end());
+
+    const auto align = [](std::uint64_t offset) {
+        return (offset + PageSize - 1) / PageSize * PageSize;
+    };
+
+    auto header = Header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version        = Version;
+    header.count          = static_cast<std::uint32_t>(order.size());
+    header.source_size    = source.size;
+    header.entries_offset = sizeof(Header);
+    header.pool_offset    = header.entries_offset + order.size() * sizeof(Entry);
+    header.pool_size      = pool.size();
+    header.alignment      = PageSize;
+    header.source_mtime   = source.mtime;
+
+    // Entries are written in the search order, the code objects in the order of the records.
+    auto sources = order;
+    std::sort(sources.begin(), sources.end());
+    auto offset = align(header.pool_offset + header.pool_size);
+    for(const auto record_id : sources)
+    {
+        entries[record_id].blob_offset = offset;
+        offset                         = align(offset + entries[record_id].blob_size);
+    }
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for(const auto i : order)
+        output.write(reinterpret_cast<const char*>(&entries[i]), sizeof(Entry));
+    output.write(pool.data(), pool.size());
+
+    auto position      = header.pool_offset + header.pool_size;
+    const auto padding = std::string(PageSize, '\0');
+    for(const auto record_id : sources)
+    {
+        const auto blob = read_blob(records[record_id]);
+        if(blob.size() != records[record_id].size)
+            throw std::runtime_error("Unexpected size of the code object of " +
+                                     records[record_id].name);
+        output.write(padding.data(), entries[record_id].blob_offset - position);
+        output.write(blob.data(), blob.size());
+        position = entries[record_id].blob_offset + blob.size();
+    }
+    return order.size();
+}
+
+} // namespace kpack
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_KERN_PACK_HPP_
@@ -42,28 +42,73 @@
 #ifndef GUARD_MIOPEN_KERNEL_CACHE_HPP_
 #define GUARD_MIOPEN_KERNEL_CACHE_HPP_
 
+#include <miopen/config.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/kernel.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/miopen.h>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 namespace miopen {
 
+/// Pair of strings with a precomputed hash.
+/// Keys stored by the cache refer to strings interned by the cache. Keys made for lookups
+/// refer to the caller's strings, so a lookup does not allocate.
+template <class Char>
+struct HashedKey
+{
+    using FirstView = std::basic_string_view<Char>;
+
+    HashedKey(FirstView first_, std::string_view second_)
+        : first(first_), second(second_), hash(Hash(first_, second_))
+    {
+    }
+
+    FirstView first;
+    std::string_view second;
+    std::size_t hash;
+
+    bool operator==(const HashedKey& other) const
+    {
+        return hash == other.hash && first == other.first && second == other.second;
+    }
+
+    struct Hasher
+    {
+        std::size_t operator()(const HashedKey& key) const { return key.hash; }
+    };
+
+private:
+    static std::size_t Hash(FirstView first, std::string_view second)
+    {
+        const auto h = std::hash<FirstView>{}(first);
+        return h ^ (std::hash<std::string_view>{}(second) + 0x9e3779b9 + (h << 6) + (h >> 2));
+    }
+};
+
+/// (algorithm, network_config)
+using KernelKey = HashedKey<char>;
+/// (program name, build parameters)
+using ProgramKey = HashedKey<fs::path::value_type>;
+
 /**
  * @brief The KernelCache class Build and cache kernels
  *
+ * Lookups take a shared lock, so threads using the same handle do not serialize on them.
+ * References returned by GetKernels stay valid until the same key is cleared or extended.
  */
-class KernelCache
+class MIOPEN_INTERNALS_EXPORT KernelCache
 {
 
 public:
-    using Key        = std::pair<fs::path, std::string>;
-    using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
-    using ProgramMap = std::unordered_map<Key, Program, SimpleHash>;
+    using KernelMap  = std::unordered_map<KernelKey, std::vector<Kernel>, KernelKey::Hasher>;
+    using ProgramMap = std::unordered_map<ProgramKey, Program, ProgramKey::Hasher>;
 
     Kernel AddKernel(const Handle& h,
                      const std::string& algorithm,
@@ -77,12 +122,15 @@ public:
                      const std::string& kernel_src = "",
                      Program* program_out          = nullptr);
 
-    void AddKernel(Key key, Kernel k, std::size_t cache_index);
+    void AddKernel(const std::string& algorithm,
+                   const std::string& network_config,
+                   Kernel k,
+                   std::size_t cache_index);
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config);
 
     const std::vector<Kernel>& GetKernels(const std::string& algorithm,
-                                          const std::string& network_config);
+                                          const std::string& network_config) const;
 
     bool HasProgram(const fs::path& name, const std::string& params) const;
     void ClearProgram(const fs::path& name, const std::string& params);
@@ -92,8 +140,16 @@ public:
     KernelCache();
 
 private:
+    mutable std::shared_mutex mutex;
     KernelMap kernel_map;
     ProgramMap program_map;
+    /// Node based, so views of the strings survive rehashing. Never shrinks.
+    std::unordered_set<std::string> strings;
+    std::unordered_set<fs::path::string_type> paths;
+
+    /// Shall be called under the unique lock.
+    KernelKey InternKernelKey(std::string_view algorithm, std::string_view network_config);
+    ProgramKey InternProgramKey(const fs::path& name, std::string_view params);
 };
 
 } // namespace miopen
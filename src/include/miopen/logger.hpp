@@ -37,6 +37,7 @@
 #include <miopen/each_args.hpp>
 #include <miopen/object.hpp>
 #include <miopen/config.hpp>
+#include <miopen/trace.hpp>
 
 #if MIOPEN_USE_ROCTRACER
 #include <roctracer/roctx.h>
@@ -222,6 +223,14 @@ MIOPEN_INTERNALS_EXPORT std::string LoggingLevelToCustomString(LoggingLevel leve
 MIOPEN_INTERNALS_EXPORT const char* LoggingLevelToCString(LoggingLevel level);
 MIOPEN_INTERNALS_EXPORT std::string LoggingPrefix();
 
+/// Writes a formatted log record to stderr or to MIOPEN_LOG_FILE. With MIOPEN_LOG_ASYNC enabled
+/// the record is queued for a background writer, unless \p flush is set: then it is written
+/// together with all the queued records before the call returns.
+MIOPEN_INTERNALS_EXPORT void LoggingWrite(std::string record, bool flush = false);
+
+/// Writes all the records queued by MIOPEN_LOG_ASYNC.
+MIOPEN_INTERNALS_EXPORT void LoggingFlush();
+
 /// \return true if level is enabled.
 /// \param level - one of the values defined in LoggingLevel.
 MIOPEN_INTERNALS_EXPORT bool IsLogging(LoggingLevel level, bool disableQuieting = false);
@@ -295,13 +304,10 @@ LogParam(std::ostream& os, std::string name, const std::vector<T>& vec, bool ind
 #define MIOPEN_LOG_FUNCTION_EACH(param)                                         \
     do                                                                          \
     {                                                                           \
-        /* Clear temp stringstream & reset its state: */                        \
-        std::ostringstream().swap(miopen_log_func_ss);                          \
         /* Use stringstram as ostream to engage existing template functions: */ \
         std::ostream& miopen_log_func_ostream = miopen_log_func_ss;             \
         miopen_log_func_ostream << miopen::LoggingPrefix();                     \
         miopen::LogParam(miopen_log_func_ostream, #param, param) << std::endl;  \
-        std::cerr << miopen_log_func_ss.str();                                  \
     } while(false);
 
 #define MIOPEN_LOG_FUNCTION_EACH_ROCTX(param)                                     \
@@ -328,6 +334,7 @@ LogParam(std::ostream& os, std::string name, const std::vector<T>& vec, bool ind
 #endif
 
 #define MIOPEN_LOG_FUNCTION(...)                                                        \
+    MIOPEN_TRACE_SCOPE("api", MIOPEN_GET_FN_NAME);                                      \
     MIOPEN_LOG_ROCTX_DEFINE_OBJECT                                                      \
     do                                                                                  \
     {                                                                                   \
@@ -336,16 +343,14 @@ LogParam(std::ostream& os, std::string name, const std::vector<T>& vec, bool ind
             std::ostringstream miopen_log_func_ss;                                      \
             miopen_log_func_ss << miopen::LoggingPrefix() << __PRETTY_FUNCTION__ << "{" \
                                << std::endl;                                            \
-            std::cerr << miopen_log_func_ss.str();                                      \
             MIOPEN_PP_EACH_ARGS(MIOPEN_LOG_FUNCTION_EACH, __VA_ARGS__)                  \
-            std::ostringstream().swap(miopen_log_func_ss);                              \
             miopen_log_func_ss << miopen::LoggingPrefix() << "}" << std::endl;          \
-            std::cerr << miopen_log_func_ss.str();                                      \
+            miopen::LoggingWrite(miopen_log_func_ss.str());                             \
         }                                                                               \
         MIOPEN_LOG_ROCTX_DO_LOGGING(__VA_ARGS__)                                        \
     } while(false)
 #else
-#define MIOPEN_LOG_FUNCTION(...)
+#define MIOPEN_LOG_FUNCTION(...) MIOPEN_TRACE_SCOPE("api", MIOPEN_GET_FN_NAME)
 #endif
 
 constexpr std::string_view LoggingParseFunction(const std::string_view func,
@@ -364,16 +369,16 @@ constexpr std::string_view LoggingParseFunction(const std::string_view func,
 #define MIOPEN_GET_FN_NAME miopen::LoggingParseFunction(__func__, __PRETTY_FUNCTION__)
 #endif
 
-#define MIOPEN_LOG_XQ_CUSTOM(level, disableQuieting, category, fn_name, ...)                \
-    do                                                                                      \
-    {                                                                                       \
-        if(miopen::IsLogging(level, disableQuieting))                                       \
-        {                                                                                   \
-            std::ostringstream miopen_log_ss;                                               \
-            miopen_log_ss << miopen::LoggingPrefix() << category << " [" << fn_name << "] " \
-                          << __VA_ARGS__ << std::endl;                                      \
-            std::cerr << miopen_log_ss.str();                                               \
-        }                                                                                   \
+#define MIOPEN_LOG_XQ_CUSTOM(level, disableQuieting, category, fn_name, ...)                   \
+    do                                                                                         \
+    {                                                                                          \
+        if(miopen::IsLogging(level, disableQuieting))                                          \
+        {                                                                                      \
+            std::ostringstream miopen_log_ss;                                                  \
+            miopen_log_ss << miopen::LoggingPrefix() << category << " [" << fn_name << "] "    \
+                          << __VA_ARGS__ << std::endl;                                         \
+            miopen::LoggingWrite(miopen_log_ss.str(), (level) <= miopen::LoggingLevel::Error); \
+        }                                                                                      \
     } while(false)
 
 #define MIOPEN_LOG_XQ_(level, disableQuieting, fn_name, ...) \
@@ -411,7 +416,7 @@ constexpr std::string_view LoggingParseFunction(const std::string_view func,
         miopen_driver_cmd_ss << miopen::LoggingPrefix() << "Command"                         \
                              << " [" << MIOPEN_GET_FN_NAME << "] " driver " " << __VA_ARGS__ \
                              << std::endl;                                                   \
-        std::cerr << miopen_driver_cmd_ss.str();                                             \
+        miopen::LoggingWrite(miopen_driver_cmd_ss.str());                                    \
     } while(false)
 
 #ifdef _WIN32
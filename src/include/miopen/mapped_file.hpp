@@ -0,0 +1,62 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_MAPPED_FILE_HPP_
+#define GUARD_MIOPEN_MAPPED_FILE_HPP_
+
+#include <miopen/config.hpp>
+#include <miopen/filesystem.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstddef>
+
+namespace miopen {
+
+/// Read-only mapping of a whole file into memory.
+/// Pages are backed by the file itself, so processes mapping the same file share them.
+class MIOPEN_INTERNALS_EXPORT MappedFile
+{
+public:
+    MappedFile() = default;
+    /// Throws miopen::Exception if the file can't be mapped.
+    explicit MappedFile(const fs::path& path);
+
+    MappedFile(MappedFile&&) = default;
+    MappedFile& operator=(MappedFile&&) = default;
+
+    const char* Data() const { return static_cast<const char*>(region.get_address()); }
+    std::size_t Size() const { return region.get_size(); }
+    bool Empty() const { return Size() == 0; }
+
+private:
+    boost::interprocess::file_mapping mapping;
+    boost::interprocess::mapped_region region;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_MAPPED_FILE_HPP_
@@ -26,34 +26,79 @@
 
 #pragma once
 
-#include <queue>
 #include <condition_variable>
+#include <cstddef>
 #include <mutex>
+#include <optional>
+#include <queue>
 
+/// Multi-producer multi-consumer queue.
+///
+/// With a non-zero capacity, producers wait while the queue is full, so a fast producer can't
+/// run arbitrarily far ahead of the consumer. Once the queue is closed, pushes fail and pops
+/// return whatever is left and then std::nullopt; closing serves both as the end-of-stream
+/// marker of the producers and as a cancellation request of the consumer.
 template <typename T>
 class ThreadSafeQueue
 {
     std::mutex mutex;
-    std::condition_variable cond_var;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
     std::queue<T> queue;
+    std::size_t capacity;
+    bool is_closed = false;
 
 public:
-    void push(T&& item)
+    /// Zero capacity means the queue is unbounded.
+    explicit ThreadSafeQueue(std::size_t capacity_ = 0) : capacity(capacity_) {}
+
+    /// Returns false if the queue has been closed; the item is dropped in this case.
+    bool push(T&& item)
     {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            not_full.wait(lock, [&] {
+                return is_closed || capacity == 0 || queue.size() < capacity;
+            });
+            if(is_closed)
+                return false;
+            queue.push(std::move(item));
+        }
 
+        not_empty.notify_one();
+        return true;
+    }
+
+    std::optional<T> pop()
+    {
+        std::optional<T> ret;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            not_empty.wait(lock, [&] { return is_closed || !queue.empty(); });
+            if(queue.empty())
+                return std::nullopt;
+            ret.emplace(std::move(queue.front()));
+            queue.pop();
+        }
+
+        not_full.notify_one();
+        return ret;
+    }
+
+    void close()
+    {
         {
             std::lock_guard<std::mutex> lock(mutex);
-            queue.push(item);
+            is_closed = true;
         }
 
-        cond_var.notify_one();
+        not_empty.notify_all();
+        not_full.notify_all();
     }
-    T pop()
+
+    bool closed()
     {
-        std::unique_lock<std::mutex> lock(mutex);
-        cond_var.wait(lock, [&] { return !queue.empty(); });
-        T ret = queue.front();
-        queue.pop();
-        return ret;
+        std::lock_guard<std::mutex> lock(mutex);
+        return is_closed;
     }
 };
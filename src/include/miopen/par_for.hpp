@@ -36,6 +36,8 @@
 
 #include <thread>
 
+#include <miopen/thread_pool.hpp>
+
 namespace miopen {
 
 struct joinable_thread : std::thread
@@ -73,25 +75,16 @@ struct thread_factory
     }
 };
 
+/// Runs the loop on at most THREADSIZE threads of the process-wide pool.
+/// Each thread takes several chunks of at least GRAINSIZE iterations,
+/// so a thread finishing early helps with the rest of the loop.
 template <class F>
-void par_for_impl(std::size_t n, std::size_t threadsize, F f)
+void par_for_impl(std::size_t n, std::size_t threadsize, F f, std::size_t grainsize = 1)
 {
-    if(threadsize <= 1)
-    {
-        for(std::size_t i = 0; i < n; i++)
-            f(i);
-    }
-    else
-    {
-        std::vector<joinable_thread> threads(threadsize);
-        const std::size_t grainsize = std::ceil(static_cast<double>(n) / threads.size());
-
-        std::size_t work = 0;
-        std::generate(threads.begin(),
-                      threads.end(),
-                      std::bind(thread_factory{}, std::ref(work), n, grainsize, f));
-        assert(work >= n);
-    }
+    constexpr std::size_t chunks_per_thread = 8;
+    const auto chunk =
+        std::max(grainsize, n / (std::max<std::size_t>(threadsize, 1) * chunks_per_thread));
+    ThreadPool::Get().ParallelFor(n, threadsize, chunk, f);
 }
 
 template <class F>
@@ -99,7 +92,7 @@ void par_for(std::size_t n, std::size_t min_grain, F f)
 {
     const auto threadsize =
         std::min<std::size_t>(std::thread::hardware_concurrency(), n / min_grain);
-    par_for_impl(n, threadsize, f);
+    par_for_impl(n, threadsize, f, min_grain);
 }
 
 struct min_grain
@@ -111,7 +104,7 @@ template <class F>
 void par_for(std::size_t n, min_grain mg, F f)
 {
     const auto threadsize = std::min<std::size_t>(std::thread::hardware_concurrency(), n / mg.n);
-    par_for_impl(n, threadsize, f);
+    par_for_impl(n, threadsize, f, mg.n);
 }
 
 template <class F>
@@ -117,6 +117,15 @@ struct Problem
     std::vector<Solution>
     FindSolutions(Handle& handle, const FindOptions& options, std::size_t max_solutions) const;
 
+    /// Finds solutions to several problems at once. Convolutions with equal network configs are
+    /// searched once, and the kernels of all searched convolutions are compiled before any of
+    /// them is benchmarked. Other problems are searched one by one.
+    static std::vector<std::vector<Solution>>
+    FindSolutions(Handle& handle,
+                  const std::vector<const Problem*>& problems,
+                  const FindOptions& options,
+                  std::size_t max_solutions);
+
     conv::ProblemDescription AsConvolution() const;
     activ::ProblemDescription AsActivation() const;
     mha::ProblemDescription AsMha() const;
@@ -188,6 +197,13 @@ private:
                                             const Buffers& buffers,
                                             const ConvolutionDescriptor& conv_desc) const;
 
+    static std::vector<std::vector<Solution>>
+    FindConvolutionSolutions(Handle& handle,
+                             const std::vector<const Problem*>& problems,
+                             const FindOptions& options,
+                             std::size_t max_solutions,
+                             const Buffers& buffers);
+
     std::vector<Solution> FindSolutionsImpl(Handle& handle,
                                             const FindOptions& options,
                                             std::size_t max_solutions,
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_PROGRAM_CACHE_HPP_
+#define GUARD_MIOPEN_PROGRAM_CACHE_HPP_
+
+#include <miopen/config.hpp>
+#include <miopen/filesystem.hpp>
+#include <miopen/kernel.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+
+namespace miopen {
+
+/// Programs loaded by all handles of the process.
+///
+/// A program is loaded into the device context rather than into a handle, so handles of the same
+/// device may share it. If a program is requested while another thread is still building it,
+/// the request waits for that build instead of starting another one.
+///
+/// Every request names its user, typically a handle. A program stays cached while at least one of
+/// the users that requested it has not been released.
+class MIOPEN_INTERNALS_EXPORT ProgramCache
+{
+public:
+    struct Key
+    {
+        int device;
+        fs::path program;
+        std::string options;
+        std::string source;
+        bool attach_binary;
+
+        bool operator<(const Key& other) const
+        {
+            return std::tie(device, program, options, source, attach_binary) <
+                   std::tie(other.device,
+                            other.program,
+                            other.options,
+                            other.source,
+                            other.attach_binary);
+        }
+    };
+
+    struct Stats
+    {
+        /// Requests served by a program which was already loaded.
+        std::size_t hits = 0;
+        /// Requests which loaded the program.
+        std::size_t misses = 0;
+        /// Requests which waited for a concurrent load of the same program instead of repeating it.
+        std::size_t deduplicated = 0;
+    };
+
+    /// The instance shared by all handles. It is never destroyed, because programs must not be
+    /// unloaded after the runtime is shut down at exit.
+    static ProgramCache& Global();
+
+    /// Returns the cached program or loads it with the given function.
+    /// If loading throws, the exception is passed to all waiting callers and nothing is cached.
+    Program GetOrLoad(const Key& key, const void* user, const std::function<Program()>& load);
+
+    /// Drops the programs which are not used by anyone else. Called when a handle is destroyed.
+    void Release(const void* user);
+
+    /// Subsequent requests for the program will load it again, whatever its source was.
+    /// Current users of the program are not affected.
+    void Erase(int device, const fs::path& program, const std::string& options);
+    void Clear();
+
+    Stats GetStats() const;
+    std::size_t Size() const;
+
+private:
+    struct Entry
+    {
+        std::shared_future<Program> program;
+        /// Tells a load apart from the later ones of the same key.
+        std::size_t load_id;
+        std::set<const void*> users;
+    };
+
+    mutable std::mutex mutex;
+    std::map<Key, Entry> programs;
+    std::size_t last_load_id = 0;
+    Stats stats;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_PROGRAM_CACHE_HPP_
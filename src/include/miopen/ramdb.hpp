@@ -27,13 +27,18 @@
 
 #include <miopen/db.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/trace.hpp>
 
 #include <boost/optional.hpp>
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <map>
+#include <shared_mutex>
 #include <string>
 #include <sstream>
+#include <vector>
 
 // Value of one enables experimental write-through feature of RamDb.
 // It provides some performance gain in case of multi-threaded cache write operations.
@@ -45,6 +50,16 @@ using ramdb_clock = std::chrono::steady_clock;
 
 class LockFile;
 
+enum class RamDbMode
+{
+    /// Every access takes the cross-process file lock and checks that the cache is up to date.
+    Exclusive,
+    /// Lookups are served from the cache under per-shard shared locks. The file lock is only
+    /// taken to reload the cache or to write a record back. Changes made by other processes
+    /// are picked up once per validation interval instead of on every lookup.
+    ReadMostly,
+};
+
 class MIOPEN_INTERNALS_EXPORT RamDb : protected PlainTextDb
 {
 public:
@@ -58,6 +73,7 @@ public:
     }
 
     RamDb(DbKinds db_kind_, const fs::path& path, bool is_system = false);
+    RamDb(DbKinds db_kind_, const fs::path& path, bool is_system, RamDbMode mode_);
 
     RamDb(const RamDb&) = delete;
     RamDb(RamDb&&)      = delete;
@@ -65,7 +81,11 @@ public:
     RamDb& operator=(RamDb&&) = delete;
 
     static fs::path GetTimeFilePath(const fs::path& path);
+    /// The mode is set by the MIOPEN_RAMDB_READ_MOSTLY environment variable.
     static RamDb& GetCached(DbKinds db_kind_, const fs::path& path, bool is_system);
+    /// The mode only has effect when the instance for the path is created.
+    static RamDb&
+    GetCached(DbKinds db_kind_, const fs::path& path, bool is_system, RamDbMode mode_);
 
     static RamDb& GetCached(DbKinds db_kind_,
                             const fs::path& path,
@@ -76,6 +96,8 @@ public:
         return GetCached(db_kind_, path, is_system);
     }
 
+    RamDbMode GetMode() const { return mode; }
+
     boost::optional<DbRecord> FindRecord(const std::string& problem);
 
     template <class TProblem>
@@ -95,6 +117,7 @@ public:
     }
 
     bool StoreRecord(const DbRecord& record);
+    bool StoreRecords(const std::vector<DbRecord>& records);
     bool UpdateRecord(DbRecord& record);
     bool RemoveRecord(const std::string& key);
     bool Remove(const std::string& key, const std::string& id);
@@ -133,13 +156,65 @@ private:
         std::string content;
     };
 
+    /// Each shard has its own lock, so lookups of different keys don't contend and lookups
+    /// of the same key only share a lock.
+    class ShardedCache
+    {
+    public:
+        /// Calls f(const CacheItem&) under the shard lock if the key is found.
+        template <class TFunc>
+        bool Visit(const std::string& key, TFunc&& f) const
+        {
+            const auto& shard = GetShard(key);
+            const auto lock   = std::shared_lock<std::shared_mutex>{shard.mutex};
+            const auto it     = shard.items.find(key);
+            if(it == shard.items.end())
+                return false;
+            f(it->second);
+            return true;
+        }
+
+        bool Empty() const;
+        /// Replaces contents of an existing item or inserts a new one without a line number.
+        void Set(const std::string& key, std::string content);
+        void Erase(const std::string& key);
+        /// Replaces the whole cache. The items are distributed to shards before locking.
+        void Assign(std::map<std::string, CacheItem> items);
+
+    private:
+        static constexpr std::size_t ShardCount = 16;
+
+        struct Shard
+        {
+            mutable std::shared_mutex mutex;
+            std::map<std::string, CacheItem> items;
+        };
+
+        std::array<Shard, ShardCount> shards;
+
+        static std::size_t GetShardIndex(const std::string& key)
+        {
+            return std::hash<std::string>{}(key) % ShardCount;
+        }
+
+        Shard& GetShard(const std::string& key) { return shards[GetShardIndex(key)]; }
+        const Shard& GetShard(const std::string& key) const
+        {
+            return shards[GetShardIndex(key)];
+        }
+    };
+
+    RamDbMode mode;
     ramdb_clock::time_point file_read_time;
-    std::map<std::string, CacheItem> cache;
+    /// Time of the next file check in the ReadMostly mode, as ramdb_clock ticks.
+    std::atomic<ramdb_clock::rep> next_validation{0};
+    ShardedCache cache;
 
     boost::optional<miopen::DbRecord> FindRecordUnsafe(const std::string& problem);
 
     bool ValidateUnsafe();
     void Prefetch();
+    void RevalidateIfDue();
 
 #if MIOPEN_DB_CACHE_WRITE_THROUGH
     void UpdateCacheEntryUnsafe(const DbRecord& record);
@@ -156,6 +231,8 @@ class DbTimer<RamDb>
     template <class TFunc>
     static auto Measure(const std::string& funcName, TFunc&& func)
     {
+        MIOPEN_TRACE_SCOPE("db", [&]() { return "Db::" + funcName; });
+
         if(!miopen::IsLogging(LoggingLevel::Info2))
             return func();
 
@@ -183,6 +260,11 @@ public:
         return Measure("StoreRecord", [&]() { return inner.StoreRecord(record); });
     }
 
+    bool StoreRecords(const std::vector<DbRecord>& records)
+    {
+        return Measure("StoreRecords", [&]() { return inner.StoreRecords(records); });
+    }
+
     bool UpdateRecord(DbRecord& record)
     {
         return Measure("UpdateRecord", [&]() { return inner.UpdateRecord(record); });
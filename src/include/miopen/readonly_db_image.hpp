@@ -0,0 +1,243 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_READONLY_DB_IMAGE_HPP_
+#define GUARD_MIOPEN_READONLY_DB_IMAGE_HPP_
+
+// This header is shared with the offline converter (tools/dbtxt2bin),
+// so it shall not depend on anything but the standard library.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace miopen {
+namespace rodb {
+
+/// Compiled form of a read-only text db (system find-db or perf-db).
+///
+/// Layout:
+///   Header
+///   Entry[Header::count], sorted by key (lexicographically, as unsigned bytes)
+///   string pool: keys and contents, not null-terminated
+///
+/// All offsets are counted from the beginning of the image. Integers are stored in the
+/// native byte order; the image is produced at build time for the target machine.
+/// The image is intended to be mapped into memory as is and searched in place.
+
+constexpr char Magic[8]         = {'M', 'I', 'O', 'R', 'O', 'D', 'B', '\0'};
+constexpr std::uint32_t Version = 1;
+constexpr const char* Extension = ".bin";
+
+struct Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t count;
+    /// Size of the text db the image was made of. Used to detect stale images.
+    std::uint64_t source_size;
+    std::uint64_t entries_offset;
+    std::uint64_t pool_offset;
+    std::uint64_t pool_size;
+};
+
+struct Entry
+{
+    std::uint64_t key_offset;
+    std::uint64_t content_offset;
+    std::uint32_t key_size;
+    std::uint32_t content_size;
+    /// Line number in the source text db, for diagnostics.
+    std::uint32_t line;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(Header) == 48, "Header layout is a part of the file format");
+static_assert(sizeof(Entry) == 32, "Entry layout is a part of the file format");
+
+struct Item
+{
+    std::string_view key;
+    std::string_view content;
+    int line;
+};
+
+/// Non-owning view of an image. Does not copy anything.
+class ImageView
+{
+public:
+    ImageView() = default;
+    ImageView(const char* data_, std::size_t size_) : data(data_), size(size_) {}
+
+    /// Checks that the buffer is a complete image of the current version.
+    bool IsValid() const
+    {
+        if(data == nullptr || size < sizeof(Header))
+            return false;
+        const auto& header = GetHeader();
+        if(std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version)
+            return false;
+        if(header.entries_offset % alignof(Entry) != 0 || header.entries_offset > size ||
+           (size - header.entries_offset) / sizeof(Entry) < header.count)
+            return false;
+        if(header.pool_offset > size || size - header.pool_offset < header.pool_size)
+            return false;
+        // The offsets are not added to the sizes, the sum may wrap around.
+        const auto in_pool = [&](std::uint64_t offset, std::uint32_t part_size) {
+            return offset <= header.pool_size && header.pool_size - offset >= part_size;
+        };
+        const auto begin = GetEntries();
+        const auto end   = begin + header.count;
+        const auto valid = [&](const Entry& entry) {
+            return in_pool(entry.key_offset, entry.key_size) &&
+                   in_pool(entry.content_offset, entry.content_size);
+        };
+        if(!std::all_of(begin, end, valid))
+            return false;
+        // Find() relies on the order.
+        return std::is_sorted(
+            begin, end, [&](const Entry& l, const Entry& r) { return Key(l) < Key(r); });
+    }
+
+    const Header& GetHeader() const { return *reinterpret_cast<const Header*>(data); }
+    std::size_t Count() const { return GetHeader().count; }
+
+    Item Get(std::size_t index) const
+    {
+        const auto& entry = GetEntries()[index];
+        return {Key(entry), Content(entry), static_cast<int>(entry.line)};
+    }
+
+    /// Binary search over the sorted entry table.
+    bool Find(std::string_view key, Item& item) const
+    {
+        const auto begin = GetEntries();
+        const auto end   = begin + Count();
+        const auto less  = [&](const Entry& entry, std::string_view k) { return Key(entry) < k; };
+        const auto it    = std::lower_bound(begin, end, key, less);
+
+        if(it == end || Key(*it) != key)
+            return false;
+
+        item = {Key(*it), Content(*it), static_cast<int>(it->line)};
+        return true;
+    }
+
+private:
+    const char* data = nullptr;
+    std::size_t size = 0;
+
+    const Entry* GetEntries() const
+    {
+        return reinterpret_cast<const Entry*>(data + GetHeader().entries_offset);
+    }
+
+    std::string_view Key(const Entry& entry) const
+    {
+        return {data + GetHeader().pool_offset + entry.key_offset, entry.key_size};
+    }
+
+    std::string_view Content(const Entry& entry) const
+    {
+        return {data + GetHeader().pool_offset + entry.content_offset, entry.content_size};
+    }
+};
+
+/// Parses a text db the same way ReadonlyRamDb does and writes its image to the output.
+/// If a key appears several times, the first record wins, like in ReadonlyRamDb.
+/// Ill-formed lines are reported through the callback and skipped.
+/// Returns the number of records written.
+template <class TOnIllFormed>
+std::size_t WriteImage(std::istream& input,
+                       std::uint64_t source_size,
+                       std::ostream& output,
+                       TOnIllFormed&& on_ill_formed)
+{
+    auto pool    = std::string{};
+    auto entries = std::vector<Entry>{};
+    auto line    = std::string{};
+    auto n_line  = 0u;
+
+    while(std::getline(input, line))
+    {
+        ++n_line;
+
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        if(key_size == std::string::npos || key_size == 0)
+        {
+            on_ill_formed(n_line);
+            continue;
+        }
+
+        auto entry           = Entry{};
+        entry.key_offset     = pool.size();
+        entry.key_size       = static_cast<std::uint32_t>(key_size);
+        entry.content_offset = pool.size() + key_size;
+        entry.content_size   = static_cast<std::uint32_t>(line.size() - key_size - 1);
+        entry.line           = n_line;
+        pool.append(line, 0, key_size);
+        pool.append(line, key_size + 1, std::string::npos);
+        entries.push_back(entry);
+    }
+
+    const auto key = [&](const Entry& entry) {
+        return std::string_view{pool}.substr(entry.key_offset, entry.key_size);
+    };
+
+    std::stable_sort(entries.begin(), entries.end(), [&](const Entry& l, const Entry& r) {
+        return key(l) < key(r);
+    });
+    entries.erase(std::unique(entries.begin(),
+                              entries.end(),
+                              [&](const Entry& l, const Entry& r) { return key(l) == key(r); }),
+                  entries.end());
+
+    auto header = Header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version        = Version;
+    header.count          = static_cast<std::uint32_t>(entries.size());
+    header.source_size    = source_size;
+    header.entries_offset = sizeof(Header);
+    header.pool_offset    = header.entries_offset + entries.size() * sizeof(Entry);
+    header.pool_size      = pool.size();
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+    output.write(pool.data(), pool.size());
+    return entries.size();
+}
+
+} // namespace rodb
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_READONLY_DB_IMAGE_HPP_
@@ -28,11 +28,14 @@
 
 #include <miopen/db_record.hpp>
 #include <miopen/filesystem.hpp>
+#include <miopen/mapped_file.hpp>
+#include <miopen/readonly_db_image.hpp>
 
 #include <boost/optional.hpp>
 
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <sstream>
 
 namespace miopen {
@@ -52,25 +55,21 @@ public:
     boost::optional<DbRecord> FindRecord(const std::string& problem) const
     {
         MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
-        const auto it = cache.find(problem);
-
-        if(it == cache.end())
-            return boost::none;
 
-        auto record = DbRecord{problem};
+        if(IsMapped())
+        {
+            auto item = rodb::Item{};
+            if(!image.Find(problem, item))
+                return boost::none;
+            return ParseRecord(problem, std::string{item.content}, item.line);
+        }
 
-        MIOPEN_LOG_I2("Key match: " << problem);
-        MIOPEN_LOG_I2("Contents found: " << it->second.content);
+        const auto it = cache.find(problem);
 
-        if(!record.ParseContents(it->second.content))
-        {
-            MIOPEN_LOG_E("Error parsing payload under the key: "
-                         << problem << " form file " << db_path << "#" << it->second.line);
-            MIOPEN_LOG_E("Contents: " << it->second.content);
+        if(it == cache.end())
             return boost::none;
-        }
 
-        return record;
+        return ParseRecord(problem, it->second.content, it->second.line);
     }
 
     template <class TProblem>
@@ -95,20 +94,46 @@ public:
         std::string content;
     };
 
-    const std::unordered_map<std::string, CacheItem>& GetCacheMap() const { return cache; }
+    /// When the db is served from the compiled image, the map is built on the first call.
+    const std::unordered_map<std::string, CacheItem>& GetCacheMap() const;
+
+    /// True if the db is served from the compiled image instead of the in-memory map.
+    bool IsMapped() const { return !image_file.Empty(); }
 
 private:
     DbKinds db_kind;
     fs::path db_path;
-    std::unordered_map<std::string, CacheItem> cache;
+    mutable std::unordered_map<std::string, CacheItem> cache;
+    MappedFile image_file;
+    rodb::ImageView image;
 
-    ReadonlyRamDb(const ReadonlyRamDb&) = default;
+    ReadonlyRamDb(const ReadonlyRamDb&) = delete;
     ReadonlyRamDb(ReadonlyRamDb&&)      = default;
-    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = default;
+    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = delete;
     ReadonlyRamDb& operator=(ReadonlyRamDb&&) = default;
 
+    boost::optional<DbRecord>
+    ParseRecord(const std::string& problem, const std::string& content, int line) const
+    {
+        auto record = DbRecord{problem};
+
+        MIOPEN_LOG_I2("Key match: " << problem);
+        MIOPEN_LOG_I2("Contents found: " << content);
+
+        if(!record.ParseContents(content))
+        {
+            MIOPEN_LOG_E("Error parsing payload under the key: "
+                         << problem << " form file " << db_path << "#" << line);
+            MIOPEN_LOG_E("Contents: " << content);
+            return boost::none;
+        }
+
+        return record;
+    }
+
     void Prefetch(bool warn_if_unreadable);
-    void ParseAndLoadDb(std::istream& input_stream, bool warn_if_unreadable);
+    void ParseAndLoadDb(std::string_view text);
+    bool TryMapImage();
 };
 
 } // namespace miopen
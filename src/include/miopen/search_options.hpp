@@ -52,7 +52,8 @@ struct FindOptions : miopenFindOptions
     std::unordered_map<miopenTensorArgumentId_t, Data_t> preallocated_tensors;
     std::optional<Workspace> preallocated_workspace;
     std::optional<FindEnforce> find_enforce;
-    bool attach_binaries = false;
+    bool attach_binaries                   = false;
+    miopenFindTimingPolicy_t timing_policy = miopenFindTimingPolicyDefault;
 };
 
 } // namespace miopen
@@ -68,6 +69,13 @@ inline std::ostream& operator<<(std::ostream& stream, const miopen::FindOptions&
     case miopenFindResultsOrderByWorkspaceSize: stream << "by workspace size"; break;
     }
     stream << ", workspace limit: " << options.workspace_limit;
+    stream << ", timing policy: ";
+    switch(options.timing_policy)
+    {
+    case miopenFindTimingPolicyDefault: stream << "default"; break;
+    case miopenFindTimingPolicyFixed: stream << "fixed"; break;
+    case miopenFindTimingPolicyAdaptive: stream << "adaptive"; break;
+    }
     stream << ")";
     return stream;
 }
@@ -119,6 +119,12 @@ struct MIOPEN_INTERNALS_EXPORT Solution : miopenSolution
     friend void to_json(nlohmann::json& json, const Solution& solution);
     friend void from_json(const nlohmann::json& json, Solution& solution);
 
+    /// Serialized form used by miopenSaveSolution: msgpack encoded json, or a binary container
+    /// with code objects stored contiguously if MIOPEN_SAVE_SOLUTION_AS_BINARY is set.
+    std::vector<std::uint8_t> Save() const;
+    /// Accepts both forms produced by Save. Throws miopenStatusInvalidValue on malformed data.
+    static Solution Load(const char* data, std::size_t size);
+
     void SetInvoker(Invoker invoker_,
                     const std::vector<Program>& programs            = {},
                     const std::vector<solver::KernelInfo>& kernels_ = {})
@@ -191,6 +197,11 @@ private:
 
     static Problem Transpose(const Problem& problem, RunInput* x, const RunInput& w, RunInput* y);
 
+    /// Everything but code objects. Programs referenced by the kernels are returned separately.
+    void ToJson(nlohmann::json& json, std::vector<Program>& programs) const;
+    void SetKernels(const nlohmann::json& json, const std::vector<Program>& programs);
+    static Solution LoadUnsafe(const char* data, std::size_t size);
+
     void LogDriverCommand(const ConvolutionDescriptor& desc) const;
     void LogDriverCommand(const ActivationDescriptor& desc) const;
     void LogDriverCommand(const BatchnormDescriptor& desc) const;
@@ -87,6 +87,12 @@ struct SolverBase
     /// run-time parameters.
     virtual bool IsDynamic() const { return false; }
 
+    /// IsApplicable() may be called for several solvers concurrently, see
+    /// SolverContainer::CheckApplicability(). It must only read the context and the problem.
+    /// Must return false if IsApplicable() relies on something which is not known to be thread
+    /// safe, e.g. rocMLIR. Such checks are run on the calling thread.
+    virtual bool IsApplicableThreadSafe() const { return true; }
+
     static constexpr float wti_approximate_worst = -2;
 
     /// [Informative as of Sep 2020] Returns an approximated value of the expected
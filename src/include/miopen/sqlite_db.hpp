@@ -52,6 +52,11 @@
 
 MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_DISABLE_SQL_WAL)
 MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_DEBUG_PERFDB_OVERRIDE)
+/// Number of inserts committed to a user database in one transaction. 1 disables batching.
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_DEBUG_SQLITE_WRITE_BATCH_SIZE, 1)
+/// A batch is committed at the first write after it gets this old, or in the background once it
+/// has been idle this long.
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_DEBUG_SQLITE_WRITE_BATCH_MS, 1000)
 
 namespace miopen {
 
@@ -187,6 +192,8 @@ public:
         int BindPath(int idx, const fs::path& path);
         int BindBlob(int idx, const std::vector<char>& blob);
         int BindInt64(int idx, int64_t);
+        /// Makes the statement ready to be stepped again and drops its bindings.
+        void Reset();
     };
 
     using result_type = std::vector<std::unordered_map<std::string, std::string>>;
@@ -199,6 +206,37 @@ public:
     bool Valid() const;
     result_type Exec(const std::string& query) const;
     int Changes() const;
+    /// Row id of the last row inserted through this connection.
+    int64_t LastInsertRowId() const;
+    /// Returns a statement prepared once per connection, reset and bound to VALS.
+    /// The reference is valid as long as the connection is.
+    Statement& CachedStatement(const std::string& query,
+                               const std::vector<std::string>& vals = {}) const;
+    /// Write-behind batching of inserts, see MIOPEN_DEBUG_SQLITE_WRITE_BATCH_SIZE.
+    /// Pending writes are visible through this connection only until they are committed.
+    /// A batch is committed once it is full, at the first write after it gets older than
+    /// the time window, by a background thread once it has been idle that long, by FlushAll()
+    /// and when the connection is closed.
+    class MIOPEN_INTERNALS_EXPORT WriteGuard
+    {
+    public:
+        /// Opens a transaction for the current batch if there is none.
+        explicit WriteGuard(const SQLite& sql_);
+        /// Adds the write to the batch. If the write has thrown, the batch is committed right
+        /// away, or rolled back if that fails, so that it isn't left open.
+        ~WriteGuard();
+        WriteGuard(const WriteGuard&) = delete;
+        WriteGuard& operator=(const WriteGuard&) = delete;
+
+    private:
+        const SQLite& sql;
+        int exceptions;
+    };
+    /// Commits the pending batch, if any.
+    void Flush() const;
+    /// Commits the pending batches of all the connections, except the ones being written to.
+    /// Called when a handle is destroyed and when a Find or a precompilation is over.
+    static void FlushAll() noexcept;
     int Retry(std::function<int()>) const;
     static int Retry(std::function<int()> f, fs::path filename);
     std::string ErrorMessage() const;
@@ -324,6 +362,15 @@ public:
         return reinterpret_cast<Derived*>(this)->FindRecordUnsafe(args...);
     }
 
+    template <typename... U>
+    inline auto FetchRecord(U&... args)
+    {
+        using Ret = decltype(reinterpret_cast<Derived*>(this)->FetchRecordUnsafe(args...));
+        if(!is_system && DisableUserDbFileIO)
+            return Ret{};
+        return reinterpret_cast<Derived*>(this)->FetchRecordUnsafe(args...);
+    }
+
     template <typename... U>
     inline auto RemoveRecord(U&... args)
     {
@@ -402,8 +449,9 @@ public:
         std::string clause;
         std::vector<std::string> vals;
         std::tie(clause, vals) = prob_desc.InsertQuery();
-        auto stmt              = SQLite::Statement{sql, clause, vals};
-        auto rc                = stmt.Step(sql);
+        const SQLite::WriteGuard guard{sql};
+        auto& stmt = sql.CachedStatement(clause, vals);
+        auto rc    = stmt.Step(sql);
         if(rc != SQLITE_DONE)
         {
             MIOPEN_THROW(miopenStatusInternalError,
@@ -544,12 +592,13 @@ public:
     {
         if(dbInvalid)
             return boost::none;
+        const SQLite::WriteGuard guard{sql};
         // UPSERT the value
         {
             std::string clause;
             std::vector<std::string> vals;
             std::tie(clause, vals) = problem_config.InsertQuery();
-            auto stmt              = SQLite::Statement{sql, clause, vals};
+            auto& stmt             = sql.CachedStatement(clause, vals);
             auto rc                = stmt.Step(sql);
             if(rc != SQLITE_DONE)
             {
@@ -578,8 +627,8 @@ public:
             // clang-format on
             vals.push_back(id);
             vals.push_back(params.str());
-            auto stmt = SQLite::Statement{sql, query, vals};
-            auto rc   = stmt.Step(sql);
+            auto& stmt = sql.CachedStatement(query, vals);
+            auto rc    = stmt.Step(sql);
             if(rc != SQLITE_DONE)
             {
                 MIOPEN_LOG_E("Failed to insert performance record in the database: " +
@@ -0,0 +1,139 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TEXT_DB_PARSER_HPP_
+#define GUARD_MIOPEN_TEXT_DB_PARSER_HPP_
+
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <ios>
+#include <istream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+/// Reads the whole stream at once. Faster than line by line reading for big text dbs.
+inline std::string ReadTextDb(std::istream& input)
+{
+    input.seekg(0, std::ios::end);
+    const auto size = static_cast<std::streamoff>(input.tellg());
+    input.seekg(0, std::ios::beg);
+
+    if(size < 0)
+    {
+        input.clear();
+        return {std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{}};
+    }
+
+    auto text = std::string(static_cast<std::size_t>(size), '\0');
+    input.read(&text[0], size);
+    // Text mode streams may return less than the file size.
+    text.resize(static_cast<std::size_t>(input.gcount()));
+    return text;
+}
+
+/// Parses "key=content" lines of a text db into MAP, a std::map or std::unordered_map from
+/// std::string to a {int line; std::string content;} item.
+/// The text is split into chunks on line boundaries, one per thread, which are parsed into
+/// separate maps in parallel. Those are merged in order by moving nodes, so the first record
+/// of a key wins like with the sequential parsing.
+/// ON_ILL_FORMED(int line) may be called from any thread.
+template <class Map, class OnIllFormed>
+Map ParseTextDb(std::string_view text,
+                OnIllFormed&& on_ill_formed,
+                std::size_t max_chunks = std::thread::hardware_concurrency())
+{
+    // Merging is sequential, so there are no more chunks than threads by default.
+    constexpr std::size_t min_chunk_size = 1024 * 1024;
+
+    max_chunks            = std::max<std::size_t>(max_chunks, 1);
+    const auto n_chunks   = std::clamp<std::size_t>(text.size() / min_chunk_size, 1, max_chunks);
+    const auto chunk_size = text.size() / n_chunks + 1;
+
+    auto chunks = std::vector<std::string_view>{};
+    while(!text.empty())
+    {
+        auto end = std::min(chunk_size, text.size());
+        end      = std::min(text.find('\n', end - 1), text.size() - 1) + 1;
+        chunks.push_back(text.substr(0, end));
+        text.remove_prefix(end);
+    }
+
+    // The first line of every chunk must be known before parsing for the diagnostics.
+    auto first_lines = std::vector<int>(chunks.size() + 1, 1);
+    par_for(chunks.size(), min_grain{1}, [&](auto i) {
+        first_lines[i + 1] = static_cast<int>(std::count(chunks[i].begin(), chunks[i].end(), '\n'));
+    });
+    std::partial_sum(first_lines.begin(), first_lines.end(), first_lines.begin());
+
+    auto parsed = std::vector<Map>(chunks.size());
+    par_for(chunks.size(), min_grain{1}, [&](auto i) {
+        auto chunk  = chunks[i];
+        auto n_line = first_lines[i];
+
+        for(; !chunk.empty(); ++n_line)
+        {
+            const auto eol  = std::min(chunk.find('\n'), chunk.size());
+            const auto line = chunk.substr(0, eol);
+            chunk.remove_prefix(std::min(eol + 1, chunk.size()));
+
+            if(line.empty())
+                continue;
+
+            const auto key_size = line.find('=');
+            if(key_size == std::string_view::npos || key_size == 0)
+            {
+                on_ill_formed(n_line);
+                continue;
+            }
+
+            parsed[i].emplace(std::piecewise_construct,
+                              std::forward_as_tuple(line.substr(0, key_size)),
+                              std::forward_as_tuple(typename Map::mapped_type{
+                                  n_line, std::string{line.substr(key_size + 1)}}));
+        }
+    });
+
+    if(parsed.empty())
+        return {};
+
+    auto& result = parsed.front();
+    for(auto i = 1u; i < parsed.size(); ++i)
+        result.merge(parsed[i]);
+    return std::move(result);
+}
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TEXT_DB_PARSER_HPP_
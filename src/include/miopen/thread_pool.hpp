@@ -0,0 +1,229 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_THREAD_POOL_HPP_
+#define GUARD_MIOPEN_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+
+/// Process-wide pool of worker threads that execute parallel loops.
+///
+/// A loop is split into chunks which are claimed dynamically, so threads which are done with
+/// their part of an unbalanced loop take over the rest of it. The calling thread works on its
+/// own loop as well and waits only for the chunks already claimed by other threads. Hence a loop
+/// started from inside another one (or from a worker) never waits for a free worker.
+class ThreadPool
+{
+public:
+    /// The pool runs hardware_concurrency() threads including the caller of ParallelFor().
+    static ThreadPool& Get()
+    {
+        static ThreadPool pool{std::max(std::thread::hardware_concurrency(), 1u) - 1};
+        return pool;
+    }
+
+    explicit ThreadPool(std::size_t n_workers)
+    {
+        workers.reserve(n_workers);
+        for(std::size_t i = 0; i < n_workers; ++i)
+            workers.emplace_back([this]() { Work(); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            stop = true;
+        }
+        cv.notify_all();
+        for(auto& worker : workers)
+            worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Number of threads which may work on a loop, the calling one included.
+    std::size_t Size() const { return workers.size() + 1; }
+
+    /// Calls f(i) for each i in [0, n), in chunks of CHUNK consecutive indices, using up to
+    /// MAX_THREADS threads. The first exception thrown by f is rethrown after the loop has
+    /// stopped; chunks which haven't been started by then are skipped.
+    template <class F>
+    void ParallelFor(std::size_t n, std::size_t max_threads, std::size_t chunk, F f)
+    {
+        chunk = std::max<std::size_t>(chunk, 1);
+        if(max_threads <= 1 || workers.empty() || n <= chunk)
+        {
+            for(std::size_t i = 0; i < n; ++i)
+                f(i);
+            return;
+        }
+
+        const auto loop = std::make_shared<Loop>(n, chunk, max_threads, [&](auto begin, auto end) {
+            for(auto i = begin; i < end; ++i)
+                f(i);
+        });
+
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            loops.push_back(loop);
+        }
+        cv.notify_all();
+
+        loop->Run();
+
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            loops.erase(std::remove(loops.begin(), loops.end(), loop), loops.end());
+        }
+        loop->Wait();
+    }
+
+private:
+    struct Loop
+    {
+        Loop(std::size_t n_,
+             std::size_t chunk_,
+             std::size_t max_threads_,
+             std::function<void(std::size_t, std::size_t)> body_)
+            : n(n_), chunk(chunk_), max_threads(max_threads_), body(std::move(body_))
+        {
+        }
+
+        const std::size_t n;
+        const std::size_t chunk;
+        const std::size_t max_threads;
+        const std::function<void(std::size_t, std::size_t)> body;
+
+        /// Guarded by the pool mutex. The thread which has started the loop counts too.
+        std::size_t threads = 1;
+
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> finished{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable done;
+
+        bool Exhausted() const { return next.load() >= n; }
+
+        void Run()
+        {
+            while(true)
+            {
+                const auto begin = next.fetch_add(chunk);
+                if(begin >= n)
+                    return;
+                const auto end = std::min(n, begin + chunk);
+
+                if(!failed.load())
+                {
+                    try
+                    {
+                        body(begin, end);
+                    }
+                    catch(...)
+                    {
+                        const std::lock_guard<std::mutex> lock{mutex};
+                        if(!error)
+                            error = std::current_exception();
+                        failed = true;
+                    }
+                }
+
+                if(finished.fetch_add(end - begin) + (end - begin) == n)
+                {
+                    const std::lock_guard<std::mutex> lock{mutex};
+                    done.notify_all();
+                }
+            }
+        }
+
+        void Wait()
+        {
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                done.wait(lock, [&]() { return finished.load() == n; });
+            }
+            if(error)
+                std::rethrow_exception(error);
+        }
+    };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::shared_ptr<Loop>> loops;
+    std::vector<std::thread> workers;
+    bool stop = false;
+
+    /// Shall be called with the mutex locked.
+    std::shared_ptr<Loop> Take()
+    {
+        loops.erase(std::remove_if(loops.begin(),
+                                   loops.end(),
+                                   [](const auto& loop) { return loop->Exhausted(); }),
+                    loops.end());
+        for(const auto& loop : loops)
+        {
+            if(loop->threads < loop->max_threads)
+            {
+                ++loop->threads;
+                return loop;
+            }
+        }
+        return nullptr;
+    }
+
+    void Work()
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        while(true)
+        {
+            auto loop = std::shared_ptr<Loop>{};
+            cv.wait(lock, [&]() { return stop || (loop = Take()) != nullptr; });
+            if(stop)
+                return;
+            lock.unlock();
+            loop->Run();
+            lock.lock();
+        }
+    }
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_THREAD_POOL_HPP_
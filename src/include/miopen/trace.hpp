@@ -0,0 +1,122 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_TRACE_HPP_
+#define GUARD_MIOPEN_TRACE_HPP_
+
+#include <miopen/config.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace miopen {
+
+/// Host-side tracing. When MIOPEN_TRACE_FILE is set, the spans recorded by TraceScope are
+/// collected in per-thread buffers and written to that file in the Chrome trace event format
+/// (loadable by chrome://tracing and https://ui.perfetto.dev) when the process exits.
+namespace debug {
+
+// For unit tests.
+MIOPEN_EXPORT extern bool
+    tracing_enabled; // NOLINT (cppcoreguidelines-avoid-non-const-global-variables)
+
+} // namespace debug
+
+/// \return true if spans are being recorded.
+MIOPEN_INTERNALS_EXPORT bool IsTracing();
+
+namespace trace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Appends a complete span to the buffer of the calling thread.
+/// \param category - must point to a string literal, it is stored as is.
+MIOPEN_INTERNALS_EXPORT void
+Record(const char* category, std::string name, Clock::time_point start, Clock::time_point end);
+
+/// Writes all the spans recorded so far as a Chrome trace JSON object.
+MIOPEN_INTERNALS_EXPORT void Write(std::ostream& os);
+
+/// Drops all the spans recorded so far.
+MIOPEN_INTERNALS_EXPORT void Clear();
+
+} // namespace trace
+
+/// Records the lifetime of the object as a span. Does nothing but one check when tracing is
+/// disabled. The name may be given as a callable to avoid building it in that case.
+class TraceScope
+{
+public:
+    TraceScope(const char* category_, std::string_view name_) : active(IsTracing())
+    {
+        if(!active)
+            return;
+        category = category_;
+        name     = name_;
+        start    = trace::Clock::now();
+    }
+
+    template <class F, std::enable_if_t<std::is_invocable_r_v<std::string, F>, int> = 0>
+    TraceScope(const char* category_, F&& make_name) : active(IsTracing())
+    {
+        if(!active)
+            return;
+        category = category_;
+        name     = std::forward<F>(make_name)();
+        start    = trace::Clock::now();
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    ~TraceScope()
+    {
+        if(active)
+            trace::Record(category, std::move(name), start, trace::Clock::now());
+    }
+
+private:
+    bool active;
+    const char* category = nullptr;
+    std::string name;
+    trace::Clock::time_point start;
+};
+
+} // namespace miopen
+
+#define MIOPEN_TRACE_CAT_IMPL(x, y) x##y
+#define MIOPEN_TRACE_CAT(x, y) MIOPEN_TRACE_CAT_IMPL(x, y)
+
+/// Traces the rest of the enclosing scope.
+#define MIOPEN_TRACE_SCOPE(category, ...) \
+    const miopen::TraceScope MIOPEN_TRACE_CAT(miopen_trace_scope_, __LINE__)(category, __VA_ARGS__)
+
+#endif // GUARD_MIOPEN_TRACE_HPP_
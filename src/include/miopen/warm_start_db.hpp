@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_WARM_START_DB_HPP_
+#define GUARD_MIOPEN_WARM_START_DB_HPP_
+
+#include <miopen/config.hpp>
+#include <miopen/filesystem.hpp>
+#include <miopen/kernel_info.hpp>
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Everything required to rebuild an invoker without asking the solver for a solution:
+/// the performance config the solver was built with and the kernels it has constructed.
+struct WarmStartRecord
+{
+    std::string perf_cfg;
+    std::vector<solver::KernelInfo> kernels;
+};
+
+/// Per-device persistent map from (network_config, solver_id) to WarmStartRecord.
+///
+/// The file is a text file with a json object per line. Records are appended,
+/// the last one for a key wins. The file is rewritten on load once more than half
+/// of its lines are superseded or ill-formed. Kernel binaries are not stored here, they are
+/// taken from the kernel cache using the file name and compilation options.
+class MIOPEN_INTERNALS_EXPORT WarmStartDb
+{
+public:
+    // network_config, solver_id
+    using Key = std::pair<std::string, std::string>;
+
+    explicit WarmStartDb(const fs::path& path_);
+
+    /// Returns the instance for the device of the handle or nullptr if the db is disabled.
+    static WarmStartDb* Get(const Handle& handle);
+
+    std::optional<WarmStartRecord> Find(const Key& key);
+    void Store(const Key& key, const WarmStartRecord& record);
+
+    static std::string Serialize(const Key& key, const WarmStartRecord& record);
+    /// Returns false if the line is not a valid record.
+    static bool Deserialize(const std::string& line, Key& key, WarmStartRecord& record);
+
+private:
+    fs::path path;
+    std::mutex mutex;
+    bool loaded = false;
+    std::map<Key, WarmStartRecord> records;
+
+    void LoadUnsafe();
+    /// Rewrites the file with the loaded records only. The file lock must be held.
+    void CompactUnsafe();
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_WARM_START_DB_HPP_
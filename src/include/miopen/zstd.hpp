@@ -0,0 +1,75 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_ZSTD_HPP_
+#define GUARD_MIOPEN_ZSTD_HPP_
+
+#include <miopen/config.hpp>
+
+#if MIOPEN_USE_ZSTD
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace miopen {
+
+class ZstdDictionary;
+
+MIOPEN_INTERNALS_EXPORT std::vector<char> zstd_compress(const std::vector<char>& v,
+                                                        int level,
+                                                        const ZstdDictionary* dict = nullptr,
+                                                        bool* compressed           = nullptr);
+MIOPEN_INTERNALS_EXPORT std::vector<char>
+zstd_decompress(const std::vector<char>& v, std::size_t size, const ZstdDictionary* dict = nullptr);
+/// Returns an empty dictionary if the samples are not suitable for training.
+MIOPEN_INTERNALS_EXPORT std::vector<char>
+zstd_train_dictionary(const std::vector<std::vector<char>>& samples, std::size_t max_size);
+
+/// Dictionary shared by the compressed blobs of similar data, e.g. code objects of one
+/// target. Holds the digested forms used by compression and decompression.
+class MIOPEN_INTERNALS_EXPORT ZstdDictionary
+{
+public:
+    ZstdDictionary(const std::vector<char>& data, int level);
+    ~ZstdDictionary();
+    ZstdDictionary(const ZstdDictionary&) = delete;
+    ZstdDictionary& operator=(const ZstdDictionary&) = delete;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+    friend std::vector<char>
+    zstd_compress(const std::vector<char>&, int, const ZstdDictionary*, bool*);
+    friend std::vector<char>
+    zstd_decompress(const std::vector<char>&, std::size_t, const ZstdDictionary*);
+};
+
+} // namespace miopen
+
+#endif // MIOPEN_USE_ZSTD
+
+#endif // GUARD_MIOPEN_ZSTD_HPP_
@@ -25,11 +25,119 @@
  *******************************************************************************/
 #include "miopen/bz2.hpp"
 #include <miopen/kern_db.hpp>
+#include <miopen/zstd.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+/// Codec of the code objects written to the user kernel cache: none, bz2 or zstd.
+/// Defaults to zstd when MIOpen is built with it, and to bz2 otherwise.
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_DEBUG_KERN_DB_CODEC)
 
 namespace miopen {
+
+namespace {
+
+/// Decompression is on the hot path of the cache lookups, compression follows a kernel build
+/// which takes much longer.
+constexpr int zstd_level = 9;
+
+KernDbCodec GetDefaultCodec()
+{
+    const auto name = env::value(MIOPEN_DEBUG_KERN_DB_CODEC);
+    for(const auto codec : {KernDbCodec::None, KernDbCodec::BZip2, KernDbCodec::Zstd})
+    {
+        if(name != ToString(codec))
+            continue;
+        if(IsAvailable(codec))
+            return codec;
+        MIOPEN_LOG_W("Kernel cache codec " << name << " is not available.");
+    }
+    if(!name.empty() && name != "zstd")
+        MIOPEN_LOG_W("Unknown kernel cache codec: " << name);
+    return IsAvailable(KernDbCodec::Zstd) ? KernDbCodec::Zstd : KernDbCodec::BZip2;
+}
+
+#if MIOPEN_USE_ZSTD
+/// Dictionaries are shared by all the connections to a database, they are never changed once
+/// stored.
+std::shared_ptr<const ZstdDictionary> GetDictionary(const SQLite& sql,
+                                                    const fs::path& filename,
+                                                    int64_t id)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto cache =
+        std::map<std::pair<fs::path, int64_t>, std::shared_ptr<const ZstdDictionary>>{};
+
+    const std::lock_guard<std::mutex> lock{mutex};
+    auto& dict = cache[{filename, id}];
+    if(dict)
+        return dict;
+
+    auto stmt = SQLite::Statement{
+        sql, "SELECT dict FROM kern_db_dict WHERE id = " + std::to_string(id) + ";"};
+    if(stmt.Step(sql) != SQLITE_ROW)
+        MIOPEN_THROW(miopenStatusInternalError,
+                     "Missing kernel cache dictionary " + std::to_string(id));
+    dict = std::make_shared<const ZstdDictionary>(stmt.ColumnBlob(0), zstd_level);
+    return dict;
+}
+#endif
+
+} // namespace
+
+bool IsAvailable(KernDbCodec codec)
+{
+    switch(codec)
+    {
+    case KernDbCodec::None:
+    case KernDbCodec::BZip2: return true;
+    case KernDbCodec::Zstd: return MIOPEN_USE_ZSTD != 0;
+    }
+    return false;
+}
+
+std::string ToString(KernDbCodec codec)
+{
+    switch(codec)
+    {
+    case KernDbCodec::None: return "none";
+    case KernDbCodec::BZip2: return "bz2";
+    case KernDbCodec::Zstd: return "zstd";
+    }
+    return "unknown";
+}
+
 KernDb::KernDb(DbKinds db_kind, const fs::path& filename_, bool is_system_)
+    : KernDb(db_kind, filename_, is_system_, is_system_ ? KernDbCodec::BZip2 : GetDefaultCodec())
+{
+}
+
+KernDb::KernDb(DbKinds db_kind, const fs::path& filename_, bool is_system_, KernDbCodec codec_)
     : KernDb(db_kind, filename_, is_system_, compress, decompress)
 {
+    if(!IsAvailable(codec_))
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Kernel cache codec is not available: " + ToString(codec_));
+
+    if(!has_codec_fields)
+        return;
+
+    codec = codec_;
+    if(codec != KernDbCodec::Zstd || is_system)
+        return;
+
+    // New records use the latest dictionary, if any.
+    auto res = sql.Exec("SELECT id FROM kern_db_dict WHERE codec = " +
+                        std::to_string(static_cast<int64_t>(KernDbCodec::Zstd)) +
+                        " ORDER BY id DESC LIMIT 1;");
+    if(!res.empty())
+        dict_id = std::stoll(res[0]["id"]);
 }
 
 KernDb::KernDb(
@@ -66,7 +174,343 @@ KernDb::KernDb(
            << filename;
         MIOPEN_LOG_W(ss.str());
         dbInvalid = true;
+        return;
+    }
+
+    has_codec_fields =
+        CheckTableColumns(KernelConfig::table_name(), KernelConfig::CodecFieldNames());
+    if(!has_codec_fields && !is_system)
+    {
+        // Created by an older version. Its records are bz2, which is what the defaults say.
+        std::ostringstream ss;
+        ss << "ALTER TABLE `" << KernelConfig::table_name() << "` ADD COLUMN `codec` INT NOT NULL "
+           << "DEFAULT 1;"
+           << "ALTER TABLE `" << KernelConfig::table_name() << "` ADD COLUMN `dict_id` INT NOT "
+           << "NULL DEFAULT 0;" << KernelConfig::DictionaryQuery();
+        sql.Exec(ss.str());
+        has_codec_fields =
+            CheckTableColumns(KernelConfig::table_name(), KernelConfig::CodecFieldNames());
+        MIOPEN_LOG_I2("Added codec fields to " << filename);
     }
 }
 
+KernDb::EncodedBlob KernDb::Encode(const std::vector<char>& blob) const
+{
+    auto encoded    = EncodedBlob{};
+    bool compressed = false;
+
+    switch(codec)
+    {
+    case KernDbCodec::None: return encoded;
+    case KernDbCodec::BZip2: encoded.data = compress_fn(blob, &compressed); break;
+    case KernDbCodec::Zstd:
+#if MIOPEN_USE_ZSTD
+        encoded.dict_id = dict_id;
+        encoded.data    = zstd_compress(blob,
+                                     zstd_level,
+                                     dict_id != 0 ? GetDictionary(sql, filename, dict_id).get()
+                                                  : nullptr,
+                                     &compressed);
+#endif
+        break;
+    }
+
+    if(!compressed)
+        return {};
+    encoded.codec = codec;
+    return encoded;
+}
+
+std::shared_ptr<const ZstdDictionary> KernDb::FindDictionary(int64_t codec_,
+                                                             int64_t dict_id_) const
+{
+#if MIOPEN_USE_ZSTD
+    if(static_cast<KernDbCodec>(codec_) == KernDbCodec::Zstd && dict_id_ != 0)
+        return GetDictionary(sql, filename, dict_id_);
+#else
+    std::ignore = codec_;
+    std::ignore = dict_id_;
+#endif
+    return nullptr;
+}
+
+std::vector<char> KernDb::Decode(std::vector<char> blob,
+                                 int64_t codec_,
+                                 const ZstdDictionary* dict,
+                                 int64_t size) const
+{
+    if(size == 0)
+        return blob;
+
+    switch(static_cast<KernDbCodec>(codec_))
+    {
+    case KernDbCodec::None: break;
+    case KernDbCodec::BZip2: return decompress_fn(blob, size);
+    case KernDbCodec::Zstd:
+#if MIOPEN_USE_ZSTD
+        return zstd_decompress(blob, size, dict);
+#else
+        std::ignore = dict;
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Kernel cache record is zstd compressed, MIOpen is built without zstd");
+#endif
+    }
+    MIOPEN_THROW(miopenStatusInternalError,
+                 "Invalid kernel cache codec: " + std::to_string(codec_));
+}
+
+std::string KernDb::SelectQuery(const std::string& where) const
+{
+    return std::string{"SELECT kernel_blob, kernel_hash, uncompressed_size, kernel_name, "
+                       "kernel_args"} +
+           (has_codec_fields ? ", codec, dict_id" : "") + " FROM " + KernelConfig::table_name() +
+           " WHERE " + where + ";";
+}
+
+KernDb::StoredRecord KernDb::ReadRecord(SQLite::Statement& stmt) const
+{
+    auto record  = StoredRecord{};
+    record.blob  = stmt.ColumnBlob(0);
+    record.md5   = stmt.ColumnText(1);
+    record.size  = stmt.ColumnInt64(2);
+    record.codec = static_cast<int64_t>(KernDbCodec::BZip2);
+
+    auto record_dict_id = int64_t{0};
+    if(has_codec_fields)
+    {
+        record.codec   = stmt.ColumnInt64(5);
+        record_dict_id = stmt.ColumnInt64(6);
+    }
+    // A running statement would keep the read transaction open.
+    stmt.Reset();
+    // Under the lock of the connection, unlike DecodeRecord().
+    record.dict = FindDictionary(record.codec, record_dict_id);
+    return record;
+}
+
+std::vector<char> KernDb::DecodeRecord(StoredRecord record) const
+{
+    auto decompressed_blob =
+        Decode(std::move(record.blob), record.codec, record.dict.get(), record.size);
+    if(md5(decompressed_blob) != record.md5)
+        MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
+    return decompressed_blob;
+}
+
+boost::optional<std::vector<char>> KernDb::FindRecordUnsafe(const KernelConfig& problem_config)
+{
+    auto record = FetchRecordUnsafe(problem_config);
+    if(!record)
+        return boost::none;
+    return DecodeRecord(std::move(*record));
+}
+
+boost::optional<KernDb::StoredRecord>
+KernDb::FetchRecordUnsafe(const KernelConfig& problem_config)
+{
+    if(filename.empty())
+        return boost::none;
+
+    if(!index)
+    {
+        auto& stmt = sql.CachedStatement(SelectQuery(KernelConfig::WhereClause()),
+                                         problem_config.WhereValues());
+        const auto rc = stmt.Step(sql);
+        if(rc == SQLITE_ROW)
+            return ReadRecord(stmt);
+        if(rc != SQLITE_DONE)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        return boost::none;
+    }
+
+    const auto name  = problem_config.kernel_name.string();
+    const auto range = index->equal_range(KernelConfig::Hash(name, problem_config.kernel_args));
+    for(auto it = range.first; it != range.second; ++it)
+    {
+        auto& stmt = sql.CachedStatement(SelectQuery("id = ?"));
+        stmt.BindInt64(1, it->second);
+        const auto rc = stmt.Step(sql);
+        // Removed or replaced since it was indexed, or a hash collision.
+        if(rc == SQLITE_DONE ||
+           (rc == SQLITE_ROW &&
+            (stmt.ColumnText(3) != name || stmt.ColumnText(4) != problem_config.kernel_args)))
+        {
+            stmt.Reset();
+            continue;
+        }
+        if(rc != SQLITE_ROW)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        return ReadRecord(stmt);
+    }
+    return boost::none;
+}
+
+bool KernDb::RemoveRecordUnsafe(const KernelConfig& problem_config)
+{
+    if(filename.empty())
+        return true;
+    // The index entries of the removed records are skipped by the lookups.
+    auto& stmt = sql.CachedStatement("DELETE FROM " + KernelConfig::table_name() + " WHERE " +
+                                         KernelConfig::WhereClause() + ";",
+                                     problem_config.WhereValues());
+    if(stmt.Step(sql) != SQLITE_DONE)
+        MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    stmt.Reset();
+    return true;
+}
+
+bool KernDb::StoreRecordUnsafe(const KernelConfig& problem_config)
+{
+    if(filename.empty())
+        return false;
+    const auto insert_query =
+        "INSERT OR REPLACE INTO " + KernelConfig::table_name() +
+        (has_codec_fields ? "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
+                            "uncompressed_size, codec, dict_id) VALUES(?, ?, ?, ?, ?, ?, ?);"
+                          : "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
+                            "uncompressed_size) VALUES(?, ?, ?, ?, ?);");
+    const auto md5_sum           = md5(problem_config.kernel_blob);
+    const auto uncompressed_size = problem_config.kernel_blob.size();
+    const auto encoded           = Encode(problem_config.kernel_blob);
+    const SQLite::WriteGuard guard{sql};
+    auto& stmt = sql.CachedStatement(insert_query);
+    stmt.BindPath(1, problem_config.kernel_name);
+    stmt.BindText(2, problem_config.kernel_args);
+    if(encoded.data.empty())
+    {
+        stmt.BindBlob(3, problem_config.kernel_blob);
+        stmt.BindInt64(5, 0);
+    }
+    else
+    {
+        stmt.BindBlob(3, encoded.data);
+        stmt.BindInt64(5, uncompressed_size);
+    }
+    stmt.BindText(4, md5_sum);
+    if(has_codec_fields)
+    {
+        stmt.BindInt64(6, static_cast<int64_t>(encoded.codec));
+        stmt.BindInt64(7, encoded.dict_id);
+    }
+
+    if(stmt.Step(sql) != SQLITE_DONE)
+        MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    // The replaced record, if any, gets a new id. Its old index entry is skipped by the lookups.
+    if(index)
+        index->emplace(problem_config.Hash(), sql.LastInsertRowId());
+    return true;
+}
+
+std::size_t KernDb::BuildIndex()
+{
+    index = std::make_shared<Index>();
+    if(filename.empty() || dbInvalid)
+        return 0;
+
+    sql.Flush();
+    auto stmt = SQLite::Statement{
+        sql, "SELECT id, kernel_name, kernel_args FROM " + KernelConfig::table_name() + ";"};
+    for(;;)
+    {
+        const auto rc = stmt.Step(sql);
+        if(rc == SQLITE_DONE)
+            break;
+        if(rc != SQLITE_ROW)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        index->emplace(KernelConfig::Hash(stmt.ColumnText(1), stmt.ColumnText(2)),
+                       stmt.ColumnInt64(0));
+    }
+
+    MIOPEN_LOG_I2("Indexed " << index->size() << " record(s) of " << filename);
+    return index->size();
+}
+
+std::vector<KernelConfig> KernDb::LoadRecords(std::size_t max_records)
+{
+    auto records = std::vector<KernelConfig>{};
+    if(filename.empty() || dbInvalid)
+        return records;
+
+    sql.Flush();
+    auto stmt = SQLite::Statement{
+        sql,
+        std::string{"SELECT kernel_name, kernel_args, kernel_blob, uncompressed_size"} +
+            (has_codec_fields ? ", codec, dict_id" : "") + " FROM " + KernelConfig::table_name() +
+            ";"};
+
+    while(records.size() < max_records)
+    {
+        const auto rc = stmt.Step(sql);
+        if(rc == SQLITE_DONE)
+            break;
+        if(rc != SQLITE_ROW)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+
+        const auto record_codec =
+            has_codec_fields ? stmt.ColumnInt64(4) : static_cast<int64_t>(KernDbCodec::BZip2);
+        const auto record_dict_id = has_codec_fields ? stmt.ColumnInt64(5) : 0;
+
+        auto& record       = records.emplace_back();
+        record.kernel_name = stmt.ColumnText(0);
+        record.kernel_args = stmt.ColumnText(1);
+        record.kernel_blob = Decode(stmt.ColumnBlob(2),
+                                    record_codec,
+                                    FindDictionary(record_codec, record_dict_id).get(),
+                                    stmt.ColumnInt64(3));
+    }
+    return records;
+}
+
+bool KernDb::TrainDictionary(std::size_t max_size)
+{
+#if MIOPEN_USE_ZSTD
+    if(filename.empty() || dbInvalid || is_system || !has_codec_fields)
+        return false;
+
+    auto records = LoadRecords();
+
+    // zstd recommends about 100 times as much training data as the size of the dictionary.
+    auto samples      = std::vector<std::vector<char>>{};
+    std::size_t total = 0;
+    for(const auto& record : records)
+    {
+        if(total >= 100 * max_size)
+            break;
+        samples.push_back(record.kernel_blob);
+        total += record.kernel_blob.size();
+    }
+
+    const auto dict = zstd_train_dictionary(samples, max_size);
+    if(dict.empty())
+    {
+        MIOPEN_LOG_W("Unable to train a kernel cache dictionary on " << samples.size()
+                                                                     << " record(s) of "
+                                                                     << filename);
+        return false;
+    }
+
+    sql.Flush();
+    {
+        auto stmt = SQLite::Statement{sql, "INSERT INTO kern_db_dict(codec, dict) VALUES(?, ?);"};
+        stmt.BindInt64(1, static_cast<int64_t>(KernDbCodec::Zstd));
+        stmt.BindBlob(2, dict);
+        if(stmt.Step(sql) != SQLITE_DONE)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    }
+    codec   = KernDbCodec::Zstd;
+    dict_id = sql.LastInsertRowId();
+
+    for(const auto& record : records)
+        StoreRecordUnsafe(record);
+    sql.Flush();
+
+    MIOPEN_LOG_I("Recompressed " << records.size() << " record(s) of " << filename
+                                 << " with a dictionary of " << dict.size() << " bytes");
+    return true;
+#else
+    std::ignore = max_size;
+    return false;
+#endif
+}
+
 } // namespace miopen
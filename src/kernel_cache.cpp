@@ -47,48 +47,60 @@
 
 #include <iostream>
 #include <iterator>
+#include <mutex>
 
 MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_DEVICE_ARCH)
 
 namespace miopen {
 
-const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
-                                                   const std::string& network_config)
+KernelKey KernelCache::InternKernelKey(std::string_view algorithm, std::string_view network_config)
+{
+    const auto& a = *strings.emplace(algorithm).first;
+    const auto& c = *strings.emplace(network_config).first;
+    return {a, c};
+}
+
+ProgramKey KernelCache::InternProgramKey(const fs::path& name, std::string_view params)
 {
+    const auto& n = *paths.emplace(name.native()).first;
+    const auto& p = *strings.emplace(params).first;
+    return {n, p};
+}
 
-    std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
+const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
+                                                   const std::string& network_config) const
+{
+    const std::shared_lock<std::shared_mutex> lock{mutex};
 
-    const auto it = kernel_map.find(key);
+    const auto it = kernel_map.find({algorithm, network_config});
     if(it != kernel_map.end())
     {
         MIOPEN_LOG_I2(it->second.size()
-                      << " kernels for key: " << key.first << " \"" << key.second << '\"');
+                      << " kernels for key: " << algorithm << " \"" << network_config << '\"');
         return it->second;
     }
 
     static const std::vector<Kernel> empty{};
-    MIOPEN_LOG_I2("0 kernels for key: " << key.first << " \"" << key.second << '\"');
+    MIOPEN_LOG_I2("0 kernels for key: " << algorithm << " \"" << network_config << '\"');
     return empty;
 }
 
 bool KernelCache::HasProgram(const fs::path& name, const std::string& params) const
 {
-    const auto key = std::make_pair(name, params);
-    return program_map.count(key) > 0;
+    const std::shared_lock<std::shared_mutex> lock{mutex};
+    return program_map.count({name.native(), params}) > 0;
 }
 
 void KernelCache::ClearProgram(const fs::path& name, const std::string& params)
 {
-    if(HasProgram(name, params))
-    {
-        const auto key = std::make_pair(name, params);
-        program_map.erase(key);
-    }
+    const std::unique_lock<std::shared_mutex> lock{mutex};
+    program_map.erase({name.native(), params});
 }
 
 void KernelCache::AddProgram(Program prog, const fs::path& program_name, std::string params)
 {
-    program_map[std::make_pair(program_name, params)] = prog;
+    const std::unique_lock<std::shared_mutex> lock{mutex};
+    program_map[InternProgramKey(program_name, params)] = prog;
 }
 
 Kernel KernelCache::AddKernel(const Handle& h,
@@ -103,34 +115,30 @@ Kernel KernelCache::AddKernel(const Handle& h,
                               const std::string& kernel_src,
                               Program* program_out)
 {
-    const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
     if(!network_config.empty() || !algorithm.empty()) // Don't log only _empty_ keys.
-        MIOPEN_LOG_I2("Key: " << key.first << " \"" << key.second << '\"');
+        MIOPEN_LOG_I2("Key: " << algorithm << " \"" << network_config << '\"');
 
     const auto program = [&] {
-        auto program_it = program_map.find(std::make_pair(program_name, params));
-        if(program_it != program_map.end())
+        const auto key = ProgramKey{program_name.native(), params};
         {
-            auto& program = program_it->second;
-
-            if(program_out != nullptr && !program.IsCodeObjectInMemory() &&
-               !program.IsCodeObjectInFile())
-            {
-                // We need the binaries attached to the program.
-                // This may happen if someone calls immediate mode and then find 2.0 with request
-                // for binaries.
-                program = h.LoadProgram(program_name, params, kernel_src, true);
-            }
-
-            return program;
+            const std::shared_lock<std::shared_mutex> lock{mutex};
+            const auto program_it = program_map.find(key);
+            // We need the binaries attached to the program.
+            // This may happen if someone calls immediate mode and then find 2.0 with request
+            // for binaries.
+            if(program_it != program_map.end() &&
+               (program_out == nullptr || program_it->second.IsCodeObjectInMemory() ||
+                program_it->second.IsCodeObjectInFile()))
+                return program_it->second;
         }
-        else
-        {
-            auto program = h.LoadProgram(program_name, params, kernel_src, program_out != nullptr);
 
-            program_map[std::make_pair(program_name, params)] = program;
-            return program;
-        }
+        // Building may take long, so the lock is not held meanwhile. If several threads build
+        // the same program, the last one wins, which matches the behavior of AddProgram.
+        auto program = h.LoadProgram(program_name, params, kernel_src, program_out != nullptr);
+
+        const std::unique_lock<std::shared_mutex> lock{mutex};
+        program_map[InternProgramKey(program_name, params)] = program;
+        return program;
     }();
 
     if(program_out != nullptr)
@@ -149,14 +157,18 @@ Kernel KernelCache::AddKernel(const Handle& h,
 
     if(!network_config.empty() && !algorithm.empty())
     {
-        this->AddKernel(key, kernel, cache_index);
+        this->AddKernel(algorithm, network_config, kernel, cache_index);
     }
     return kernel;
 }
 
-void KernelCache::AddKernel(Key key, Kernel k, std::size_t cache_index)
+void KernelCache::AddKernel(const std::string& algorithm,
+                            const std::string& network_config,
+                            Kernel k,
+                            std::size_t cache_index)
 {
-    auto&& v = kernel_map[key];
+    const std::unique_lock<std::shared_mutex> lock{mutex};
+    auto&& v = kernel_map[InternKernelKey(algorithm, network_config)];
     if(cache_index >= v.size())
     {
         v.resize(cache_index + 1);
@@ -170,11 +182,15 @@ void KernelCache::ClearKernels(const std::string& algorithm, const std::string&
     {
         MIOPEN_THROW("Network config or algorithm empty.");
     }
-    const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
-    auto&& v                                      = this->kernel_map[key];
+    const std::unique_lock<std::shared_mutex> lock{mutex};
+    const auto it = kernel_map.find({algorithm, network_config});
+    if(it == kernel_map.end())
+        return;
+    auto&& v = it->second;
     if(!v.empty())
     {
-        MIOPEN_LOG_I2(v.size() << " kernels for key: " << key.first << " \"" << key.second << '\"');
+        MIOPEN_LOG_I2(v.size() << " kernels for key: " << algorithm << " \"" << network_config
+                               << '\"');
     }
     v.clear();
 }
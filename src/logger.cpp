@@ -27,11 +27,23 @@
 #include <miopen/logger.hpp>
 #include <miopen/config.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <cstdlib>
 #include <chrono>
+#include <fstream>
 #include <ios>
 #include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #ifdef __linux__
 #include <unistd.h>
@@ -65,6 +77,17 @@ MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_ENABLE_LOGGING_ROCTX)
 /// Disable logging quieting.
 MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_LOGGING_QUIETING_DISABLE)
 
+/// Write the log into this file (appending) instead of stderr.
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_LOG_FILE)
+
+/// Queue log records in per-thread buffers and write them from a background thread,
+/// so that logging threads do not wait for the output. Errors are written immediately.
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_LOG_ASYNC)
+
+/// Capacity of each per-thread buffer of MIOPEN_LOG_ASYNC, in records. Records which
+/// do not fit are dropped, and the number of dropped records is logged.
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_LOG_ASYNC_QUEUE_SIZE, 4096)
+
 namespace miopen {
 
 namespace debug {
@@ -116,6 +139,247 @@ inline float GetTimeDiff()
     return rv;
 }
 
+/// Destination of the log records: MIOPEN_LOG_FILE, or stderr if it is not set or can't be
+/// opened.
+class LogTarget
+{
+public:
+    LogTarget()
+    {
+        const auto path = env::value(MIOPEN_LOG_FILE);
+        if(path.empty())
+            return;
+        file.open(path, std::ios::app);
+        if(!file)
+            std::cerr << "MIOpen: Unable to open " << path << ", logging to stderr." << std::endl;
+    }
+
+    template <class Range>
+    void Write(const Range& records)
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        auto& os = file.is_open() ? static_cast<std::ostream&>(file) : std::cerr;
+        for(const auto& record : records)
+            os << record;
+        os.flush();
+    }
+
+private:
+    std::mutex mutex;
+    std::ofstream file;
+};
+
+LogTarget& GetLogTarget()
+{
+    // Leaked on purpose, records can be logged during the static destruction.
+    static auto* const target = new LogTarget{};
+    return *target;
+}
+
+/// Bounded single-producer single-consumer queue of the records of one thread.
+class LogQueue
+{
+public:
+    explicit LogQueue(std::size_t capacity) : slots(std::max<std::size_t>(capacity, 1)) {}
+
+    /// Called by the owning thread only.
+    bool Push(std::uint64_t seq, std::string&& record)
+    {
+        const auto h = head.load(std::memory_order_relaxed);
+        if(h - tail.load(std::memory_order_acquire) == slots.size())
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        auto& slot  = slots[h % slots.size()];
+        slot.seq    = seq;
+        slot.record = std::move(record);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Called by the writer only.
+    template <class F>
+    void Pop(F f)
+    {
+        const auto t = tail.load(std::memory_order_relaxed);
+        const auto h = head.load(std::memory_order_acquire);
+        for(auto i = t; i != h; ++i)
+        {
+            auto& slot = slots[i % slots.size()];
+            f(slot.seq, std::move(slot.record));
+        }
+        tail.store(h, std::memory_order_release);
+    }
+
+    std::uint64_t TakeDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+
+private:
+    struct Slot
+    {
+        std::uint64_t seq = 0;
+        std::string record;
+    };
+
+    std::vector<Slot> slots;
+    std::atomic<std::uint64_t> head{0};
+    std::atomic<std::uint64_t> tail{0};
+    std::atomic<std::uint64_t> dropped{0};
+};
+
+/// Collects the records from the per-thread queues and writes them in the order they were
+/// logged. The queues are drained by a background thread periodically, when one of them
+/// overflows, and by Flush().
+class AsyncLogSink
+{
+public:
+    explicit AsyncLogSink(std::size_t capacity_)
+        : capacity(capacity_), writer([this]() { Run(); })
+    {
+    }
+
+    void Push(std::string record, bool flush)
+    {
+        if(stopped.load(std::memory_order_acquire))
+        {
+            GetLogTarget().Write(std::array<std::string, 1>{std::move(record)});
+            return;
+        }
+
+        const auto pushed =
+            GetQueue().Push(seq.fetch_add(1, std::memory_order_relaxed), std::move(record));
+
+        // Pairs with the fence in Stop(): either the final flush there sees the record, or the
+        // record was pushed after it and is written here.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(flush || stopped.load(std::memory_order_relaxed))
+            Flush();
+        else if(!pushed)
+            cv.notify_one();
+    }
+
+    void Flush()
+    {
+        const std::lock_guard<std::mutex> lock{drain_mutex};
+
+        auto records    = std::vector<std::pair<std::uint64_t, std::string>>{};
+        auto n_dropped  = std::uint64_t{0};
+        const auto take = [&](auto record_seq, auto&& record) {
+            records.emplace_back(record_seq, std::move(record));
+        };
+
+        {
+            const std::lock_guard<std::mutex> queues_lock{queues_mutex};
+            for(auto it = queues.begin(); it != queues.end();)
+            {
+                // A queue referenced only from here belongs to a finished thread,
+                // so it is released after the last drain.
+                const auto finished = it->use_count() == 1;
+                if(finished)
+                    std::atomic_thread_fence(std::memory_order_acquire);
+
+                (*it)->Pop(take);
+                n_dropped += (*it)->TakeDropped();
+                it = finished ? queues.erase(it) : std::next(it);
+            }
+        }
+
+        std::sort(records.begin(), records.end(), [](auto&& l, auto&& r) {
+            return l.first < r.first;
+        });
+
+        auto out = std::vector<std::string>{};
+        out.reserve(records.size() + 1);
+        for(auto& record : records)
+            out.emplace_back(std::move(record.second));
+
+        if(n_dropped != 0)
+        {
+            out.emplace_back(LoggingPrefix() + "Warning [LoggingWrite] " +
+                             std::to_string(n_dropped) +
+                             " log record(s) dropped, consider increasing " +
+                             env::name(MIOPEN_LOG_ASYNC_QUEUE_SIZE) + "\n");
+        }
+
+        if(!out.empty())
+            GetLogTarget().Write(out);
+    }
+
+    void Stop()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            stop = true;
+        }
+        cv.notify_one();
+        writer.join();
+        stopped.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        Flush();
+    }
+
+private:
+    static constexpr auto period = std::chrono::milliseconds{20};
+
+    std::size_t capacity;
+    std::atomic<std::uint64_t> seq{0};
+    std::atomic<bool> stopped{false};
+
+    std::mutex queues_mutex;
+    std::vector<std::shared_ptr<LogQueue>> queues;
+
+    std::mutex drain_mutex;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stop = false;
+    std::thread writer;
+
+    LogQueue& GetQueue()
+    {
+        thread_local const auto queue = [this]() {
+            auto created = std::make_shared<LogQueue>(capacity);
+            const std::lock_guard<std::mutex> lock{queues_mutex};
+            queues.push_back(created);
+            return created;
+        }();
+        return *queue;
+    }
+
+    void Run()
+    {
+        auto lock = std::unique_lock<std::mutex>{mutex};
+        while(!stop)
+        {
+            cv.wait_for(lock, period);
+            lock.unlock();
+            Flush();
+            lock.lock();
+        }
+    }
+};
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<AsyncLogSink*> async_log_sink{nullptr};
+
+AsyncLogSink& GetAsyncLogSink()
+{
+    // Leaked on purpose, records logged after the writer has been stopped at exit are written
+    // directly to the target.
+    static auto* const sink = [] {
+        auto* const created = new AsyncLogSink{env::value(MIOPEN_LOG_ASYNC_QUEUE_SIZE)};
+        async_log_sink.store(created, std::memory_order_release);
+        return created;
+    }();
+
+    static const struct Stopper
+    {
+        ~Stopper() { sink->Stop(); }
+    } stopper;
+
+    return *sink;
+}
+
 } // namespace
 
 bool IsLoggingDebugQuiet()
@@ -197,4 +461,23 @@ std::string LoggingPrefix()
     return ss.str();
 }
 
+void LoggingWrite(std::string record, bool flush)
+{
+    if(env::enabled(MIOPEN_LOG_ASYNC))
+    {
+        GetAsyncLogSink().Push(std::move(record), flush);
+        return;
+    }
+
+    // Records queued before MIOPEN_LOG_ASYNC was disabled go first.
+    LoggingFlush();
+    GetLogTarget().Write(std::array<std::string, 1>{std::move(record)});
+}
+
+void LoggingFlush()
+{
+    if(auto* const sink = async_log_sink.load(std::memory_order_acquire))
+        sink->Flush();
+}
+
 } // namespace miopen
@@ -0,0 +1,55 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/mapped_file.hpp>
+#include <miopen/errors.hpp>
+
+#include <boost/interprocess/exceptions.hpp>
+
+namespace miopen {
+
+MappedFile::MappedFile(const fs::path& path)
+{
+    try
+    {
+        // mapped_region refuses to map zero bytes, an empty file is an empty mapping.
+        if(fs::file_size(path) == 0)
+            return;
+
+        mapping = {path.string().c_str(), boost::interprocess::read_only};
+        region  = {mapping, boost::interprocess::read_only};
+    }
+    catch(const fs::filesystem_error& ex)
+    {
+        MIOPEN_THROW(path.string() + ": " + ex.what());
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        MIOPEN_THROW(path.string() + ": mapping error: " + ex.what());
+    }
+}
+
+} // namespace miopen
@@ -35,6 +35,10 @@
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/trace.hpp>
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
 #include <miopen/hipoc_program.hpp>
 
 #if !MIOPEN_ENABLE_SQLITE_KERN_CACHE
@@ -69,7 +73,12 @@ Handle::Handle() : impl(new HandleImpl())
     MIOPEN_LOG_NQI(*this);
 }
 
-Handle::~Handle() {}
+Handle::~Handle()
+{
+#if MIOPEN_ENABLE_SQLITE
+    SQLite::FlushAll();
+#endif
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t /* streamID */) const {}
 
@@ -185,6 +194,8 @@ Program Handle::LoadProgram(const fs::path& program_name,
 {
     std::ignore = force_attach_binary;
 
+    MIOPEN_TRACE_SCOPE("compile", [&]() { return "LoadProgram " + program_name.string(); });
+
     if(program_name.extension() == ".mlir")
     {
         params += " -mcpu=" + this->GetTargetProperties().Name();
@@ -199,6 +210,7 @@ Program Handle::LoadProgram(const fs::path& program_name,
     p.impl           = pgmImpl;
     if(hsaco.empty())
     {
+        MIOPEN_TRACE_SCOPE("compile", [&]() { return "Build " + program_name.string(); });
         // avoid the constructor since it implicitly calls the HIP API
         pgmImpl->BuildCodeObject(params, kernel_src);
 // auto p = HIPOCProgram{program_name, params, this->GetTargetProperties(), kernel_src};
@@ -45,6 +45,7 @@
 #include <miopen/tensor.hpp>
 #include <miopen/util.hpp>
 #include <miopen/visit_float.hpp>
+#include <miopen/warm_start_db.hpp>
 #include <miopen/datatype.hpp>
 #include <miopen/any_solver.hpp>
 #include <miopen/conv/tensors.hpp>
@@ -89,13 +90,44 @@ static Invoker PrepareInvoker(ExecutionContext ctx,
     ctx.disable_search_enforce = true;
 
     const auto solver = solver_id.GetSolver();
-    auto db           = GetDb(ctx);
-    auto solution     = solver.FindSolution(ctx, problem, db, {}); // auto tune is not expected here
     auto& handle      = ctx.GetStream();
+    const auto algo   = AlgorithmName{solver_id.GetAlgo(problem.GetDirection())};
+
+    // Without perf-db access FindSolution ignores perf_cfg, so a record would be inconsistent.
+    auto* const warm_start_db = ctx.disable_perfdb_access ? nullptr : WarmStartDb::Get(handle);
+    const auto key            = WarmStartDb::Key{config.ToString(), solver_id.ToString()};
+
+    if(warm_start_db != nullptr)
+    {
+        if(const auto record = warm_start_db->Find(key))
+        {
+            try
+            {
+                const auto factory = solver.GetInvokeFactory(ctx, problem, record->perf_cfg);
+                auto invoker       = handle.PrepareInvoker(factory, record->kernels);
+                handle.RegisterInvoker(invoker, config, solver_id.ToString(), algo);
+                MIOPEN_LOG_I2("Invoker restored from the warm start db: " << solver_id.ToString());
+                return invoker;
+            }
+            catch(const miopen::Exception& ex)
+            {
+                MIOPEN_LOG_W("Warm start db record is unusable for " << solver_id.ToString()
+                                                                     << ": " << ex.what());
+            }
+        }
+    }
+
+    auto db = GetDb(ctx);
+    // The config is resolved here to be remembered along with the kernels it has produced.
+    const auto perf_cfg =
+        warm_start_db != nullptr ? solver.GetPerfCfgParams(ctx, problem, db) : std::string{};
+    // auto tune is not expected here
+    auto solution = solver.FindSolution(ctx, problem, db, {}, perf_cfg);
     auto invoker = handle.PrepareInvoker(*solution.invoker_factory, solution.construction_params);
-    const auto algo = AlgorithmName{solver_id.GetAlgo(problem.GetDirection())};
 
     handle.RegisterInvoker(invoker, config, solver_id.ToString(), algo);
+    if(warm_start_db != nullptr && solution.Succeeded())
+        warm_start_db->Store(key, {perf_cfg, solution.construction_params});
     return invoker;
 }
 
@@ -140,21 +172,19 @@ static void ShrinkToFind10Results(std::vector<Solution>& found)
     found = std::move(out);
 }
 
-std::vector<Solution> FindConvolution(const ExecutionContext& ctx,
-                                      const conv::ProblemDescription& problem,
-                                      const AnyInvokeParams& invoke_ctx,
-                                      int requestAlgoCount,
-                                      bool force_attach_binary)
+/// Returns the immediate mode solution when the find mode prefers it over the normal find.
+static boost::optional<Solution> FindImmediate(const ConvolutionFindItem& item)
 {
-    auto results         = std::vector<Solution>{};
-    auto sol             = boost::optional<miopenConvSolution_t>{};
+    const auto& ctx      = item.ctx;
+    const auto& problem  = item.problem;
     const auto& conv     = problem.GetConv();
     const auto& findMode = conv.findMode;
+    auto sol             = boost::optional<miopenConvSolution_t>{};
 
     if(findMode.IsFast(ctx) || findMode.IsHybrid(ctx))
     {
         auto fallback = bool{};
-        auto sols     = conv.GetSolutions(ctx, problem, 1, &fallback, &invoke_ctx);
+        auto sols     = conv.GetSolutions(ctx, problem, 1, &fallback, &item.invoke_ctx);
         // override the normal find with immed mode with env var
         if(!sols.empty() && (!(findMode.IsHybrid(ctx) && fallback) ||
                              env::enabled(MIOPEN_DEBUG_FORCE_IMMED_MODE_FALLBACK)))
@@ -162,31 +192,99 @@ std::vector<Solution> FindConvolution(const ExecutionContext& ctx,
         // In Hybrid Find mode, we use Normal Find instead of Immediate fallback kernels.
     }
 
-    if(sol.has_value())
+    if(!sol.has_value())
+        return boost::none;
+
+    /// It is possible to measure actual execution time and return it to the caller.
+    /// \todo Consider if we need (and want to spend time) for this.
+    const auto id = solver::Id{sol->solution_id};
+    const auto& s = id.GetSolver();
+    CompileSolution(id, ctx, problem);
+    return Solution{id, sol->time, s.GetWorkspaceSize(ctx, problem)};
+}
+
+std::vector<Solution> FindConvolution(const ExecutionContext& ctx,
+                                      const conv::ProblemDescription& problem,
+                                      const AnyInvokeParams& invoke_ctx,
+                                      int requestAlgoCount,
+                                      bool force_attach_binary)
+{
+    const auto items = std::vector<ConvolutionFindItem>{{ctx, problem, invoke_ctx}};
+    return std::move(FindConvolution(items, requestAlgoCount, force_attach_binary).front());
+}
+
+std::vector<std::vector<Solution>> FindConvolution(const std::vector<ConvolutionFindItem>& items,
+                                                   int requestAlgoCount,
+                                                   bool force_attach_binary)
+{
+    auto results = std::vector<std::vector<Solution>>(items.size());
+    auto normal  = std::vector<std::size_t>{};
+
+    for(std::size_t i = 0; i < items.size(); ++i)
     {
-        /// It is possible to measure actual execution time and return it to the caller.
-        /// \todo Consider if we need (and want to spend time) for this.
-        const auto id = solver::Id{sol->solution_id};
-        const auto& s = id.GetSolver();
-        CompileSolution(id, ctx, problem);
-        results.push_back({id, sol->time, s.GetWorkspaceSize(ctx, problem)});
+        if(auto immediate = FindImmediate(items[i]))
+            results[i].push_back(std::move(*immediate));
+        else
+            normal.push_back(i);
     }
-    else
+
+    if(!normal.empty())
     {
-        results = UserFindDbRecord::TryLoad(ctx.GetStream(), problem, [&]() {
-            auto ctx_copy                       = ctx;
-            ctx_copy.use_dynamic_solutions_only = findMode.IsDynamicHybrid(ctx);
-            const auto params =
-                conv::ConvFindParameters{conv.IsWinograd3x3SupportedAndFast(ctx_copy, problem)};
-
-            return FindCore(invoke_ctx,
-                            ctx_copy,
-                            problem,
-                            params,
-                            conv::GetConvSolverFinders(),
-                            std::nullopt,
-                            force_attach_binary);
-        });
+        auto& handle  = items[normal.front()].ctx.GetStream();
+        auto problems = std::vector<conv::ProblemDescription>{};
+        problems.reserve(normal.size());
+        for(const auto i : normal)
+            problems.push_back(items[i].problem);
+
+        // With the warm start db enabled, invokers missing for a find-db record are rebuilt
+        // instead of repeating the whole find.
+        auto prepare = std::function<bool(std::size_t, const std::string&)>{};
+        if(WarmStartDb::Get(handle) != nullptr)
+        {
+            prepare = [&](std::size_t i, const std::string& solver_id) {
+                const auto& item = items[normal[i]];
+                try
+                {
+                    LoadOrPrepareInvoker(item.ctx, item.problem, solver::Id{solver_id});
+                    return true;
+                }
+                catch(const miopen::Exception& ex)
+                {
+                    MIOPEN_LOG_W("Unable to prepare an invoker for " << solver_id << ": "
+                                                                     << ex.what());
+                    return false;
+                }
+            };
+        }
+
+        const auto regenerate = [&](const std::vector<std::size_t>& missing) {
+            auto ctxs   = std::vector<ExecutionContext>{};
+            auto params = std::vector<conv::ConvFindParameters>{};
+            auto tasks  = std::vector<FindCoreTask>{};
+            ctxs.reserve(missing.size());
+            params.reserve(missing.size());
+            tasks.reserve(missing.size());
+
+            for(const auto i : missing)
+            {
+                const auto& item = items[normal[i]];
+                const auto& conv = item.problem.GetConv();
+
+                auto& ctx_copy                      = ctxs.emplace_back(item.ctx);
+                ctx_copy.use_dynamic_solutions_only = conv.findMode.IsDynamicHybrid(item.ctx);
+                const auto& find_params             = params.emplace_back(
+                    conv.IsWinograd3x3SupportedAndFast(ctx_copy, item.problem));
+
+                tasks.push_back({item.invoke_ctx, ctx_copy, item.problem, find_params});
+            }
+
+            return FindCore(
+                tasks, conv::GetConvSolverFinders(), std::nullopt, force_attach_binary);
+        };
+
+        auto loaded = UserFindDbRecord::TryLoadBatch(handle, problems, regenerate, "", prepare);
+        for(std::size_t i = 0; i < normal.size(); ++i)
+            results[normal[i]] = std::move(loaded[i]);
     }
 
     if(env::enabled(MIOPEN_DEBUG_COMPILE_ONLY))
@@ -196,12 +294,15 @@ std::vector<Solution> FindConvolution(const ExecutionContext& ctx,
             "MIOPEN_DEBUG_COMPILE_ONLY is enabled, escaping forward convolution. Search skipped.");
     }
 
-    ShrinkToFind10Results(results);
-    results.resize(std::min<std::size_t>(results.size(), requestAlgoCount));
+    for(std::size_t i = 0; i < items.size(); ++i)
+    {
+        ShrinkToFind10Results(results[i]);
+        results[i].resize(std::min<std::size_t>(results[i].size(), requestAlgoCount));
 
-    for(const auto& entry : results)
-        MIOPEN_LOG_I(entry.GetSolver().GetAlgo(problem.GetDirection())
-                     << "\t" << entry.GetTime() << "\t" << entry.GetWorkspaceSize());
+        for(const auto& entry : results[i])
+            MIOPEN_LOG_I(entry.GetSolver().GetAlgo(items[i].problem.GetDirection())
+                         << "\t" << entry.GetTime() << "\t" << entry.GetWorkspaceSize());
+    }
 
     return results;
 }
@@ -602,8 +703,8 @@ ConvolutionDescriptor::GetSolutionsFallback(const ExecutionContext& ctx,
 #if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
     if(!env::disabled(MIOPEN_DEBUG_ENABLE_AI_IMMED_MODE_FALLBACK))
     {
-        const static std::string arch = ctx.GetStream().GetDeviceName();
-        auto solvers                  = ai::immed_mode::PredictSolver(problem, ctx, arch);
+        const auto arch = ctx.GetStream().GetDeviceName();
+        auto solvers    = ai::immed_mode::PredictSolver(problem, ctx, arch);
         if(!solvers.empty())
         {
             MIOPEN_LOG_I2("Using TunaNet Fallback");
@@ -38,10 +38,15 @@
 #include <miopen/manage_ptr.hpp>
 #include <miopen/ocldeviceinfo.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/trace.hpp>
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
 
 #include <miopen/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
 
+#include <mutex>
 #include <string>
 
 #ifndef _WIN32
@@ -83,6 +88,7 @@ struct HandleImpl
     bool enable_profiling  = false;
     float profiling_result = 0.0;
     TargetProperties target_properties;
+    std::once_flag max_mem_alloc_size_once;
 
     std::string get_device_name() const
     {
@@ -265,7 +271,13 @@ Handle::Handle() : impl(new HandleImpl())
 }
 
 Handle::Handle(Handle&&) noexcept = default;
-Handle::~Handle()                 = default;
+
+Handle::~Handle()
+{
+#if MIOPEN_ENABLE_SQLITE
+    SQLite::FlushAll();
+#endif
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -396,10 +408,13 @@ Program Handle::LoadProgram(const std::string& program_name,
     // Binary serialization is not supported on OpenCL anyway
     std::ignore = force_attach_binary;
 
+    MIOPEN_TRACE_SCOPE("compile", [&]() { return "LoadProgram " + program_name; });
+
     auto hsaco = miopen::LoadBinary(
         this->GetTargetProperties(), this->GetMaxComputeUnits(), program_name, params);
     if(hsaco.empty())
     {
+        MIOPEN_TRACE_SCOPE("compile", [&]() { return "Build " + program_name; });
         CompileTimer ct;
         auto p = miopen::LoadProgram(miopen::GetContext(this->GetStream()),
                                      miopen::GetDevice(this->GetStream()),
@@ -484,9 +499,11 @@ std::ostream& Handle::Print(std::ostream& os) const
 
 std::size_t Handle::GetMaxMemoryAllocSize()
 {
-    if(m_MaxMemoryAllocSizeCached == 0)
+    // Called by IsApplicable() of solvers, which may run concurrently.
+    std::call_once(this->impl->max_mem_alloc_size_once, [&]() {
         m_MaxMemoryAllocSizeCached = miopen::GetDeviceInfo<CL_DEVICE_MAX_MEM_ALLOC_SIZE>(
             miopen::GetDevice(this->GetStream()));
+    });
     return m_MaxMemoryAllocSizeCached;
 }
 
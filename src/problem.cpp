@@ -52,6 +52,9 @@
 
 #include <boost/hof/match.hpp>
 
+#include <algorithm>
+#include <unordered_map>
+
 namespace miopen::debug {
 /// \todo: This should be updated when a separate driver command is implemented
 void LogCmdFindConvolution(const miopen::TensorDescriptor& x,
@@ -124,7 +127,7 @@ static Data_t AllocateTensor(Handle& handle,
                              std::vector<Allocator::ManageDataPtr>& owned,
                              std::vector<std::uint64_t>& owned_scalars,
                              miopenTensorArgumentId_t id,
-                             const TensorDescriptor& descriptor)
+                             std::size_t size)
 {
     const auto preallocated = options.preallocated_tensors.find(id);
 
@@ -134,14 +137,28 @@ static Data_t AllocateTensor(Handle& handle,
     if((id & miopenTensorArgumentIsScalar) == miopenTensorArgumentIsScalar)
         return &owned_scalars.emplace_back(0);
 
-    const auto element_size = get_data_size(descriptor.GetType());
-    auto buffer             = handle.Create(descriptor.GetElementSpace() * element_size);
+    auto buffer = handle.Create(size);
 
     const auto allocated = buffer.get();
     owned.emplace_back(std::move(buffer));
     return allocated;
 }
 
+static std::size_t GetTensorSize(const TensorDescriptor& descriptor)
+{
+    return descriptor.GetElementSpace() * get_data_size(descriptor.GetType());
+}
+
+static Data_t AllocateTensor(Handle& handle,
+                             const FindOptions& options,
+                             std::vector<Allocator::ManageDataPtr>& owned,
+                             std::vector<std::uint64_t>& owned_scalars,
+                             miopenTensorArgumentId_t id,
+                             const TensorDescriptor& descriptor)
+{
+    return AllocateTensor(handle, options, owned, owned_scalars, id, GetTensorSize(descriptor));
+}
+
 static void SortFindResults(const FindOptions& options, std::vector<Solution>& results)
 {
     std::sort(results.begin(),
@@ -203,6 +220,67 @@ Problem::FindSolutions(Handle& handle, const FindOptions& options, std::size_t m
     return ret;
 }
 
+std::vector<std::vector<Solution>>
+Problem::FindSolutions(Handle& handle,
+                       const std::vector<const Problem*>& problems,
+                       const FindOptions& options,
+                       std::size_t max_solutions)
+{
+    auto ret      = std::vector<std::vector<Solution>>(problems.size());
+    auto convs    = std::vector<const Problem*>{};
+    auto conv_ids = std::vector<std::size_t>{};
+
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        if(std::holds_alternative<ConvolutionDescriptor>(problems[i]->operator_descriptor))
+        {
+            convs.push_back(problems[i]);
+            conv_ids.push_back(i);
+        }
+        else
+        {
+            ret[i] = problems[i]->FindSolutions(handle, options, max_solutions);
+        }
+    }
+
+    if(convs.empty())
+        return ret;
+
+    // Find only checks the timings, so the whole batch shares one buffer per argument, sized for
+    // the largest problem.
+    auto sizes = std::unordered_map<miopenTensorArgumentId_t, std::size_t>{};
+    for(const auto* problem : convs)
+    {
+        for(const auto& pair : problem->tensor_descriptors)
+        {
+            auto& size = sizes[pair.first];
+            size       = std::max(size, GetTensorSize(pair.second));
+        }
+    }
+
+    auto owned_buffers = std::vector<Allocator::ManageDataPtr>{};
+    auto owned_scalars = std::vector<std::uint64_t>{};
+    auto buffers       = Buffers{};
+
+    for(const auto& pair : sizes)
+    {
+        buffers.emplace(
+            pair.first,
+            AllocateTensor(handle, options, owned_buffers, owned_scalars, pair.first, pair.second));
+    }
+
+    auto found = FindConvolutionSolutions(handle, convs, options, max_solutions, buffers);
+    owned_buffers.resize(0);
+
+    for(std::size_t i = 0; i < convs.size(); ++i)
+    {
+        SortFindResults(options, found[i]);
+        ret[conv_ids[i]] = std::move(found[i]);
+    }
+
+    return ret;
+}
+
 const TensorDescriptor&
 Problem::GetTensorDescriptorChecked(miopenTensorArgumentId_t name,
                                     [[maybe_unused]] const std::string& name_str) const
@@ -460,37 +538,84 @@ std::vector<Solution> Problem::FindSolutionsImpl(Handle& handle,
                                                  const FindOptions& options,
                                                  std::size_t max_solutions,
                                                  const Buffers& buffers,
-                                                 const ConvolutionDescriptor& conv_desc) const
+                                                 const ConvolutionDescriptor& /*conv_desc*/) const
+{
+    return std::move(FindConvolutionSolutions(handle, {this}, options, max_solutions, buffers)[0]);
+}
+
+std::vector<std::vector<Solution>>
+Problem::FindConvolutionSolutions(Handle& handle,
+                                  const std::vector<const Problem*>& problems,
+                                  const FindOptions& options,
+                                  std::size_t max_solutions,
+                                  const Buffers& buffers)
 {
-    if(tensor_descriptors.size() != 3)
+    struct Searched
     {
-        MIOPEN_THROW(miopenStatusInvalidValue,
-                     "Convolution problem should have exactly three tensor descriptors.");
-    }
+        const Problem* problem;
+        conv::ProblemDescription conv_problem;
+        TensorDescriptor x_desc;
+        TensorDescriptor w_desc;
+        TensorDescriptor y_desc;
+        Data_t x;
+        Data_t w;
+        Data_t y;
+    };
 
-    auto x_desc = GetTensorDescriptorChecked(miopenTensorConvolutionX, "miopenTensorConvolutionX");
-    const auto& w_desc =
-        GetTensorDescriptorChecked(miopenTensorConvolutionW, "miopenTensorConvolutionW");
-    auto y_desc = GetTensorDescriptorChecked(miopenTensorConvolutionY, "miopenTensorConvolutionY");
+    auto searched = std::vector<Searched>{};
+    auto sources  = std::vector<std::size_t>(problems.size());
+    auto configs  = std::unordered_map<std::string, std::size_t>{};
 
-    auto x        = buffers.at(miopenTensorConvolutionX);
-    const auto& w = buffers.at(miopenTensorConvolutionW);
-    auto y        = buffers.at(miopenTensorConvolutionY);
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        const auto& problem   = *problems[i];
+        const auto& conv_desc = std::get<ConvolutionDescriptor>(problem.operator_descriptor);
 
-    const auto conv_problem =
-        conv_desc.mode == miopenTranspose ? MakeTransposed().AsConvolution() : AsConvolution();
+        if(problem.tensor_descriptors.size() != 3)
+        {
+            MIOPEN_THROW(miopenStatusInvalidValue,
+                         "Convolution problem should have exactly three tensor descriptors.");
+        }
 
-    std::size_t workspace_size;
-    Allocator::ManageDataPtr owned_workspace;
-    Data_t workspace;
+        auto x_desc = problem.GetTensorDescriptorChecked(miopenTensorConvolutionX,
+                                                         "miopenTensorConvolutionX");
+        const auto& w_desc = problem.GetTensorDescriptorChecked(miopenTensorConvolutionW,
+                                                                "miopenTensorConvolutionW");
+        auto y_desc = problem.GetTensorDescriptorChecked(miopenTensorConvolutionY,
+                                                         "miopenTensorConvolutionY");
 
-    if(conv_desc.mode == miopenTranspose)
-    {
-        std::swap(x, y);
-        std::swap(x_desc, y_desc);
+        auto x        = buffers.at(miopenTensorConvolutionX);
+        const auto& w = buffers.at(miopenTensorConvolutionW);
+        auto y        = buffers.at(miopenTensorConvolutionY);
+
+        auto conv_problem = conv_desc.mode == miopenTranspose
+                                ? problem.MakeTransposed().AsConvolution()
+                                : problem.AsConvolution();
+
+        if(conv_desc.mode == miopenTranspose)
+        {
+            std::swap(x, y);
+            std::swap(x_desc, y_desc);
+        }
+
+        ValidateGroupCount(x_desc, w_desc, conv_desc);
+
+        // Problems with equal network configs share the find results, so only the first of
+        // them is searched.
+        const auto inserted =
+            configs.emplace(conv_problem.MakeNetworkConfig().ToString(), searched.size());
+        sources[i] = inserted.first->second;
+
+        if(inserted.second)
+        {
+            searched.push_back(
+                {&problem, std::move(conv_problem), x_desc, w_desc, y_desc, x, w, y});
+        }
     }
 
-    ValidateGroupCount(x_desc, w_desc, conv_desc);
+    std::size_t workspace_size;
+    Allocator::ManageDataPtr owned_workspace;
+    Data_t workspace;
 
     if(options.preallocated_workspace)
     {
@@ -499,45 +624,86 @@ std::vector<Solution> Problem::FindSolutionsImpl(Handle& handle,
     }
     else
     {
-        auto tmp_ctx             = ExecutionContext{&handle};
-        const auto workspace_max = conv_desc.GetWorkSpaceSize(tmp_ctx, conv_problem);
-        workspace_size           = std::min(options.workspace_limit, workspace_max);
-        owned_workspace          = workspace_size != 0 ? handle.Create(workspace_size) : nullptr;
-        workspace                = owned_workspace.get();
+        auto tmp_ctx       = ExecutionContext{&handle};
+        auto workspace_max = std::size_t{0};
+        for(const auto& item : searched)
+        {
+            const auto& conv_desc =
+                std::get<ConvolutionDescriptor>(item.problem->operator_descriptor);
+            workspace_max =
+                std::max(workspace_max, conv_desc.GetWorkSpaceSize(tmp_ctx, item.conv_problem));
+        }
+        workspace_size  = std::min(options.workspace_limit, workspace_max);
+        owned_workspace = workspace_size != 0 ? handle.Create(workspace_size) : nullptr;
+        workspace       = owned_workspace.get();
     }
 
-    auto ctx = ExecutionContext{&handle};
-    conv_problem.SetupFloats(ctx);
-    ctx.do_search = options.exhaustive_search;
+    auto ctxs        = std::vector<ExecutionContext>{};
+    auto invoke_ctxs = std::vector<AnyInvokeParams>{};
+    auto items       = std::vector<ConvolutionFindItem>{};
+    ctxs.reserve(searched.size());
+    invoke_ctxs.reserve(searched.size());
+    items.reserve(searched.size());
 
-    const auto invoke_ctx =
-        MakeConvInvokeParams(x_desc, x, w_desc, w, y_desc, y, workspace, workspace_size);
+    for(const auto& item : searched)
+    {
+        auto& ctx = ctxs.emplace_back(&handle);
+        item.conv_problem.SetupFloats(ctx);
+        ctx.do_search = options.exhaustive_search;
+
+        const auto& invoke_ctx = invoke_ctxs.emplace_back(
+            item.problem->MakeConvInvokeParams(item.x_desc,
+                                               item.x,
+                                               item.w_desc,
+                                               item.w,
+                                               item.y_desc,
+                                               item.y,
+                                               workspace,
+                                               workspace_size));
+
+        items.push_back({ctx, item.conv_problem, invoke_ctx});
+    }
 
-    auto results =
-        FindConvolution(ctx, conv_problem, invoke_ctx, max_solutions, options.attach_binaries);
+    auto found = FindConvolution(items, max_solutions, options.attach_binaries);
 
-    for(auto& result : results)
+    for(std::size_t i = 0; i < searched.size(); ++i)
     {
-        result.SetProblem({*this});
+        for(auto& result : found[i])
+        {
+            result.SetProblem({*searched[i].problem});
+
+            if(result.GetKernels().empty())
+            {
+                // If find-db was used binaries and invoker have not been set.
+                // This would make binaries not serialized and invoker not cached.
+                // So we prepare them here.
+
+                auto db                  = GetDb(ctxs[i]);
+                const auto conv_solution = result.GetSolver().GetSolver().FindSolution(
+                    ctxs[i], searched[i].conv_problem, db, invoke_ctxs[i]);
+
+                std::vector<Program> programs;
+                auto invoker = handle.PrepareInvoker(*conv_solution.invoker_factory,
+                                                     conv_solution.construction_params,
+                                                     options.attach_binaries ? &programs : nullptr);
+                result.SetInvoker(std::move(invoker), programs, conv_solution.construction_params);
+            }
+        }
+    }
+
+    auto ret = std::vector<std::vector<Solution>>(problems.size());
 
-        if(result.GetKernels().empty())
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        ret[i] = found[sources[i]];
+        if(searched[sources[i]].problem != problems[i])
         {
-            // If find-db was used binaries and invoker have not been set.
-            // This would make binaries not serialized and invoker not cached.
-            // So we prepare them here.
-
-            auto db = GetDb(ctx);
-            const auto conv_solution =
-                result.GetSolver().GetSolver().FindSolution(ctx, conv_problem, db, invoke_ctx);
-
-            std::vector<Program> programs;
-            auto invoker = handle.PrepareInvoker(*conv_solution.invoker_factory,
-                                                 conv_solution.construction_params,
-                                                 options.attach_binaries ? &programs : nullptr);
-            result.SetInvoker(std::move(invoker), programs, conv_solution.construction_params);
+            for(auto& result : ret[i])
+                result.SetProblem({*problems[i]});
         }
     }
-    return results;
+
+    return ret;
 }
 
 std::vector<Solution>
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/program_cache.hpp>
+#include <miopen/logger.hpp>
+
+#include <chrono>
+#include <exception>
+
+namespace miopen {
+
+ProgramCache& ProgramCache::Global()
+{
+    static auto* const instance = new ProgramCache{}; // NOLINT (cppcoreguidelines-owning-memory)
+    return *instance;
+}
+
+Program
+ProgramCache::GetOrLoad(const Key& key, const void* user, const std::function<Program()>& load)
+{
+    auto promise = std::promise<Program>{};
+    auto load_id = std::size_t{};
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        const auto it = programs.find(key);
+
+        if(it != programs.end())
+        {
+            it->second.users.insert(user);
+            const auto future = it->second.program;
+            const auto ready =
+                future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            ++(ready ? stats.hits : stats.deduplicated);
+            lock.unlock();
+
+            if(!ready)
+                MIOPEN_LOG_I2("Waiting for a concurrent build of " << key.program);
+            return future.get();
+        }
+
+        ++stats.misses;
+        load_id = ++last_load_id;
+        programs.emplace(key, Entry{promise.get_future().share(), load_id, {user}});
+    }
+
+    try
+    {
+        auto program = load();
+        promise.set_value(program);
+        return program;
+    }
+    catch(...)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            // The entry may have been erased and replaced by a newer load while this one was
+            // running.
+            const auto it = programs.find(key);
+            if(it != programs.end() && it->second.load_id == load_id)
+                programs.erase(it);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
+
+void ProgramCache::Release(const void* user)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for(auto it = programs.begin(); it != programs.end();)
+    {
+        auto& users = it->second.users;
+        if(users.erase(user) != 0 && users.empty())
+            it = programs.erase(it);
+        else
+            ++it;
+    }
+}
+
+void ProgramCache::Erase(int device, const fs::path& program, const std::string& options)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    // Source and attach_binary are the last members of the key, so all their variants are adjacent.
+    auto it = programs.lower_bound(Key{device, program, options, {}, false});
+    while(it != programs.end() && it->first.device == device && it->first.program == program &&
+          it->first.options == options)
+        it = programs.erase(it);
+}
+
+void ProgramCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    programs.clear();
+}
+
+ProgramCache::Stats ProgramCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+std::size_t ProgramCache::Size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return programs.size();
+}
+
+} // namespace miopen
@@ -26,20 +26,26 @@
 
 #include <miopen/ramdb.hpp>
 
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/text_db_parser.hpp>
 
 #include <miopen/filesystem.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <fstream>
 #include <limits>
 #include <map>
 #include <mutex>
+#include <shared_mutex>
 #include <sstream>
 
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_RAMDB_READ_MOSTLY)
+
 namespace miopen {
 
 fs::path RamDb::GetTimeFilePath(const fs::path& path) { return path + ".time"; }
@@ -84,29 +90,60 @@ static void UpdateDbModificationTime(const fs::path& path)
 
 static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60}; }
 
+static std::chrono::milliseconds GetReadMostlyValidationInterval()
+{
+    return std::chrono::milliseconds{1000};
+}
+
+static RamDbMode GetDefaultMode()
+{
+    return env::enabled(MIOPEN_RAMDB_READ_MOSTLY) ? RamDbMode::ReadMostly : RamDbMode::Exclusive;
+}
+
 using exclusive_lock = std::unique_lock<LockFile>;
 
 RamDb::RamDb(DbKinds db_kind_, const fs::path& path, bool is_system)
-    : PlainTextDb(db_kind_, path, is_system)
+    : RamDb(db_kind_, path, is_system, GetDefaultMode())
+{
+}
+
+RamDb::RamDb(DbKinds db_kind_, const fs::path& path, bool is_system, RamDbMode mode_)
+    : PlainTextDb(db_kind_, path, is_system), mode(mode_)
 {
 }
 
 RamDb& RamDb::GetCached(DbKinds db_kind_, const fs::path& path, bool is_system)
 {
-    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static std::mutex mutex;
-    const std::lock_guard<std::mutex> lock{mutex};
+    return GetCached(db_kind_, path, is_system, GetDefaultMode());
+}
 
+RamDb& RamDb::GetCached(DbKinds db_kind_, const fs::path& path, bool is_system, RamDbMode mode_)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::shared_mutex mutex;
     // We don't have to store kind to properly index as different dbs would have different paths
     // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
     static auto instances = std::map<fs::path, std::unique_ptr<RamDb>>{};
-    const auto it         = instances.find(path);
+
+    // Instances are never removed, so the common case of an existing instance only needs
+    // a shared lock and does not serialize concurrent lookups.
+    {
+        const std::shared_lock<std::shared_mutex> lock{mutex};
+        const auto it = instances.find(path);
+
+        if(it != instances.end())
+            return *it->second;
+    }
+
+    const std::unique_lock<std::shared_mutex> lock{mutex};
+    const auto it = instances.find(path);
 
     if(it != instances.end())
         return *it->second;
 
     auto& instance =
-        *instances.emplace(path, std::make_unique<RamDb>(db_kind_, path, is_system)).first->second;
+        *instances.emplace(path, std::make_unique<RamDb>(db_kind_, path, is_system, mode_))
+             .first->second;
     if constexpr(!DisableUserDbFileIO)
     {
         const auto prefetch_lock = exclusive_lock(instance.GetLockFile(), GetLockTimeout());
@@ -118,6 +155,12 @@ RamDb& RamDb::GetCached(DbKinds db_kind_, const fs::path& path, bool is_system)
 
 boost::optional<DbRecord> RamDb::FindRecord(const std::string& problem)
 {
+    if(mode == RamDbMode::ReadMostly)
+    {
+        RevalidateIfDue();
+        return FindRecordUnsafe(problem);
+    }
+
     const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
 
@@ -153,6 +196,32 @@ bool RamDb::StoreRecord(const DbRecord& record)
     return true;
 }
 
+bool RamDb::StoreRecords(const std::vector<DbRecord>& records)
+{
+    MIOPEN_LOG_I2("Trying to store " << records.size() << " records in cache for file "
+                                     << GetFileName());
+    const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+
+    if constexpr(!DisableUserDbFileIO)
+    {
+        auto ok = true;
+        for(const auto& record : records)
+            ok = StoreRecordUnsafe(record) && ok;
+        if(!ok)
+            return false;
+        UpdateDbModificationTime(GetFileName());
+    }
+
+#if MIOPEN_DB_CACHE_WRITE_THROUGH
+    for(const auto& record : records)
+        UpdateCacheEntryUnsafe(record);
+#else
+    Prefetch();
+#endif
+    return true;
+}
+
 bool RamDb::UpdateRecord(DbRecord& record)
 {
     const auto& key = record.GetKey();
@@ -197,7 +266,7 @@ bool RamDb::RemoveRecord(const std::string& key)
 #if MIOPEN_DB_CACHE_WRITE_THROUGH
     if(is_valid)
     {
-        cache.erase(key);
+        cache.Erase(key);
         file_read_time = ramdb_clock::now();
     }
 #else
@@ -235,14 +304,13 @@ bool RamDb::Remove(const std::string& key, const std::string& id)
     {
         if(record->GetSize() == 0)
         {
-            cache.erase(key);
+            cache.Erase(key);
         }
         else
         {
-            auto it = cache.find(key);
             auto ss = std::ostringstream{};
             record->WriteIdsAndValues(ss);
-            it->second.content = ss.str();
+            cache.Set(key, ss.str());
         }
 
         file_read_time = ramdb_clock::now();
@@ -257,20 +325,23 @@ bool RamDb::Remove(const std::string& key, const std::string& id)
 boost::optional<miopen::DbRecord> RamDb::FindRecordUnsafe(const std::string& problem)
 {
     MIOPEN_LOG_I2("Looking for key " << problem << " in cache for file " << GetFileName());
-    const auto it = cache.find(problem);
 
-    if(it == cache.end())
-        return boost::none;
+    auto record    = DbRecord{problem};
+    auto is_parsed = false;
 
-    auto record = DbRecord{problem};
+    const auto found = cache.Visit(problem, [&](const CacheItem& item) {
+        is_parsed = record.ParseContents(item.content);
 
-    if(!record.ParseContents(it->second.content))
-    {
-        MIOPEN_LOG_E("Error parsing payload under the key: "
-                     << problem << " form file " << GetFileName() << "#" << it->second.line);
-        MIOPEN_LOG_E("Contents: " << it->second.content);
+        if(!is_parsed)
+        {
+            MIOPEN_LOG_E("Error parsing payload under the key: "
+                         << problem << " form file " << GetFileName() << "#" << item.line);
+            MIOPEN_LOG_E("Contents: " << item.content);
+        }
+    });
+
+    if(!found || !is_parsed)
         return boost::none;
-    }
 
     return record;
 }
@@ -279,7 +350,7 @@ template <class TFunc>
 static void Measure(const std::string& funcName, TFunc&& func)
 {
     if(!miopen::IsLogging(LoggingLevel::Info))
-        func();
+        return func();
 
     const auto start = std::chrono::high_resolution_clock::now();
     func();
@@ -292,7 +363,7 @@ bool RamDb::ValidateUnsafe()
     if(DisableUserDbFileIO)
         return true;
     if(!fs::exists(GetFileName()))
-        return cache.empty();
+        return cache.Empty();
     const auto file_mod_time     = GetDbModificationTime(GetFileName());
     const auto validation_result = file_mod_time < file_read_time;
     MIOPEN_LOG_I2("DB file is " << (validation_result ? "older" : "newer")
@@ -317,35 +388,43 @@ void RamDb::Prefetch()
             return;
         }
 
-        cache.clear();
-        auto line   = std::string{};
-        auto n_line = 0;
+        auto items = ParseTextDb<std::map<std::string, CacheItem>>(
+            ReadTextDb(file), [&](int n_line) {
+                MIOPEN_LOG_E("Ill-formed record: key not found: " << GetFileName() << "#"
+                                                                  << n_line);
+            });
 
-        while(std::getline(file, line))
-        {
-            ++n_line;
+        cache.Assign(std::move(items));
+        file_read_time = ramdb_clock::now();
+        next_validation =
+            (file_read_time + GetReadMostlyValidationInterval()).time_since_epoch().count();
+    });
+}
 
-            if(line.empty())
-                continue;
+void RamDb::RevalidateIfDue()
+{
+    if constexpr(DisableUserDbFileIO)
+        return;
 
-            const auto key_size = line.find('=');
-            const bool is_key   = (key_size != std::string::npos && key_size != 0);
+    const auto now = ramdb_clock::now();
+    auto due       = next_validation.load(std::memory_order_relaxed);
 
-            if(!is_key)
-            {
-                MIOPEN_LOG_E("Ill-formed record: key not found: " << GetFileName() << "#"
-                                                                  << n_line);
-                continue;
-            }
+    if(now.time_since_epoch().count() < due)
+        return;
 
-            const auto key      = line.substr(0, key_size);
-            const auto contents = line.substr(key_size + 1);
+    // Only one thread checks the file, the rest keep reading the current cache meanwhile.
+    const auto next = (now + GetReadMostlyValidationInterval()).time_since_epoch().count();
+    if(!next_validation.compare_exchange_strong(due, next))
+        return;
 
-            cache.emplace(key, CacheItem{n_line, contents});
-        }
+    const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
 
-        file_read_time = ramdb_clock::now();
-    });
+    if(!ValidateUnsafe())
+    {
+        MIOPEN_LOG_I2("RamDb file is newer than cache, prefetching");
+        Prefetch();
+    }
 }
 
 #if MIOPEN_DB_CACHE_WRITE_THROUGH
@@ -358,23 +437,56 @@ void RamDb::UpdateCacheEntryUnsafe(const DbRecord& record)
 
     if(is_valid)
     {
-        const auto& key = record.GetKey();
-        const auto it   = cache.find(key);
-        auto ss         = std::ostringstream{};
+        auto ss = std::ostringstream{};
         record.WriteIdsAndValues(ss);
-
-        if(it != cache.end())
-        {
-            auto& item   = it->second;
-            item.content = ss.str();
-        }
-        else
-        {
-            cache.emplace(key, CacheItem{-1, ss.str()});
-        }
+        cache.Set(record.GetKey(), ss.str());
         file_read_time = ramdb_clock::now();
     }
 }
 #endif
 
+bool RamDb::ShardedCache::Empty() const
+{
+    return std::all_of(shards.begin(), shards.end(), [](const Shard& shard) {
+        const auto lock = std::shared_lock<std::shared_mutex>{shard.mutex};
+        return shard.items.empty();
+    });
+}
+
+void RamDb::ShardedCache::Set(const std::string& key, std::string content)
+{
+    auto& shard     = GetShard(key);
+    const auto lock = std::unique_lock<std::shared_mutex>{shard.mutex};
+    const auto it   = shard.items.find(key);
+
+    if(it != shard.items.end())
+        it->second.content = std::move(content);
+    else
+        shard.items.emplace(key, CacheItem{-1, std::move(content)});
+}
+
+void RamDb::ShardedCache::Erase(const std::string& key)
+{
+    auto& shard     = GetShard(key);
+    const auto lock = std::unique_lock<std::shared_mutex>{shard.mutex};
+    shard.items.erase(key);
+}
+
+void RamDb::ShardedCache::Assign(std::map<std::string, CacheItem> items)
+{
+    auto distributed = std::array<std::map<std::string, CacheItem>, ShardCount>{};
+
+    while(!items.empty())
+    {
+        auto node = items.extract(items.begin());
+        distributed[GetShardIndex(node.key())].insert(std::move(node));
+    }
+
+    for(auto i = 0u; i < ShardCount; ++i)
+    {
+        const auto lock = std::unique_lock<std::shared_mutex>{shards[i].mutex};
+        shards[i].items.swap(distributed[i]);
+    }
+}
+
 } // namespace miopen
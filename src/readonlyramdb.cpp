@@ -25,9 +25,11 @@
  *******************************************************************************/
 
 #include <miopen/readonlyramdb.hpp>
+#include <miopen/env.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/filesystem.hpp>
+#include <miopen/text_db_parser.hpp>
 
 #if MIOPEN_EMBED_DB
 #include <miopen_data.hpp>
@@ -38,6 +40,8 @@
 #include <sstream>
 #include <map>
 
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_DISABLE_SYSDB_IMAGE)
+
 namespace miopen {
 
 namespace debug {
@@ -91,39 +95,72 @@ static auto Measure(const std::string& funcName, TFunc&& func)
                                    << " ms");
 }
 
-void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream, bool warn_if_unreadable)
+void ReadonlyRamDb::ParseAndLoadDb(std::string_view text)
+{
+    cache = ParseTextDb<std::unordered_map<std::string, CacheItem>>(text, [&](int n_line) {
+        MIOPEN_LOG_E("Ill-formed record: key not found: " << db_path << "#" << n_line);
+    });
+}
+
+const std::unordered_map<std::string, ReadonlyRamDb::CacheItem>&
+ReadonlyRamDb::GetCacheMap() const
 {
-    if(!input_stream)
+    if(!IsMapped())
+        return cache;
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    if(cache.empty())
     {
-        const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB) ? LoggingLevel::Warning
-                                                                             : LoggingLevel::Info;
-        MIOPEN_LOG(log_level, "File is unreadable: " << db_path);
-        return;
+        for(auto i = 0u; i < image.Count(); ++i)
+        {
+            const auto item = image.Get(i);
+            cache.emplace(std::string{item.key}, CacheItem{item.line, std::string{item.content}});
+        }
     }
 
-    auto line   = std::string{};
-    auto n_line = 0;
+    return cache;
+}
 
-    while(std::getline(input_stream, line))
-    {
-        ++n_line;
+bool ReadonlyRamDb::TryMapImage()
+{
+    if(env::enabled(MIOPEN_DEBUG_DISABLE_SYSDB_IMAGE))
+        return false;
 
-        if(line.empty())
-            continue;
+    const auto image_path = fs::path{db_path + rodb::Extension};
+    if(!fs::exists(image_path))
+        return false;
 
-        const auto key_size = line.find('=');
-        const bool is_key   = (key_size != std::string::npos && key_size != 0);
+    try
+    {
+        auto file       = MappedFile{image_path};
+        const auto view = rodb::ImageView{file.Data(), file.Size()};
 
-        if(!is_key)
+        if(!view.IsValid())
         {
-            MIOPEN_LOG_E("Ill-formed record: key not found: " << db_path << "#" << n_line);
-            continue;
+            MIOPEN_LOG_W("Ill-formed db image, falling back to the text db: " << image_path);
+            return false;
         }
 
-        const auto key      = line.substr(0, key_size);
-        const auto contents = line.substr(key_size + 1);
+        // The text db may be updated in place without rebuilding the image.
+        if(fs::exists(db_path) && fs::file_size(db_path) != view.GetHeader().source_size)
+        {
+            MIOPEN_LOG_W("Db image does not match the text db, ignored: " << image_path);
+            return false;
+        }
 
-        cache.emplace(key, CacheItem{n_line, contents});
+        // Moving the mapping keeps its address, so the view stays valid.
+        image_file = std::move(file);
+        image      = view;
+        MIOPEN_LOG_I2("Mapped db image: " << image_path << ", records: " << image.Count());
+        return true;
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to map db image, falling back to the text db: " << ex.what());
+        return false;
     }
 }
 
@@ -147,14 +184,25 @@ void ReadonlyRamDb::Prefetch(bool warn_if_unreadable)
             const auto& p = it_p->second;
             ptrdiff_t sz  = p.second - p.first;
             MIOPEN_LOG_I2("Loading In Memory file: " << filepath);
-            auto input_stream = std::stringstream(std::string(p.first, sz));
-            ParseAndLoadDb(input_stream, warn_if_unreadable);
+            ParseAndLoadDb({p.first, static_cast<std::size_t>(sz)});
 #endif
         }
         else
         {
+            if(TryMapImage())
+                return;
+
             auto input_stream = std::ifstream{db_path};
-            ParseAndLoadDb(input_stream, warn_if_unreadable);
+            if(!input_stream)
+            {
+                const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
+                                           ? LoggingLevel::Warning
+                                           : LoggingLevel::Info;
+                MIOPEN_LOG(log_level, "File is unreadable: " << db_path);
+                return;
+            }
+
+            ParseAndLoadDb(ReadTextDb(input_stream));
         }
     });
 }
@@ -30,6 +30,7 @@
 #include <miopen/check_numerics.hpp>
 #include <miopen/conv/data_invoke_params.hpp>
 #include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/env.hpp>
 #include <miopen/kernel.hpp>
 
 #include <miopen/mha/invoke_params.hpp>
@@ -45,6 +46,11 @@
 #include "miopen/fusion/problem_description.hpp"
 #include "miopen/fusion/context.hpp"
 
+#include <cstring>
+#include <fstream>
+
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_SAVE_SOLUTION_AS_BINARY)
+
 namespace miopen::debug {
 // Todo: This should be updated when a separate driver command is implemented
 void LogCmdConvolution(const miopen::TensorDescriptor& x,
@@ -717,20 +723,53 @@ struct SerializedSolutionKernelInfo
     }
 };
 
-void to_json(nlohmann::json& json, const Solution& solution)
+/// Calls f(data, size) with the code object of the program.
+template <class F>
+static void VisitCodeObject(const Program& program, F&& f)
+{
+    if(program.IsCodeObjectInMemory())
+    {
+        // With disabled cache programs after build would be attached as a char vector. Same for
+        // the sqlite cache.
+
+        const auto& chars = program.GetCodeObjectBlob();
+        f(chars.data(), chars.size());
+    }
+    else if(program.IsCodeObjectInFile())
+    {
+        // Programs that have been loaded from file cache are internally interpreted
+        // as read from file with a correct path.
+
+        const auto path = program.GetCodeObjectPathname();
+        auto file       = std::ifstream(path, std::ios::binary | std::ios::ate);
+        if(!file)
+            MIOPEN_THROW(miopenStatusInternalError, "Unable to open code object " + path);
+        auto chars = std::vector<char>(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0, std::ios::beg);
+        if(!file.read(chars.data(), chars.size()))
+            MIOPEN_THROW(miopenStatusInternalError, "Unable to read code object " + path);
+        f(chars.data(), chars.size());
+    }
+    else
+    {
+        MIOPEN_THROW(miopenStatusInternalError);
+    }
+}
+
+void Solution::ToJson(nlohmann::json& json, std::vector<Program>& programs) const
 {
     json = nlohmann::json{
         {fields::Header, Solution::SerializationMetadata::Current()},
-        {fields::Time, solution.time},
-        {fields::Workspace, solution.workspace_required},
-        {fields::Solver, solution.solver.ToString()},
-        {fields::Problem, solution.problem},
+        {fields::Time, time},
+        {fields::Workspace, workspace_required},
+        {fields::Solver, solver.ToString()},
+        {fields::Problem, problem},
     };
 
-    if(solution.perf_cfg.has_value())
-        json[fields::PerfCfg] = *solution.perf_cfg;
+    if(perf_cfg.has_value())
+        json[fields::PerfCfg] = *perf_cfg;
 
-    if(solution.kernels.empty())
+    if(kernels.empty())
     {
         MIOPEN_LOG_I2("Solution lacks kernels information. This would slowdown the first "
                       "miopenRunSolution call after miopenLoadSolution.");
@@ -738,17 +777,16 @@ void to_json(nlohmann::json& json, const Solution& solution)
     }
 
     {
-        const auto& first_program = solution.kernels.front().program;
+        const auto& first_program = kernels.front().program;
         if(!first_program.IsCodeObjectInMemory() && !first_program.IsCodeObjectInFile())
             MIOPEN_THROW(miopenStatusInvalidValue,
                          "Subsequent serialization of a deserialized solution is not supported.");
     }
 
-    auto programs         = std::vector<Program>{};
     auto prepared_kernels = std::vector<SerializedSolutionKernelInfo>{};
 
-    std::transform(solution.kernels.begin(),
-                   solution.kernels.end(),
+    std::transform(kernels.begin(),
+                   kernels.end(),
                    std::back_inserter(programs),
                    [](const Solution::KernelInfo& sol) { return sol.program; });
 
@@ -756,7 +794,7 @@ void to_json(nlohmann::json& json, const Solution& solution)
     std::sort(programs.begin(), programs.end(), sorter);
     programs.erase(std::unique(programs.begin(), programs.end()), programs.end());
 
-    for(const auto& kernel : solution.kernels)
+    for(const auto& kernel : kernels)
     {
         const auto program_it        = std::find(programs.begin(), programs.end(), kernel.program);
         auto prepared_kernel         = SerializedSolutionKernelInfo{};
@@ -769,47 +807,48 @@ void to_json(nlohmann::json& json, const Solution& solution)
     }
 
     json[fields::Kernels] = prepared_kernels;
-    auto programs_json    = nlohmann::json{};
+}
 
-    for(const auto& program : programs)
+void Solution::SetKernels(const nlohmann::json& json, const std::vector<Program>& programs)
+{
+    auto kernel_infos = json.at(fields::Kernels).get<std::vector<SerializedSolutionKernelInfo>>();
+    kernels.clear();
+    kernels.reserve(kernel_infos.size());
+
+    for(auto&& serialized_kernel_info : kernel_infos)
     {
-        auto binary = nlohmann::json::binary_t{};
+        const auto program = serialized_kernel_info.program;
+        if(program < 0 || static_cast<std::size_t>(program) >= programs.size())
+            MIOPEN_THROW(miopenStatusInvalidValue, "Invalid program index in a solution.");
+
+        auto kernel_info             = Solution::KernelInfo{};
+        kernel_info.program          = programs[program];
+        kernel_info.local_work_dims  = std::move(serialized_kernel_info.local_work_dims);
+        kernel_info.global_work_dims = std::move(serialized_kernel_info.global_work_dims);
+        kernel_info.kernel_name      = std::move(serialized_kernel_info.kernel_name);
+        kernel_info.program_name     = std::move(serialized_kernel_info.program_name);
+        kernels.emplace_back(std::move(kernel_info));
+    }
+}
 
-        if(program.IsCodeObjectInMemory())
-        {
-            // With disabled cache programs after build would be attached as a char vector. Same for
-            // the sqlite cache.
+void to_json(nlohmann::json& json, const Solution& solution)
+{
+    auto programs = std::vector<Program>{};
+    solution.ToJson(json, programs);
 
-            const auto& chars = program.GetCodeObjectBlob();
-            binary.resize(chars.size());
-            std::memcpy(binary.data(), chars.data(), chars.size());
+    if(programs.empty())
+        return;
 
-            MIOPEN_LOG_I2("Serialized binary to solution blob, " << chars.size() << " bytes");
-        }
-        else if(program.IsCodeObjectInFile())
-        {
-            // Programs that have been loaded from file cache are internally interpreted
-            // as read from file with a correct path.
-
-            using Iterator      = std::istream_iterator<uint8_t>;
-            constexpr auto mode = std::ios::binary | std::ios::ate;
-            const auto path     = program.GetCodeObjectPathname();
-            auto file           = std::ifstream(path, mode);
-            const auto filesize = file.tellg();
-
-            file.unsetf(std::ios::skipws);
-            file.seekg(0, std::ios::beg);
-            binary.reserve(filesize);
-            binary.insert(binary.begin(), Iterator{file}, Iterator{});
-
-            MIOPEN_LOG_I2("Serialized binary to solution blob, " << std::to_string(filesize)
-                                                                 << " bytes");
-        }
-        else
-        {
-            MIOPEN_THROW(miopenStatusInternalError);
-        }
+    auto programs_json = nlohmann::json{};
 
+    for(const auto& program : programs)
+    {
+        auto binary = nlohmann::json::binary_t{};
+        VisitCodeObject(program, [&](const char* data, std::size_t size) {
+            binary.resize(size);
+            std::memcpy(binary.data(), data, size);
+        });
+        MIOPEN_LOG_I2("Serialized binary to solution blob, " << binary.size() << " bytes");
         programs_json.emplace_back(std::move(binary));
     }
 
@@ -848,7 +887,7 @@ void from_json(const nlohmann::json& json, Solution& solution)
     solution.kernels.clear();
     if(const auto binaries_json = json.find(fields::Binaries); binaries_json != json.end())
     {
-        auto programs = std::vector<HIPOCProgram>{};
+        auto programs = std::vector<Program>{};
 
         for(const auto& bin : *binaries_json)
         {
@@ -857,20 +896,161 @@ void from_json(const nlohmann::json& json, Solution& solution)
             programs.emplace_back(HIPOCProgram{"", binary});
         }
 
-        auto kernel_infos =
-            json.at(fields::Kernels).get<std::vector<SerializedSolutionKernelInfo>>();
-        solution.kernels.reserve(kernel_infos.size());
+        solution.SetKernels(json, programs);
+    }
+}
+
+namespace binary_format {
+
+/// Layout of the binary form of a solution:
+///   Header
+///   CodeObject[Header::code_objects]
+///   description of the solution without code objects, json encoded as msgpack
+///   code objects, each at an offset aligned to CodeObjectAlignment
+///
+/// Offsets are counted from the beginning of the buffer, integers are in the native byte order.
+/// Code objects are stored as is, so a mapped file may be passed to miopenLoadSolution.
+
+constexpr char Magic[8]                   = {'M', 'I', 'O', 'S', 'O', 'L', 'N', '\0'};
+constexpr std::uint32_t Version           = 1;
+constexpr std::size_t CodeObjectAlignment = 64;
+
+struct Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t code_objects;
+    std::uint64_t description_offset;
+    std::uint64_t description_size;
+};
 
-        for(auto&& serialized_kernel_info : kernel_infos)
+struct CodeObject
+{
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+} // namespace binary_format
+
+std::vector<std::uint8_t> Solution::Save() const
+{
+    if(!env::enabled(MIOPEN_SAVE_SOLUTION_AS_BINARY))
+        return nlohmann::json::to_msgpack(nlohmann::json(*this));
+
+    auto programs = std::vector<Program>{};
+    auto json     = nlohmann::json{};
+    ToJson(json, programs);
+    const auto description = nlohmann::json::to_msgpack(json);
+
+    auto header = binary_format::Header{};
+    std::memcpy(header.magic, binary_format::Magic, sizeof(binary_format::Magic));
+    header.version            = binary_format::Version;
+    header.code_objects       = static_cast<std::uint32_t>(programs.size());
+    header.description_offset =
+        sizeof(header) + programs.size() * sizeof(binary_format::CodeObject);
+    header.description_size = description.size();
+
+    auto code_objects = std::vector<binary_format::CodeObject>{};
+    auto out          = std::vector<std::uint8_t>(header.description_offset);
+    out.insert(out.end(), description.begin(), description.end());
+
+    for(const auto& program : programs)
+    {
+        VisitCodeObject(program, [&](const char* data, std::size_t size) {
+            const auto offset = (out.size() + binary_format::CodeObjectAlignment - 1) /
+                                binary_format::CodeObjectAlignment *
+                                binary_format::CodeObjectAlignment;
+            out.resize(offset);
+            out.insert(out.end(), data, data + size);
+            code_objects.push_back({offset, size});
+        });
+        MIOPEN_LOG_I2("Serialized binary to solution blob, " << code_objects.back().size
+                                                             << " bytes");
+    }
+
+    std::memcpy(out.data(), &header, sizeof(header));
+    if(!code_objects.empty())
+    {
+        std::memcpy(out.data() + sizeof(header),
+                    code_objects.data(),
+                    code_objects.size() * sizeof(binary_format::CodeObject));
+    }
+    return out;
+}
+
+Solution Solution::Load(const char* data, std::size_t size)
+{
+    try
+    {
+        return LoadUnsafe(data, size);
+    }
+    catch(const nlohmann::json::exception& ex)
+    {
+        MIOPEN_THROW(miopenStatusInvalidValue,
+                     std::string{"Invalid buffer has been passed to the solution deserialization: "} +
+                         ex.what());
+    }
+}
+
+Solution Solution::LoadUnsafe(const char* data, std::size_t size)
+{
+    auto header = binary_format::Header{};
+    if(size < sizeof(header) ||
+       std::memcmp(data, binary_format::Magic, sizeof(binary_format::Magic)) != 0)
+    {
+        // The msgpack encoded json, the only format before the binary one was introduced.
+        return nlohmann::json::from_msgpack(data, data + size).get<Solution>();
+    }
+
+    // The buffer is not required to be aligned.
+    std::memcpy(&header, data, sizeof(header));
+    if(header.version != binary_format::Version)
+    {
+        MIOPEN_THROW(miopenStatusVersionMismatch,
+                     "Data from wrong version has been passed to the solution deserialization.");
+    }
+
+    const auto in_bounds = [&](std::uint64_t offset, std::uint64_t length) {
+        return offset <= size && length <= size - offset;
+    };
+    const auto table_size =
+        static_cast<std::uint64_t>(header.code_objects) * sizeof(binary_format::CodeObject);
+    if(!in_bounds(sizeof(header), table_size) ||
+       !in_bounds(header.description_offset, header.description_size))
+    {
+        MIOPEN_THROW(miopenStatusInvalidValue,
+                     "Invalid buffer has been passed to the solution deserialization.");
+    }
+
+    const auto description = data + header.description_offset;
+    const auto json =
+        nlohmann::json::from_msgpack(description, description + header.description_size);
+    auto solution = json.get<Solution>();
+
+    if(header.code_objects == 0)
+        return solution;
+
+    auto programs = std::vector<Program>{};
+    programs.reserve(header.code_objects);
+    for(auto i = 0u; i < header.code_objects; ++i)
+    {
+        auto code_object = binary_format::CodeObject{};
+        std::memcpy(&code_object,
+                    data + sizeof(header) + i * sizeof(binary_format::CodeObject),
+                    sizeof(code_object));
+        if(!in_bounds(code_object.offset, code_object.size))
         {
-            auto kernel_info             = Solution::KernelInfo{};
-            kernel_info.program          = programs[serialized_kernel_info.program];
-            kernel_info.local_work_dims  = std::move(serialized_kernel_info.local_work_dims);
-            kernel_info.global_work_dims = std::move(serialized_kernel_info.global_work_dims);
-            kernel_info.kernel_name      = std::move(serialized_kernel_info.kernel_name);
-            kernel_info.program_name     = std::move(serialized_kernel_info.program_name);
-            solution.kernels.emplace_back(std::move(kernel_info));
+            MIOPEN_THROW(miopenStatusInvalidValue,
+                         "Invalid buffer has been passed to the solution deserialization.");
         }
+
+        const auto begin = reinterpret_cast<const std::uint8_t*>(data) + code_object.offset;
+        MIOPEN_LOG_I2("Derializing binary from solution blob, " << code_object.size << " bytes");
+        programs.emplace_back(
+            HIPOCProgram{"", std::vector<std::uint8_t>(begin, begin + code_object.size)});
     }
+
+    solution.SetKernels(json, programs);
+    return solution;
 }
 } // namespace miopen
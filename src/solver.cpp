@@ -46,9 +46,14 @@
 #include <miopen/env.hpp>
 #include <miopen/solver_id.hpp>
 #include <miopen/par_for.hpp>
+#include <miopen/program_cache.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/any_solver.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/trace.hpp>
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
 
 #include <boost/range/adaptor/transformed.hpp>
 #include <ostream>
@@ -72,6 +77,7 @@ std::ostream& operator<<(std::ostream& os, const KernelInfo& k)
 std::vector<Program>
 PrecompileKernels(const Handle& h, const std::vector<KernelInfo>& kernels, bool force_attach_binary)
 {
+    MIOPEN_TRACE_SCOPE("compile", "PrecompileKernels");
     CompileTimer ct;
     std::vector<Program> programs(kernels.size());
 
@@ -84,6 +90,15 @@ PrecompileKernels(const Handle& h, const std::vector<KernelInfo>& kernels, bool
                     });
     // clang-format on
     ct.Log("PrecompileKernels");
+#if MIOPEN_ENABLE_SQLITE
+    // The kernels are not built again by the other processes.
+    SQLite::FlushAll();
+#endif
+
+    const auto stats = ProgramCache::Global().GetStats();
+    MIOPEN_LOG_I2("Shared program cache: " << stats.hits << " hit(s), " << stats.misses
+                                           << " miss(es), " << stats.deduplicated
+                                           << " deduplicated build(s)");
     return programs;
 }
 
@@ -41,21 +41,141 @@
 
 #include <memory>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <cstdio>
+#include <exception>
 #include <fstream>
 #include <ios>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 extern "C" {
 int miopen_sqlite3_memvfs_init(sqlite3* db, char** pzErrMsg, const sqlite3_api_routines* pApi);
 }
 namespace miopen {
 
-class SQLite::impl
+namespace {
+
+/// Connection with a write batch, see WriteBatchFlusher.
+class BatchedConnection
+{
+public:
+    /// Commits the batch unless it is being written to or, if not \p force, it is younger
+    /// than the time window.
+    virtual void FlushIdle(bool force) noexcept = 0;
+
+protected:
+    ~BatchedConnection() = default;
+};
+
+/// Commits the batches which are not written to any more. Otherwise a batch would keep the
+/// database locked for the other processes until the next write to the same connection, which
+/// may be at exit. Only runs if batching is enabled.
+class WriteBatchFlusher
+{
+public:
+    WriteBatchFlusher() : flusher([this]() { Run(); }) {}
+
+    /// The batches are checked at least twice per the shortest time window of the connections.
+    void Add(BatchedConnection* connection, std::chrono::milliseconds window)
+    {
+        {
+            const std::lock_guard<std::mutex> lock{connections_mutex};
+            connections.push_back(connection);
+        }
+        const auto connection_period = std::max(window / 2, std::chrono::milliseconds{10});
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            if(connection_period >= period)
+                return;
+            period = connection_period;
+        }
+        cv.notify_one();
+    }
+
+    /// The connection is not flushed any more once this returns.
+    void Remove(BatchedConnection* connection)
+    {
+        const std::lock_guard<std::mutex> lock{connections_mutex};
+        connections.erase(std::remove(connections.begin(), connections.end(), connection),
+                          connections.end());
+    }
+
+    void Flush(bool force)
+    {
+        const std::lock_guard<std::mutex> lock{connections_mutex};
+        for(auto* connection : connections)
+            connection->FlushIdle(force);
+    }
+
+    void Stop()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            stop = true;
+        }
+        cv.notify_one();
+        flusher.join();
+    }
+
+private:
+    std::mutex connections_mutex;
+    std::vector<BatchedConnection*> connections;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::chrono::milliseconds period = std::chrono::milliseconds::max();
+    bool stop                        = false;
+    std::thread flusher;
+
+    void Run()
+    {
+        auto lock = std::unique_lock<std::mutex>{mutex};
+        while(!stop)
+        {
+            if(period == std::chrono::milliseconds::max())
+                cv.wait(lock);
+            else
+                cv.wait_for(lock, period);
+            lock.unlock();
+            Flush(false);
+            lock.lock();
+        }
+    }
+};
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<WriteBatchFlusher*> write_batch_flusher{nullptr};
+
+WriteBatchFlusher& GetWriteBatchFlusher()
+{
+    // Leaked on purpose, the connections closed at exit may outlive the thread. They commit
+    // their batches themselves.
+    static auto* const instance = [] {
+        auto* const created = new WriteBatchFlusher{};
+        write_batch_flusher.store(created, std::memory_order_release);
+        return created;
+    }();
+
+    static const struct Stopper
+    {
+        ~Stopper() { instance->Stop(); }
+    } stopper;
+
+    return *instance;
+}
+
+} // namespace
+
+class SQLite::impl : public BatchedConnection
 {
     struct SQLiteCloser
     {
@@ -185,10 +305,139 @@ public:
         isValid = (rc == 0);
         if(isValid)
             sqlite3_busy_timeout(ptrDb.get(), MIOPEN_SQL_BUSY_TIMEOUT_MS);
+        if(isValid && !is_system)
+        {
+            batch_size   = env::value(MIOPEN_DEBUG_SQLITE_WRITE_BATCH_SIZE);
+            batch_window =
+                std::chrono::milliseconds{env::value(MIOPEN_DEBUG_SQLITE_WRITE_BATCH_MS)};
+            if(batch_size > 1)
+            {
+                flusher = &GetWriteBatchFlusher();
+                flusher->Add(this, batch_window);
+            }
+        }
+    }
+
+    impl(const impl&) = delete;
+    impl& operator=(const impl&) = delete;
+
+    ~impl()
+    {
+        if(flusher != nullptr)
+            flusher->Remove(this);
+        try
+        {
+            const std::lock_guard<std::mutex> lock{batch_mutex};
+            Commit();
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_E("Unable to flush pending database writes: " << ex.what());
+        }
+    }
+
+    void BeginWrite(const SQLite& sql)
+    {
+        if(batch_size <= 1)
+            return;
+        const std::lock_guard<std::mutex> lock{batch_mutex};
+        if(!inTransaction)
+        {
+            sql.Exec("BEGIN IMMEDIATE;");
+            inTransaction = true;
+            batch_start   = std::chrono::steady_clock::now();
+        }
+        ++writers;
+    }
+
+    void EndWrite(bool failed)
+    {
+        if(batch_size <= 1)
+            return;
+        const std::lock_guard<std::mutex> lock{batch_mutex};
+        --writers;
+        if(!inTransaction)
+            return;
+
+        if(failed && sqlite3_get_autocommit(ptrDb.get()) != 0)
+        {
+            // Some errors make SQLite roll back the whole transaction.
+            MIOPEN_LOG_W("Failed write rolled back " << pending << " pending database write(s)");
+            inTransaction = false;
+            pending       = 0;
+            return;
+        }
+        if(!failed)
+            ++pending;
+
+        // The last one of the concurrent writers commits.
+        if(writers == 0 &&
+           (failed || pending >= batch_size ||
+            std::chrono::steady_clock::now() - batch_start >= batch_window))
+            Commit();
+    }
+
+    void FlushIdle(bool force) noexcept override
+    {
+        // The background flush doesn't wait for the writers.
+        auto lock = force ? std::unique_lock<std::mutex>{batch_mutex}
+                          : std::unique_lock<std::mutex>{batch_mutex, std::try_to_lock};
+        if(!lock.owns_lock() || !inTransaction || writers != 0)
+            return;
+        if(!force && std::chrono::steady_clock::now() - batch_start < batch_window)
+            return;
+
+        // The statements may be used by the other threads at the moment, so they are not reset.
+        // Statements which only read don't prevent the commit.
+        if(sqlite3_exec(ptrDb.get(), "COMMIT;", nullptr, nullptr, nullptr) != SQLITE_OK)
+        {
+            MIOPEN_LOG_I2("Unable to commit pending database writes, will retry: "
+                          << sqlite3_errmsg(ptrDb.get()));
+            return;
+        }
+        MIOPEN_LOG_I2("Committed " << pending << " idle database write(s)");
+        inTransaction = false;
+        pending       = 0;
+    }
+
+    /// Requires batch_mutex.
+    void Commit()
+    {
+        if(!inTransaction)
+            return;
+        // A transaction can't be committed while any of its statements is still running.
+        for(auto& stmt : statements)
+            stmt.second.Reset();
+        inTransaction = false;
+        pending       = 0;
+
+        const auto c_filename = sqlite3_db_filename(ptrDb.get(), "main");
+        const auto filename_  = fs::path{(c_filename == nullptr) ? "" : c_filename};
+        const auto rc         = SQLite::Retry(
+            [&]() { return sqlite3_exec(ptrDb.get(), "COMMIT;", nullptr, nullptr, nullptr); },
+            filename_);
+        if(rc != SQLITE_OK)
+        {
+            const std::string err_msg = sqlite3_errmsg(ptrDb.get());
+            sqlite3_exec(ptrDb.get(), "ROLLBACK;", nullptr, nullptr, nullptr);
+            MIOPEN_THROW(miopenStatusInternalError, "SQLite commit error: " + err_msg);
+        }
     }
 
     sqlite3_ptr ptrDb = nullptr;
     bool isValid;
+    // Declared after ptrDb to be finalized before the connection is closed.
+    std::unordered_map<std::string, Statement> statements;
+    std::uint64_t batch_size = 1;
+    std::chrono::milliseconds batch_window{0};
+    std::chrono::steady_clock::time_point batch_start;
+    std::uint64_t pending = 0;
+    bool inTransaction    = false;
+    /// Guards the batch, which is also committed by the flusher.
+    std::mutex batch_mutex;
+    /// Writes which have begun but not ended.
+    std::uint64_t writers       = 0;
+    WriteBatchFlusher* flusher = nullptr;
 };
 
 static int find_callback(void* _res, int argc, char** argv, char** azColName)
@@ -275,6 +524,60 @@ int SQLite::Retry(std::function<int()> f) const
 
 int SQLite::Changes() const { return sqlite3_changes(pImpl->ptrDb.get()); }
 
+int64_t SQLite::LastInsertRowId() const { return sqlite3_last_insert_rowid(pImpl->ptrDb.get()); }
+
+SQLite::Statement& SQLite::CachedStatement(const std::string& query,
+                                           const std::vector<std::string>& vals) const
+{
+    auto it = pImpl->statements.find(query);
+    if(it == pImpl->statements.end())
+        it = pImpl->statements.emplace(query, Statement{*this, query}).first;
+    else
+        it->second.Reset();
+
+    auto& stmt = it->second;
+    for(std::size_t i = 0; i < vals.size(); ++i)
+        stmt.BindText(static_cast<int>(i) + 1, vals[i]);
+    if(!vals.empty())
+        MIOPEN_LOG_I2("[" << JoinStrings(vals, ",") << "]");
+    return stmt;
+}
+
+SQLite::WriteGuard::WriteGuard(const SQLite& sql_)
+    : sql(sql_), exceptions(std::uncaught_exceptions())
+{
+    if(sql.pImpl != nullptr)
+        sql.pImpl->BeginWrite(sql);
+}
+
+SQLite::WriteGuard::~WriteGuard()
+{
+    if(sql.pImpl == nullptr)
+        return;
+    try
+    {
+        sql.pImpl->EndWrite(std::uncaught_exceptions() > exceptions);
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E("Unable to commit pending database writes: " << ex.what());
+    }
+}
+
+void SQLite::Flush() const
+{
+    if(pImpl == nullptr)
+        return;
+    const std::lock_guard<std::mutex> lock{pImpl->batch_mutex};
+    pImpl->Commit();
+}
+
+void SQLite::FlushAll() noexcept
+{
+    if(auto* const flusher = write_batch_flusher.load(std::memory_order_acquire))
+        flusher->Flush(true);
+}
+
 std::string SQLite::ErrorMessage() const
 {
     std::string errMsg = "Internal error while accessing SQLite database: ";
@@ -385,6 +688,12 @@ int SQLite::Statement::BindInt64(int idx, const int64_t num)
     return 0;
 }
 
+void SQLite::Statement::Reset()
+{
+    sqlite3_reset(pImpl->ptrStmt.get());
+    sqlite3_clear_bindings(pImpl->ptrStmt.get());
+}
+
 SQLitePerfDb::SQLitePerfDb(DbKinds db_kind, const fs::path& filename_, bool is_system_)
     : SQLiteBase(db_kind, filename_, is_system_)
 {
@@ -0,0 +1,274 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/trace.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h> /* For SYS_xxx definitions */
+#endif
+
+/// Record the host-side spans (API calls, Find stages, compilation, db access, tuning) and
+/// write them into this file in the Chrome trace event format at exit.
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_TRACE_FILE)
+
+/// Maximum number of spans kept per thread. Further spans are dropped, and the number of
+/// dropped spans is logged when the trace is written.
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_TRACE_MAX_EVENTS, 1048576)
+
+namespace miopen {
+
+namespace debug {
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+MIOPEN_EXPORT bool tracing_enabled = false;
+
+} // namespace debug
+
+namespace {
+
+inline int GetProcessId()
+{
+#ifdef __linux__
+    return getpid();
+#else
+    return 0; // Not implemented.
+#endif
+}
+
+/// The same id as printed by MIOPEN_ENABLE_LOGGING_MPMT, so that spans can be matched
+/// with the log records.
+inline int GetThreadId()
+{
+#ifdef __linux__
+    return syscall(SYS_gettid); // NOLINT
+#else
+    static std::atomic<int> next{0};
+    return next++;
+#endif
+}
+
+struct TraceEvent
+{
+    const char* category;
+    std::string name;
+    trace::Clock::time_point start;
+    trace::Clock::duration duration;
+};
+
+/// Spans of one thread. The mutex is only contended while the trace is being written.
+struct TraceBuffer
+{
+    explicit TraceBuffer(int tid_) : tid(tid_) {}
+
+    const int tid;
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+    std::size_t dropped = 0;
+};
+
+class TraceRegistry
+{
+public:
+    static TraceRegistry& Get()
+    {
+        // Leaked on purpose, spans can be recorded during the static destruction.
+        static auto* const registry = new TraceRegistry{};
+        return *registry;
+    }
+
+    TraceBuffer& GetThreadBuffer()
+    {
+        thread_local TraceBuffer* buffer = nullptr;
+        if(buffer == nullptr)
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            buffer = buffers.emplace_back(std::make_unique<TraceBuffer>(GetThreadId())).get();
+        }
+        return *buffer;
+    }
+
+    template <class F>
+    void ForEachBuffer(F f)
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        for(const auto& buffer : buffers)
+        {
+            const std::lock_guard<std::mutex> buffer_lock{buffer->mutex};
+            f(*buffer);
+        }
+    }
+
+    const std::size_t max_events = env::value(MIOPEN_TRACE_MAX_EVENTS);
+
+private:
+    std::mutex mutex;
+    // Buffers of the exited threads are kept, their spans are still to be written.
+    std::vector<std::unique_ptr<TraceBuffer>> buffers;
+};
+
+void WriteJsonString(std::ostream& os, const char* str)
+{
+    os << '"';
+    for(; *str != '\0'; ++str)
+    {
+        const auto c = *str;
+        switch(c)
+        {
+        case '"': os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if(static_cast<unsigned char>(c) < 0x20)
+                os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                   << static_cast<int>(c) << std::dec << std::setfill(' ');
+            else
+                os << c;
+        }
+    }
+    os << '"';
+}
+
+double ToMicroseconds(trace::Clock::duration d)
+{
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+/// Writes the trace to MIOPEN_TRACE_FILE at exit.
+class TraceFileWriter
+{
+public:
+    TraceFileWriter() : path(env::value(MIOPEN_TRACE_FILE)) {}
+    TraceFileWriter(const TraceFileWriter&) = delete;
+    TraceFileWriter& operator=(const TraceFileWriter&) = delete;
+
+    ~TraceFileWriter()
+    {
+        if(path.empty())
+            return;
+        auto file = std::ofstream{path};
+        if(!file)
+        {
+            MIOPEN_LOG_E("Unable to open trace file " << path);
+            return;
+        }
+        trace::Write(file);
+    }
+
+private:
+    std::string path;
+};
+
+const TraceFileWriter trace_file_writer; // NOLINT (cert-err58-cpp)
+
+} // namespace
+
+bool IsTracing()
+{
+    static const bool enabled = !env::value(MIOPEN_TRACE_FILE).empty();
+    return enabled || debug::tracing_enabled;
+}
+
+namespace trace {
+
+void Record(const char* category, std::string name, Clock::time_point start, Clock::time_point end)
+{
+    auto& registry = TraceRegistry::Get();
+    auto& buffer   = registry.GetThreadBuffer();
+    const std::lock_guard<std::mutex> lock{buffer.mutex};
+    if(buffer.events.size() >= registry.max_events)
+    {
+        ++buffer.dropped;
+        return;
+    }
+    buffer.events.push_back({category, std::move(name), start, end - start});
+}
+
+void Write(std::ostream& os)
+{
+    auto& registry = TraceRegistry::Get();
+
+    // Timestamps are relative to the first span.
+    auto origin = Clock::time_point::max();
+    registry.ForEachBuffer([&](const TraceBuffer& buffer) {
+        for(const auto& event : buffer.events)
+            origin = std::min(origin, event.start);
+    });
+
+    const auto pid       = GetProcessId();
+    auto dropped         = std::size_t{0};
+    auto first           = true;
+    const auto flags     = os.flags();
+    const auto precision = os.precision();
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    os << std::fixed << std::setprecision(3);
+    registry.ForEachBuffer([&](const TraceBuffer& buffer) {
+        dropped += buffer.dropped;
+        for(const auto& event : buffer.events)
+        {
+            os << (first ? "\n" : ",\n") << "{\"ph\":\"X\",\"cat\":";
+            WriteJsonString(os, event.category);
+            os << ",\"name\":";
+            WriteJsonString(os, event.name.c_str());
+            os << ",\"ts\":" << ToMicroseconds(event.start - origin)
+               << ",\"dur\":" << ToMicroseconds(event.duration) << ",\"pid\":" << pid
+               << ",\"tid\":" << buffer.tid << "}";
+            first = false;
+        }
+    });
+    os << "\n]}\n";
+    os.flags(flags);
+    os.precision(precision);
+
+    if(dropped > 0)
+        MIOPEN_LOG_W(dropped << " trace span(s) dropped, increase MIOPEN_TRACE_MAX_EVENTS.");
+}
+
+void Clear()
+{
+    TraceRegistry::Get().ForEachBuffer([](TraceBuffer& buffer) {
+        buffer.events.clear();
+        buffer.dropped = 0;
+    });
+}
+
+} // namespace trace
+
+} // namespace miopen
@@ -0,0 +1,257 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/warm_start_db.hpp>
+
+#include <miopen/db.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/logger.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <system_error>
+
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_ENABLE_WARM_START_DB)
+
+namespace miopen {
+
+namespace fields {
+inline constexpr const char* NetworkConfig = "network_config";
+inline constexpr const char* Solver        = "solver";
+inline constexpr const char* PerfCfg       = "perf_cfg";
+inline constexpr const char* Kernels       = "kernels";
+namespace kernels {
+inline constexpr const char* Name           = "name";
+inline constexpr const char* File           = "file";
+inline constexpr const char* CompOptions    = "comp_options";
+inline constexpr const char* LocalWorkDims  = "local_work_dims";
+inline constexpr const char* GlobalWorkDims = "global_work_dims";
+} // namespace kernels
+} // namespace fields
+
+WarmStartDb::WarmStartDb(const fs::path& path_) : path(path_) {}
+
+WarmStartDb* WarmStartDb::Get(const Handle& handle)
+{
+    if(DisableUserDbFileIO || !env::enabled(MIOPEN_ENABLE_WARM_START_DB) ||
+       GetUserDbPath().empty())
+        return nullptr;
+
+    const auto path = GetUserDbPath() /
+                      (handle.GetDbBasename() + '.' + GetUserDbSuffix() + ".uwdb.txt");
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::map<fs::path, std::unique_ptr<WarmStartDb>> instances;
+
+    const auto lock = std::lock_guard<std::mutex>{mutex};
+    auto& instance  = instances[path];
+    if(!instance)
+        instance = std::make_unique<WarmStartDb>(path);
+    return instance.get();
+}
+
+std::optional<WarmStartRecord> WarmStartDb::Find(const Key& key)
+{
+    const auto lock = std::lock_guard<std::mutex>{mutex};
+    LoadUnsafe();
+
+    const auto it = records.find(key);
+    if(it == records.end())
+        return std::nullopt;
+    return it->second;
+}
+
+void WarmStartDb::Store(const Key& key, const WarmStartRecord& record)
+{
+    const auto line = Serialize(key, record);
+
+    const auto lock = std::lock_guard<std::mutex>{mutex};
+    LoadUnsafe();
+
+    const auto it = records.find(key);
+    if(it != records.end() && Serialize(it->first, it->second) == line)
+        return;
+    records[key] = record;
+
+    const auto directory = path.parent_path();
+    if(!fs::exists(directory))
+    {
+        if(!fs::create_directories(directory))
+            MIOPEN_LOG_W("Unable to create a directory: " << directory);
+        else
+            fs::permissions(directory, FS_ENUM_PERMS_ALL);
+    }
+
+    auto& lock_file       = LockFile::Get(LockFilePath(path));
+    const auto file_lock  = std::unique_lock<LockFile>(lock_file, std::chrono::seconds{60});
+    if(!file_lock)
+    {
+        MIOPEN_LOG_W("Warm start db lock has failed to lock: " << path);
+        return;
+    }
+
+    auto file = std::ofstream{path, std::ios::app};
+    if(!(file << line << std::endl))
+        MIOPEN_LOG_W("Unable to write to the warm start db: " << path);
+}
+
+void WarmStartDb::LoadUnsafe()
+{
+    if(loaded)
+        return;
+    loaded = true;
+
+    // Exclusive, as the file may be compacted below.
+    auto& lock_file      = LockFile::Get(LockFilePath(path));
+    const auto file_lock = std::unique_lock<LockFile>(lock_file, std::chrono::seconds{60});
+    if(!file_lock)
+    {
+        MIOPEN_LOG_W("Warm start db lock has failed to lock: " << path);
+        return;
+    }
+
+    auto file = std::ifstream{path};
+    if(!file)
+        return;
+
+    auto line    = std::string{};
+    auto n_line  = 0;
+    auto n_lines = std::size_t{0};
+    while(std::getline(file, line))
+    {
+        ++n_line;
+        if(line.empty())
+            continue;
+        ++n_lines;
+
+        auto key    = Key{};
+        auto record = WarmStartRecord{};
+        if(!Deserialize(line, key, record))
+        {
+            MIOPEN_LOG_W(path << "#" << n_line << ": Ill-formed record, ignored.");
+            continue;
+        }
+        records[std::move(key)] = std::move(record);
+    }
+
+    MIOPEN_LOG_I2("Warm start db loaded: " << path << ", " << records.size() << " records");
+
+    // Records are only appended, so rewrite the file once most of its lines are superseded.
+    file.close();
+    if(n_lines > 2 * records.size())
+        CompactUnsafe();
+}
+
+void WarmStartDb::CompactUnsafe()
+{
+    const auto tmp_path = fs::path{path.string() + ".tmp"};
+    {
+        auto file = std::ofstream{tmp_path, std::ios::trunc};
+        for(const auto& record : records)
+            file << Serialize(record.first, record.second) << '\n';
+        if(!file.flush())
+        {
+            MIOPEN_LOG_W("Unable to compact the warm start db: " << path);
+            return;
+        }
+    }
+
+    auto error = std::error_code{};
+    fs::rename(tmp_path, path, error);
+    if(error)
+    {
+        MIOPEN_LOG_W("Unable to compact the warm start db: " << path << ", " << error.message());
+        fs::remove(tmp_path, error);
+        return;
+    }
+
+    MIOPEN_LOG_I2("Warm start db compacted: " << path << ", " << records.size() << " records");
+}
+
+std::string WarmStartDb::Serialize(const Key& key, const WarmStartRecord& record)
+{
+    auto kernels = nlohmann::json::array();
+    for(const auto& kernel : record.kernels)
+    {
+        kernels.push_back({
+            {fields::kernels::Name, kernel.kernel_name},
+            {fields::kernels::File, kernel.kernel_file.string()},
+            {fields::kernels::CompOptions, kernel.comp_options},
+            {fields::kernels::LocalWorkDims, kernel.l_wk},
+            {fields::kernels::GlobalWorkDims, kernel.g_wk},
+        });
+    }
+
+    const auto json = nlohmann::json{
+        {fields::NetworkConfig, key.first},
+        {fields::Solver, key.second},
+        {fields::PerfCfg, record.perf_cfg},
+        {fields::Kernels, std::move(kernels)},
+    };
+    return json.dump();
+}
+
+bool WarmStartDb::Deserialize(const std::string& line, Key& key, WarmStartRecord& record)
+{
+    const auto json = nlohmann::json::parse(line, nullptr, false);
+    if(json.is_discarded())
+        return false;
+
+    try
+    {
+        json.at(fields::NetworkConfig).get_to(key.first);
+        json.at(fields::Solver).get_to(key.second);
+        json.at(fields::PerfCfg).get_to(record.perf_cfg);
+
+        record.kernels.clear();
+        for(const auto& kernel_json : json.at(fields::Kernels))
+        {
+            auto kernel        = solver::KernelInfo{};
+            kernel.kernel_name = kernel_json.at(fields::kernels::Name).get<std::string>();
+            kernel.kernel_file = kernel_json.at(fields::kernels::File).get<std::string>();
+            kernel_json.at(fields::kernels::CompOptions).get_to(kernel.comp_options);
+            kernel_json.at(fields::kernels::LocalWorkDims).get_to(kernel.l_wk);
+            kernel_json.at(fields::kernels::GlobalWorkDims).get_to(kernel.g_wk);
+            record.kernels.emplace_back(std::move(kernel));
+        }
+    }
+    catch(const nlohmann::json::exception&)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace miopen
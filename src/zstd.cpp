@@ -0,0 +1,160 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/zstd.hpp>
+
+#if MIOPEN_USE_ZSTD
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <zdict.h>
+#include <zstd.h>
+#include <zstd_errors.h>
+
+namespace miopen {
+
+struct ZstdDictionary::Impl
+{
+    ZSTD_CDict* cdict = nullptr;
+    ZSTD_DDict* ddict = nullptr;
+};
+
+namespace {
+
+void check_zstd_error(std::size_t e, const std::string& name)
+{
+    if(ZSTD_isError(e) != 0)
+        throw std::runtime_error(name + " failed: " + ZSTD_getErrorName(e));
+}
+
+/// Contexts are reused by the calls of a thread, creating them is as costly as a small
+/// (de)compression.
+ZSTD_CCtx* GetCompressionContext()
+{
+    thread_local const auto ctx =
+        std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>{ZSTD_createCCtx(), ZSTD_freeCCtx};
+    if(ctx == nullptr)
+        throw std::runtime_error("ZSTD_createCCtx failed: out of memory!");
+    return ctx.get();
+}
+
+ZSTD_DCtx* GetDecompressionContext()
+{
+    thread_local const auto ctx =
+        std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>{ZSTD_createDCtx(), ZSTD_freeDCtx};
+    if(ctx == nullptr)
+        throw std::runtime_error("ZSTD_createDCtx failed: out of memory!");
+    return ctx.get();
+}
+
+} // namespace
+
+ZstdDictionary::ZstdDictionary(const std::vector<char>& data, int level)
+    : impl(std::make_unique<Impl>())
+{
+    impl->cdict = ZSTD_createCDict(data.data(), data.size(), level);
+    impl->ddict = ZSTD_createDDict(data.data(), data.size());
+    if(impl->cdict == nullptr || impl->ddict == nullptr)
+    {
+        ZSTD_freeCDict(impl->cdict);
+        ZSTD_freeDDict(impl->ddict);
+        throw std::runtime_error("ZSTD_createCDict failed: bad dictionary");
+    }
+}
+
+ZstdDictionary::~ZstdDictionary()
+{
+    ZSTD_freeCDict(impl->cdict);
+    ZSTD_freeDDict(impl->ddict);
+}
+
+std::vector<char>
+zstd_compress(const std::vector<char>& v, int level, const ZstdDictionary* dict, bool* compressed)
+{
+    if(v.empty())
+        throw std::runtime_error("ZSTD_compress failed: nothing to compress");
+
+    // Incompressible data is reported instead of growing it.
+    auto result = std::vector<char>(v.size());
+    auto* ctx   = GetCompressionContext();
+    const auto len =
+        dict != nullptr
+            ? ZSTD_compress_usingCDict(
+                  ctx, result.data(), result.size(), v.data(), v.size(), dict->impl->cdict)
+            : ZSTD_compressCCtx(ctx, result.data(), result.size(), v.data(), v.size(), level);
+    if(compressed != nullptr && ZSTD_isError(len) != 0 &&
+       ZSTD_getErrorCode(len) == ZSTD_error_dstSize_tooSmall)
+    {
+        *compressed = false;
+        return v;
+    }
+    check_zstd_error(len, "ZSTD_compress");
+    result.resize(len);
+    if(compressed != nullptr)
+        *compressed = true;
+    return result;
+}
+
+std::vector<char>
+zstd_decompress(const std::vector<char>& v, std::size_t size, const ZstdDictionary* dict)
+{
+    auto result = std::vector<char>(size);
+    auto* ctx   = GetDecompressionContext();
+    const auto len =
+        dict != nullptr
+            ? ZSTD_decompress_usingDDict(
+                  ctx, result.data(), result.size(), v.data(), v.size(), dict->impl->ddict)
+            : ZSTD_decompressDCtx(ctx, result.data(), result.size(), v.data(), v.size());
+    check_zstd_error(len, "ZSTD_decompress");
+    result.resize(len);
+    return result;
+}
+
+std::vector<char> zstd_train_dictionary(const std::vector<std::vector<char>>& samples,
+                                        std::size_t max_size)
+{
+    auto buffer = std::vector<char>{};
+    auto sizes  = std::vector<std::size_t>{};
+    for(const auto& sample : samples)
+    {
+        buffer.insert(buffer.end(), sample.begin(), sample.end());
+        sizes.push_back(sample.size());
+    }
+
+    auto dict      = std::vector<char>(max_size);
+    const auto len = ZDICT_trainFromBuffer(
+        dict.data(), dict.size(), buffer.data(), sizes.data(), static_cast<unsigned>(sizes.size()));
+    if(ZDICT_isError(len) != 0)
+        return {};
+    dict.resize(len);
+    return dict;
+}
+
+} // namespace miopen
+
+#endif // MIOPEN_USE_ZSTD
@@ -27,20 +27,29 @@
 #define GUARD_CPU_CONV_HPP
 
 #include "test.hpp"
+#include <algorithm>
 #include <array>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <miopen/env.hpp>
 #include <miopen/miopen.h>
 #include <miopen/tensor.hpp>
+#include <numeric>
 #include <utility>
+#include <vector>
 
 #include "tensor_holder.hpp"
 #include <miopen/stringutils.hpp>
 #include <miopen/functional.hpp>
 #include <hip_float8.hpp>
 
+/// Algorithm of the CPU reference convolutions: "direct" (default) keeps the accumulation
+/// order of "naive" and so gives bit-identical results, "fast" reorders it for speed.
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_DEBUG_TEST_CPU_CONV_ALGO)
+
 template <class T, class... Ts>
 static constexpr auto make_array(T x, Ts... xs)
 {
@@ -79,15 +88,15 @@ template <std::size_t ConvDim,
           typename Twei,
           typename Tout,
           typename Range>
-void cpu_convolution_forward_impl(const tensor<Tin>& in,
-                                  const tensor<Twei>& wei,
-                                  tensor<Tout>& out,
-                                  const Range& pads,
-                                  const Range& strides,
-                                  const Range& dilations,
-                                  std::size_t group_count,
-                                  FI fi = {},
-                                  FW fw = {})
+void cpu_convolution_forward_naive(const tensor<Tin>& in,
+                                   const tensor<Twei>& wei,
+                                   tensor<Tout>& out,
+                                   const Range& pads,
+                                   const Range& strides,
+                                   const Range& dilations,
+                                   std::size_t group_count,
+                                   FI fi = {},
+                                   FW fw = {})
 {
     static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
     assert(in.desc.GetNumDims() == ConvDim + 2 and wei.desc.GetNumDims() == ConvDim + 2 and
@@ -201,15 +210,15 @@ template <std::size_t ConvDim,
           typename Twei,
           typename Tout,
           typename Range>
-void cpu_convolution_backward_data_impl(tensor<Tin>& in,
-                                        const tensor<Twei>& wei,
-                                        const tensor<Tout>& out,
-                                        const Range& pads,
-                                        const Range& strides,
-                                        const Range& dilations,
-                                        std::size_t group_count,
-                                        FW fw = {},
-                                        FO fo = {})
+void cpu_convolution_backward_data_naive(tensor<Tin>& in,
+                                         const tensor<Twei>& wei,
+                                         const tensor<Tout>& out,
+                                         const Range& pads,
+                                         const Range& strides,
+                                         const Range& dilations,
+                                         std::size_t group_count,
+                                         FW fw = {},
+                                         FO fo = {})
 {
     static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
     assert(in.desc.GetNumDims() == ConvDim + 2 and wei.desc.GetNumDims() == ConvDim + 2 and
@@ -295,15 +304,15 @@ template <std::size_t ConvDim,
           typename Twei,
           typename Tout,
           typename Range>
-void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
-                                          tensor<Twei>& wei,
-                                          const tensor<Tout>& out,
-                                          const Range& pads,
-                                          const Range& strides,
-                                          const Range& dilations,
-                                          std::size_t group_count,
-                                          FI fi,
-                                          FO fo)
+void cpu_convolution_backward_weight_naive(const tensor<Tin>& in,
+                                           tensor<Twei>& wei,
+                                           const tensor<Tout>& out,
+                                           const Range& pads,
+                                           const Range& strides,
+                                           const Range& dilations,
+                                           std::size_t group_count,
+                                           FI fi,
+                                           FO fo)
 {
     static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
     assert(in.desc.GetNumDims() == ConvDim + 2 and wei.desc.GetNumDims() == ConvDim + 2 and
@@ -375,6 +384,617 @@ void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
         });
 }
 
+namespace cpu_conv_detail {
+
+enum class algo
+{
+    naive,  // one output element at a time through the tensor multi-index accessors
+    direct, // same accumulation order as naive, with precomputed offsets
+    fast,   // reordered accumulation with contiguous inner loops over K or C
+};
+
+inline algo get_algo()
+{
+    const auto name = miopen::env::value(MIOPEN_DEBUG_TEST_CPU_CONV_ALGO);
+    if(name.empty() || name == "direct")
+        return algo::direct;
+    if(name == "naive")
+        return algo::naive;
+    if(name == "fast")
+        return algo::fast;
+    MIOPEN_THROW("Unknown " + miopen::env::name(MIOPEN_DEBUG_TEST_CPU_CONV_ALGO) + " value: " +
+                 name);
+}
+
+// Lengths and strides of a [N, C, spatial...] tensor, in the logical order of its
+// lengths, so offsets are valid for any layout including NHWC.
+template <std::size_t ConvDim>
+struct conv_tensor_desc
+{
+    std::size_t n_stride;
+    std::size_t c_stride;
+    std::array<std::size_t, ConvDim> lens{};
+    std::array<std::size_t, ConvDim> strides{};
+
+    explicit conv_tensor_desc(const miopen::TensorDescriptor& desc)
+        : n_stride(desc.GetStrides()[0]), c_stride(desc.GetStrides()[1])
+    {
+        std::copy_n(desc.GetLengths().begin() + 2, ConvDim, lens.begin());
+        std::copy_n(desc.GetStrides().begin() + 2, ConvDim, strides.begin());
+    }
+
+    std::size_t spatial_size() const
+    {
+        return std::accumulate(
+            lens.begin(), lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+    }
+
+    /// Row-major id of a spatial position, like the order of ford, to its multi-index.
+    std::array<std::size_t, ConvDim> spatial_id(std::size_t id) const
+    {
+        std::array<std::size_t, ConvDim> result{};
+        for(std::size_t i = ConvDim; i-- > 0;)
+        {
+            result[i] = id % lens[i];
+            id /= lens[i];
+        }
+        return result;
+    }
+
+    template <typename Integer>
+    std::size_t spatial_offset(const std::array<Integer, ConvDim>& id) const
+    {
+        std::size_t offset = 0;
+        for(std::size_t i = 0; i < ConvDim; ++i)
+            offset += static_cast<std::size_t>(id[i]) * strides[i];
+        return offset;
+    }
+
+    template <typename Integer>
+    bool contains(const std::array<Integer, ConvDim>& id) const
+    {
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            if(id[i] < 0 or static_cast<std::size_t>(id[i]) >= lens[i])
+                return false;
+        }
+        return true;
+    }
+};
+
+// A filter tap contributing to one element: the spatial offset in the data tensor,
+// the spatial offset in the weights and the row-major id of the filter position.
+struct tap
+{
+    std::size_t data;
+    std::size_t wei;
+    std::size_t wei_id;
+};
+
+// Taps of the forward convolution of the output spatial position out_id,
+// in the order of the filter positions.
+template <std::size_t ConvDim, typename Range>
+void forward_taps(const conv_tensor_desc<ConvDim>& in,
+                  const conv_tensor_desc<ConvDim>& wei,
+                  const std::array<std::size_t, ConvDim>& out_id,
+                  const Range& pads,
+                  const Range& strides,
+                  const Range& dilations,
+                  std::vector<tap>& taps)
+{
+    taps.clear();
+    const auto wei_size = wei.spatial_size();
+    for(std::size_t w = 0; w < wei_size; ++w)
+    {
+        const auto wei_id = wei.spatial_id(w);
+        std::array<std::ptrdiff_t, ConvDim> in_id{};
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            in_id[i] = static_cast<std::ptrdiff_t>(out_id[i] * strides[i]) +
+                       static_cast<std::ptrdiff_t>(wei_id[i] * dilations[i]) -
+                       static_cast<std::ptrdiff_t>(pads[i]);
+        }
+        if(in.contains(in_id))
+            taps.push_back({in.spatial_offset(in_id), wei.spatial_offset(wei_id), w});
+    }
+}
+
+// Taps of the backward data convolution of the input spatial position in_id,
+// in the order of the filter positions.
+template <std::size_t ConvDim, typename Range>
+void backward_data_taps(const conv_tensor_desc<ConvDim>& out,
+                        const conv_tensor_desc<ConvDim>& wei,
+                        const std::array<std::size_t, ConvDim>& in_id,
+                        const Range& pads,
+                        const Range& strides,
+                        const Range& dilations,
+                        std::vector<tap>& taps)
+{
+    taps.clear();
+    const auto wei_size = wei.spatial_size();
+    for(std::size_t w = 0; w < wei_size; ++w)
+    {
+        const auto wei_id = wei.spatial_id(w);
+        std::array<std::ptrdiff_t, ConvDim> out_id{};
+        bool use = true;
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            const auto stride = static_cast<std::ptrdiff_t>(strides[i]);
+            const auto out_id_ =
+                static_cast<std::ptrdiff_t>(pads[i]) + static_cast<std::ptrdiff_t>(in_id[i]) -
+                static_cast<std::ptrdiff_t>(wei_id[i] * dilations[i]);
+            use &= out_id_ % stride == 0;
+            out_id[i] = out_id_ / stride;
+        }
+        if(use and out.contains(out_id))
+            taps.push_back({out.spatial_offset(out_id), wei.spatial_offset(wei_id), w});
+    }
+}
+
+// Spatial offsets meeting at the filter position wei_id, in the order of the output
+// positions. Here data is the offset in the input and wei the offset in the output.
+template <std::size_t ConvDim, typename Range>
+void backward_weight_taps(const conv_tensor_desc<ConvDim>& in,
+                          const conv_tensor_desc<ConvDim>& out,
+                          const std::array<std::size_t, ConvDim>& wei_id,
+                          const Range& pads,
+                          const Range& strides,
+                          const Range& dilations,
+                          std::vector<tap>& taps)
+{
+    taps.clear();
+    const auto out_size = out.spatial_size();
+    for(std::size_t o = 0; o < out_size; ++o)
+    {
+        const auto out_id = out.spatial_id(o);
+        std::array<std::ptrdiff_t, ConvDim> in_id{};
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            in_id[i] = static_cast<std::ptrdiff_t>(out_id[i] * strides[i]) +
+                       static_cast<std::ptrdiff_t>(wei_id[i] * dilations[i]) -
+                       static_cast<std::ptrdiff_t>(pads[i]);
+        }
+        if(in.contains(in_id))
+            taps.push_back({in.spatial_offset(in_id), out.spatial_offset(out_id), o});
+    }
+}
+
+} // namespace cpu_conv_detail
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename FI,
+          typename FW,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_forward_direct(const tensor<Tin>& in,
+                                    const tensor<Twei>& wei,
+                                    tensor<Tout>& out,
+                                    const Range& pads,
+                                    const Range& strides,
+                                    const Range& dilations,
+                                    std::size_t group_count,
+                                    bool fast,
+                                    FI fi = {},
+                                    FW fw = {})
+{
+    const auto in_desc  = cpu_conv_detail::conv_tensor_desc<ConvDim>{in.desc};
+    const auto wei_desc = cpu_conv_detail::conv_tensor_desc<ConvDim>{wei.desc};
+    const auto out_desc = cpu_conv_detail::conv_tensor_desc<ConvDim>{out.desc};
+
+    const std::size_t out_n_len           = out.desc.GetLengths()[0];
+    const std::size_t wei_k_len           = wei.desc.GetLengths()[0];
+    const std::size_t wei_c_len           = wei.desc.GetLengths()[1];
+    const std::size_t wei_k_len_per_group = wei_k_len / group_count;
+    const std::size_t wei_size            = wei_desc.spatial_size();
+    const std::size_t out_size            = out_desc.spatial_size();
+
+    // Weights as [group][filter position][c][k of the group], so a block of outputs
+    // sharing an input value is updated by a contiguous loop.
+    std::vector<Tacc> packed_wei;
+    if(fast)
+    {
+        packed_wei.resize(wei_k_len * wei_size * wei_c_len);
+        par_for(wei_k_len, [&](std::size_t k) {
+            const auto group_id = k / wei_k_len_per_group;
+            const auto k_id     = k % wei_k_len_per_group;
+            for(std::size_t w = 0; w < wei_size; ++w)
+            {
+                const auto wei_offset = wei_desc.spatial_offset(wei_desc.spatial_id(w));
+                for(std::size_t c = 0; c < wei_c_len; ++c)
+                {
+                    packed_wei[((group_id * wei_size + w) * wei_c_len + c) * wei_k_len_per_group +
+                               k_id] = static_cast<Tacc>(
+                        fw(wei.data[k * wei_desc.n_stride + c * wei_desc.c_stride + wei_offset]));
+                }
+            }
+        });
+    }
+
+    par_for(out_n_len * out_size, [&](std::size_t item) {
+        const auto out_n_id   = item / out_size;
+        const auto out_id     = out_desc.spatial_id(item % out_size);
+        const auto out_offset = out_n_id * out_desc.n_stride + out_desc.spatial_offset(out_id);
+
+        std::vector<cpu_conv_detail::tap> taps;
+        taps.reserve(wei_size);
+        cpu_conv_detail::forward_taps(in_desc, wei_desc, out_id, pads, strides, dilations, taps);
+
+        if(fast)
+        {
+            std::vector<Tacc> acc(wei_k_len_per_group);
+            for(std::size_t group_id = 0; group_id < group_count; ++group_id)
+            {
+                std::fill(acc.begin(), acc.end(), Tacc{0});
+                for(const auto& t : taps)
+                {
+                    for(std::size_t c = 0; c < wei_c_len; ++c)
+                    {
+                        const auto in_c_id = group_id * wei_c_len + c;
+                        const auto x       = static_cast<Tacc>(fi(
+                            in.data[out_n_id * in_desc.n_stride + in_c_id * in_desc.c_stride +
+                                    t.data]));
+                        const auto* w      = &packed_wei[((group_id * wei_size + t.wei_id) *
+                                                         wei_c_len +
+                                                     c) *
+                                                    wei_k_len_per_group];
+                        for(std::size_t k = 0; k < wei_k_len_per_group; ++k)
+                            acc[k] += x * w[k];
+                    }
+                }
+                for(std::size_t k = 0; k < wei_k_len_per_group; ++k)
+                {
+                    const auto out_k_id = group_id * wei_k_len_per_group + k;
+                    out.data[out_offset + out_k_id * out_desc.c_stride] =
+                        static_cast<Tout>(acc[k]);
+                }
+            }
+            return;
+        }
+
+        for(std::size_t out_k_id = 0; out_k_id < wei_k_len; ++out_k_id)
+        {
+            const auto group_id = out_k_id / wei_k_len_per_group;
+            Tacc acc            = 0;
+            for(std::size_t wei_c_id = 0; wei_c_id < wei_c_len; ++wei_c_id)
+            {
+                const auto in_c_id = group_id * wei_c_len + wei_c_id;
+                const auto* in_ptr =
+                    &in.data[out_n_id * in_desc.n_stride + in_c_id * in_desc.c_stride];
+                const auto* wei_ptr =
+                    &wei.data[out_k_id * wei_desc.n_stride + wei_c_id * wei_desc.c_stride];
+                for(const auto& t : taps)
+                {
+                    Tacc tmp1 = static_cast<Tacc>(fi(in_ptr[t.data]));
+                    Tacc tmp2 = static_cast<Tacc>(fw(wei_ptr[t.wei]));
+                    acc += tmp1 * tmp2;
+                }
+            }
+            out.data[out_offset + out_k_id * out_desc.c_stride] = static_cast<Tout>(acc);
+        }
+    });
+}
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename FW,
+          typename FO,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_backward_data_direct(tensor<Tin>& in,
+                                          const tensor<Twei>& wei,
+                                          const tensor<Tout>& out,
+                                          const Range& pads,
+                                          const Range& strides,
+                                          const Range& dilations,
+                                          std::size_t group_count,
+                                          bool fast,
+                                          FW fw = {},
+                                          FO fo = {})
+{
+    const auto in_desc  = cpu_conv_detail::conv_tensor_desc<ConvDim>{in.desc};
+    const auto wei_desc = cpu_conv_detail::conv_tensor_desc<ConvDim>{wei.desc};
+    const auto out_desc = cpu_conv_detail::conv_tensor_desc<ConvDim>{out.desc};
+
+    const std::size_t in_n_len            = in.desc.GetLengths()[0];
+    const std::size_t in_c_len            = in.desc.GetLengths()[1];
+    const std::size_t wei_k_len           = wei.desc.GetLengths()[0];
+    const std::size_t wei_c_len           = wei.desc.GetLengths()[1];
+    const std::size_t wei_k_len_per_group = wei_k_len / group_count;
+    const std::size_t wei_size            = wei_desc.spatial_size();
+    const std::size_t in_size             = in_desc.spatial_size();
+
+    // Weights as [group][filter position][k of the group][c], so the input channels
+    // sharing an output value are updated by a contiguous loop.
+    std::vector<Tacc> packed_wei;
+    if(fast)
+    {
+        packed_wei.resize(wei_k_len * wei_size * wei_c_len);
+        par_for(wei_k_len, [&](std::size_t k) {
+            const auto group_id = k / wei_k_len_per_group;
+            const auto k_id     = k % wei_k_len_per_group;
+            for(std::size_t w = 0; w < wei_size; ++w)
+            {
+                const auto wei_offset = wei_desc.spatial_offset(wei_desc.spatial_id(w));
+                for(std::size_t c = 0; c < wei_c_len; ++c)
+                {
+                    packed_wei[((group_id * wei_size + w) * wei_k_len_per_group + k_id) *
+                                   wei_c_len +
+                               c] = fw(wei.data[k * wei_desc.n_stride + c * wei_desc.c_stride +
+                                                wei_offset]);
+                }
+            }
+        });
+    }
+
+    par_for(in_n_len * in_size, [&](std::size_t item) {
+        const auto in_n_id   = item / in_size;
+        const auto in_id     = in_desc.spatial_id(item % in_size);
+        const auto in_offset = in_n_id * in_desc.n_stride + in_desc.spatial_offset(in_id);
+
+        std::vector<cpu_conv_detail::tap> taps;
+        taps.reserve(wei_size);
+        cpu_conv_detail::backward_data_taps(
+            out_desc, wei_desc, in_id, pads, strides, dilations, taps);
+
+        if(fast)
+        {
+            std::vector<Tacc> acc(wei_c_len);
+            for(std::size_t group_id = 0; group_id < group_count; ++group_id)
+            {
+                std::fill(acc.begin(), acc.end(), Tacc{0});
+                for(const auto& t : taps)
+                {
+                    for(std::size_t k = 0; k < wei_k_len_per_group; ++k)
+                    {
+                        const auto out_k_id = group_id * wei_k_len_per_group + k;
+                        Tacc y = fo(out.data[in_n_id * out_desc.n_stride +
+                                             out_k_id * out_desc.c_stride + t.data]);
+                        const auto* w =
+                            &packed_wei[((group_id * wei_size + t.wei_id) * wei_k_len_per_group +
+                                         k) *
+                                        wei_c_len];
+                        for(std::size_t c = 0; c < wei_c_len; ++c)
+                            acc[c] += y * w[c];
+                    }
+                }
+                for(std::size_t c = 0; c < wei_c_len; ++c)
+                {
+                    const auto in_c_id = group_id * wei_c_len + c;
+                    in.data[in_offset + in_c_id * in_desc.c_stride] = static_cast<Tout>(acc[c]);
+                }
+            }
+            return;
+        }
+
+        for(std::size_t in_c_id = 0; in_c_id < in_c_len; ++in_c_id)
+        {
+            const auto group_id = in_c_id / wei_c_len;
+            const auto wei_c_id = in_c_id % wei_c_len;
+            Tacc acc            = 0;
+            for(std::size_t k = 0; k < wei_k_len_per_group; ++k)
+            {
+                const auto out_k_id = group_id * wei_k_len_per_group + k;
+                const auto* out_ptr =
+                    &out.data[in_n_id * out_desc.n_stride + out_k_id * out_desc.c_stride];
+                const auto* wei_ptr =
+                    &wei.data[out_k_id * wei_desc.n_stride + wei_c_id * wei_desc.c_stride];
+                for(const auto& t : taps)
+                {
+                    Tacc tmp1 = fo(out_ptr[t.data]);
+                    Tacc tmp2 = fw(wei_ptr[t.wei]);
+                    acc += tmp1 * tmp2;
+                }
+            }
+            in.data[in_offset + in_c_id * in_desc.c_stride] = static_cast<Tout>(acc); // NOLINT
+        }
+    });
+}
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename FI,
+          typename FO,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_backward_weight_direct(const tensor<Tin>& in,
+                                            tensor<Twei>& wei,
+                                            const tensor<Tout>& out,
+                                            const Range& pads,
+                                            const Range& strides,
+                                            const Range& dilations,
+                                            std::size_t group_count,
+                                            bool fast,
+                                            FI fi,
+                                            FO fo)
+{
+    const auto in_desc  = cpu_conv_detail::conv_tensor_desc<ConvDim>{in.desc};
+    const auto wei_desc = cpu_conv_detail::conv_tensor_desc<ConvDim>{wei.desc};
+    const auto out_desc = cpu_conv_detail::conv_tensor_desc<ConvDim>{out.desc};
+
+    const std::size_t out_n_len           = out.desc.GetLengths()[0];
+    const std::size_t wei_k_len           = wei.desc.GetLengths()[0];
+    const std::size_t wei_c_len           = wei.desc.GetLengths()[1];
+    const std::size_t wei_k_len_per_group = wei_k_len / group_count;
+    const std::size_t wei_size            = wei_desc.spatial_size();
+
+    par_for(wei_k_len * wei_size, [&](std::size_t item) {
+        const auto wei_k_id   = item / wei_size;
+        const auto wei_id     = wei_desc.spatial_id(item % wei_size);
+        const auto wei_offset = wei_k_id * wei_desc.n_stride + wei_desc.spatial_offset(wei_id);
+        const auto group_id   = wei_k_id / wei_k_len_per_group;
+
+        std::vector<cpu_conv_detail::tap> taps;
+        taps.reserve(out_desc.spatial_size());
+        cpu_conv_detail::backward_weight_taps(
+            in_desc, out_desc, wei_id, pads, strides, dilations, taps);
+
+        if(fast)
+        {
+            std::vector<Tacc> acc(wei_c_len);
+            for(std::size_t out_n_id = 0; out_n_id < out_n_len; ++out_n_id)
+            {
+                const auto* in_ptr =
+                    &in.data[out_n_id * in_desc.n_stride + group_id * wei_c_len * in_desc.c_stride];
+                const auto* out_ptr =
+                    &out.data[out_n_id * out_desc.n_stride + wei_k_id * out_desc.c_stride];
+                for(const auto& t : taps)
+                {
+                    Tacc y = fo(out_ptr[t.wei]);
+                    for(std::size_t c = 0; c < wei_c_len; ++c)
+                    {
+                        Tacc x = fi(in_ptr[c * in_desc.c_stride + t.data]);
+                        acc[c] += x * y;
+                    }
+                }
+            }
+            for(std::size_t c = 0; c < wei_c_len; ++c)
+                wei.data[wei_offset + c * wei_desc.c_stride] = static_cast<Twei>(acc[c]);
+            return;
+        }
+
+        for(std::size_t wei_c_id = 0; wei_c_id < wei_c_len; ++wei_c_id)
+        {
+            const auto in_c_id = group_id * wei_c_len + wei_c_id;
+            Tacc acc           = 0;
+            for(std::size_t out_n_id = 0; out_n_id < out_n_len; ++out_n_id)
+            {
+                const auto* in_ptr =
+                    &in.data[out_n_id * in_desc.n_stride + in_c_id * in_desc.c_stride];
+                const auto* out_ptr =
+                    &out.data[out_n_id * out_desc.n_stride + wei_k_id * out_desc.c_stride];
+                for(const auto& t : taps)
+                {
+                    Tacc tmp1 = fi(in_ptr[t.data]);
+                    Tacc tmp2 = fo(out_ptr[t.wei]);
+                    acc += tmp1 * tmp2;
+                }
+            }
+            wei.data[wei_offset + wei_c_id * wei_desc.c_stride] = static_cast<Twei>(acc);
+        }
+    });
+}
+
+// The _impl functions run the direct algorithms unless MIOPEN_DEBUG_TEST_CPU_CONV_ALGO
+// selects another one. Vectorized tensors and CHWNc weights always use the naive one.
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename FI,
+          typename FW,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_forward_impl(const tensor<Tin>& in,
+                                  const tensor<Twei>& wei,
+                                  tensor<Tout>& out,
+                                  const Range& pads,
+                                  const Range& strides,
+                                  const Range& dilations,
+                                  std::size_t group_count,
+                                  FI fi = {},
+                                  FW fw = {})
+{
+    const auto algo = cpu_conv_detail::get_algo();
+    if(algo == cpu_conv_detail::algo::naive or in.desc.GetVectorLength() > 1 or
+       wei.desc.GetLayout_str() == "CHWNc")
+    {
+        cpu_convolution_forward_naive<ConvDim, Tacc>(
+            in, wei, out, pads, strides, dilations, group_count, fi, fw);
+        return;
+    }
+    cpu_convolution_forward_direct<ConvDim, Tacc>(in,
+                                                  wei,
+                                                  out,
+                                                  pads,
+                                                  strides,
+                                                  dilations,
+                                                  group_count,
+                                                  algo == cpu_conv_detail::algo::fast,
+                                                  fi,
+                                                  fw);
+}
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename FW,
+          typename FO,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_backward_data_impl(tensor<Tin>& in,
+                                        const tensor<Twei>& wei,
+                                        const tensor<Tout>& out,
+                                        const Range& pads,
+                                        const Range& strides,
+                                        const Range& dilations,
+                                        std::size_t group_count,
+                                        FW fw = {},
+                                        FO fo = {})
+{
+    const auto algo = cpu_conv_detail::get_algo();
+    if(algo == cpu_conv_detail::algo::naive)
+    {
+        cpu_convolution_backward_data_naive<ConvDim, Tacc>(
+            in, wei, out, pads, strides, dilations, group_count, fw, fo);
+        return;
+    }
+    cpu_convolution_backward_data_direct<ConvDim, Tacc>(in,
+                                                        wei,
+                                                        out,
+                                                        pads,
+                                                        strides,
+                                                        dilations,
+                                                        group_count,
+                                                        algo == cpu_conv_detail::algo::fast,
+                                                        fw,
+                                                        fo);
+}
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename FI,
+          typename FO,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
+                                          tensor<Twei>& wei,
+                                          const tensor<Tout>& out,
+                                          const Range& pads,
+                                          const Range& strides,
+                                          const Range& dilations,
+                                          std::size_t group_count,
+                                          FI fi,
+                                          FO fo)
+{
+    const auto algo = cpu_conv_detail::get_algo();
+    if(algo == cpu_conv_detail::algo::naive)
+    {
+        cpu_convolution_backward_weight_naive<ConvDim, Tacc>(
+            in, wei, out, pads, strides, dilations, group_count, fi, fo);
+        return;
+    }
+    cpu_convolution_backward_weight_direct<ConvDim, Tacc>(in,
+                                                          wei,
+                                                          out,
+                                                          pads,
+                                                          strides,
+                                                          dilations,
+                                                          group_count,
+                                                          algo == cpu_conv_detail::algo::fast,
+                                                          fi,
+                                                          fo);
+}
+
 template <typename Tin,
           typename Twei,
           typename Tout,
@@ -655,38 +655,53 @@ struct test_driver
                     }
                 }
 
-                auto mxdiff = miopen::max_diff(out_cpu, out_gpu);
-                std::cout << "Max diff: " << mxdiff << std::endl;
-                //            auto max_idx = miopen::mismatch_diff(out_cpu, out_gpu, mxdiff);
-                //            std::cout << "Max diff at " << max_idx << ": " << out_cpu[max_idx] <<
-                //            " !=
-                //            " << out_gpu[max_idx] << std::endl;
+                const auto cmp = miopen::compare_range(out_cpu, out_gpu);
+                std::cout << "Max diff: " << cmp.max_diff << std::endl;
 
                 if(miopen::range_zero(out_cpu))
                     std::cout << "Cpu data is all zeros" << std::endl;
                 if(miopen::range_zero(out_gpu))
                     std::cout << "Gpu data is all zeros" << std::endl;
 
-                auto idx = miopen::mismatch_idx(out_cpu, out_gpu, miopen::float_equal);
+                const auto idx = cmp.mismatch_idx;
                 if(idx < miopen::range_distance(out_cpu))
                 {
                     std::cout << "Mismatch at " << idx << ": " << out_cpu[idx]
                               << " != " << out_gpu[idx] << std::endl;
                 }
 
-                auto cpu_nan_idx = find_idx(out_cpu, miopen::not_finite);
+                const auto cpu_nan_idx = cmp.non_finite_idx1;
                 if(cpu_nan_idx >= 0)
                 {
                     std::cout << "Non finite number found in cpu at " << cpu_nan_idx << ": "
                               << out_cpu[cpu_nan_idx] << std::endl;
                 }
 
-                auto gpu_nan_idx = find_idx(out_gpu, miopen::not_finite);
+                const auto gpu_nan_idx = cmp.non_finite_idx2;
                 if(gpu_nan_idx >= 0)
                 {
                     std::cout << "Non finite number found in gpu at " << gpu_nan_idx << ": "
                               << out_gpu[gpu_nan_idx] << std::endl;
                 }
+
+                if(std::any_of(cmp.ulp_histogram.begin(),
+                               cmp.ulp_histogram.end(),
+                               [](auto count) { return count != 0; }))
+                {
+                    std::cout << "ULPs histogram (<= ulps: count):";
+                    for(std::size_t i = 0; i < cmp.ulp_histogram.size(); ++i)
+                    {
+                        if(cmp.ulp_histogram[i] == 0)
+                            continue;
+                        std::cout << ' ';
+                        if(i + 1 == cmp.ulp_histogram.size())
+                            std::cout << "more";
+                        else
+                            std::cout << ((std::size_t{1} << i) - 1);
+                        std::cout << ": " << cmp.ulp_histogram[i];
+                    }
+                    std::cout << std::endl;
+                }
             }
             else if(miopen::range_zero(out_cpu) and miopen::range_zero(out_gpu) and
                     (miopen::range_distance(out_cpu) != 0))
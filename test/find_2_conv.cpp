@@ -33,12 +33,14 @@
 #include <miopen/miopen.h>
 
 #include <miopen/convolution.hpp>
+#include <miopen/find_db.hpp>
 #include <miopen/solution.hpp>
 
 #include <miopen/solver_id.hpp>
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <vector>
 
 namespace miopen {
@@ -126,6 +128,7 @@ private:
 
         std::ignore          = TestFindSolutions(handle, problem);
         const auto solutions = TestFindSolutionsWithOptions(handle, problem);
+        TestFindSolutionsBatch(handle, problem);
 
         TestSolutionAttributes(solutions);
         TestRunSolutions(handle, solutions);
@@ -170,6 +173,97 @@ private:
         return solutions;
     }
 
+    void TestFindSolutionsBatch(miopenHandle_t handle, miopenProblem_t problem)
+    {
+        std::cerr << "Testing miopenFindSolutionsBatch..." << std::endl;
+
+        // A different direction makes a distinct problem over the same tensors.
+        const auto other_direction = direction == miopenProblemDirectionForward
+                                         ? miopenProblemDirectionBackward
+                                         : miopenProblemDirectionForward;
+        miopenProblem_t other;
+        EXPECT_EQUAL(miopenCreateConvProblem(&other, &filter, other_direction),
+                     miopenStatusSuccess);
+        AddConvTensorDescriptors(other);
+
+        // Results of the previous calls would be loaded from the find-db instead of being
+        // searched by the batch.
+        debug::testing_find_db_enabled = false;
+
+        // The same problem twice is searched once and both get the same results.
+        const auto problems  = std::vector<miopenProblem_t>{problem, other, problem};
+        const auto max_found = std::size_t{100};
+        auto solutions       = std::vector<miopenSolution_t>(problems.size() * max_found);
+        auto found           = std::vector<std::size_t>(problems.size());
+
+        EXPECT_EQUAL(miopenFindSolutionsBatch(handle,
+                                              problems.data(),
+                                              problems.size(),
+                                              nullptr,
+                                              solutions.data(),
+                                              found.data(),
+                                              max_found),
+                     miopenStatusSuccess);
+
+        const auto solver_ids = [&](std::size_t p) {
+            auto ids = std::vector<std::uint64_t>(found[p]);
+            for(std::size_t i = 0; i < found[p]; ++i)
+                EXPECT_EQUAL(miopenGetSolutionSolverId(solutions[p * max_found + i], &ids[i]),
+                             miopenStatusSuccess);
+            return ids;
+        };
+
+        EXPECT(solver_ids(0) == solver_ids(2));
+
+        // Each problem gets the same solvers as when it is searched alone.
+        for(std::size_t p = 0; p < 2; ++p)
+        {
+            auto single     = std::vector<miopenSolution_t>(max_found);
+            auto single_ids = std::vector<std::uint64_t>{};
+            std::size_t single_found;
+            EXPECT_EQUAL(miopenFindSolutions(handle,
+                                             problems[p],
+                                             nullptr,
+                                             single.data(),
+                                             &single_found,
+                                             single.size()),
+                         miopenStatusSuccess);
+            for(std::size_t i = 0; i < single_found; ++i)
+            {
+                EXPECT_EQUAL(miopenGetSolutionSolverId(single[i], &single_ids.emplace_back()),
+                             miopenStatusSuccess);
+                EXPECT_EQUAL(miopenDestroySolution(single[i]), miopenStatusSuccess);
+            }
+
+            // The order depends on the measured times.
+            auto batch_ids = solver_ids(p);
+            std::sort(batch_ids.begin(), batch_ids.end());
+            std::sort(single_ids.begin(), single_ids.end());
+            EXPECT(batch_ids == single_ids);
+        }
+
+        debug::testing_find_db_enabled = true;
+
+        for(std::size_t p = 0; p < problems.size(); ++p)
+            for(std::size_t i = 0; i < found[p]; ++i)
+                EXPECT_EQUAL(miopenDestroySolution(solutions[p * max_found + i]),
+                             miopenStatusSuccess);
+
+        EXPECT_EQUAL(miopenFindSolutionsBatch(
+                         handle, nullptr, 1, nullptr, solutions.data(), nullptr, max_found),
+                     miopenStatusBadParm);
+        EXPECT_EQUAL(miopenFindSolutionsBatch(
+                         handle, problems.data(), 1, nullptr, nullptr, nullptr, max_found),
+                     miopenStatusBadParm);
+        EXPECT_EQUAL(
+            miopenFindSolutionsBatch(handle, nullptr, 0, nullptr, nullptr, nullptr, max_found),
+            miopenStatusSuccess);
+
+        EXPECT_EQUAL(miopenDestroyProblem(other), miopenStatusSuccess);
+
+        std::cerr << "Finished testing miopenFindSolutionsBatch." << std::endl;
+    }
+
     std::vector<miopenSolution_t> TestFindSolutionsWithOptions(miopenHandle_t handle,
                                                                miopenProblem_t problem)
     {
@@ -31,6 +31,7 @@
 
 #include <miopen/convolution.hpp>
 #include <miopen/conv/problem_description.hpp>
+#include <miopen/conv/solver_finders.hpp>
 #include <miopen/env.hpp>
 #include <miopen/execution_context.hpp>
 #include <miopen/find_db.hpp>
@@ -40,6 +41,9 @@
 
 #include <chrono>
 #include <functional>
+#include <string>
+#include <tuple>
+#include <vector>
 
 namespace env = miopen::env;
 
@@ -99,6 +103,10 @@ struct FindDbTest : test_driver
         TestForward();
         TestBwdData();
         TestWeights();
+
+#if !MIOPEN_DISABLE_USERDB
+        TestBatch();
+#endif
     }
 
 private:
@@ -195,6 +203,71 @@ private:
         Test(filterCall);
     }
 
+    void TestBatch()
+    {
+        MIOPEN_LOG_I("Starting batched find-db test.");
+
+        // Starts from an empty find-db to not depend on the records of the other tests.
+        const TempFile temp_file{"miopen.test.find_db.batch"};
+        debug::testing_find_db_path_override() = temp_file;
+
+        const auto problems = std::vector<conv::ProblemDescription>{
+            {x.desc, w.desc, y.desc, filter, conv::Direction::Forward},
+            {y.desc, w.desc, x.desc, filter, conv::Direction::BackwardData},
+            {y.desc, w.desc, x.desc, filter, conv::Direction::BackwardWeights},
+        };
+        const auto solvers = std::vector<std::string>{
+            "ConvDirectNaiveConvFwd", "ConvDirectNaiveConvBwd", "ConvDirectNaiveConvWrw"};
+
+        auto regenerated       = std::vector<std::size_t>{};
+        auto optimal           = true;
+        const auto regenerator = [&](const std::vector<std::size_t>& missing) {
+            regenerated  = missing;
+            auto results = std::vector<FindCoreResult>{};
+            for(const auto i : missing)
+                results.push_back({{Solution{solver::Id{solvers[i]}, 1.0f + i, 0}}, optimal});
+            return results;
+        };
+        // Invokers are not built by this test.
+        const auto prepare = [](std::size_t, const std::string&) { return true; };
+        const auto load    = [&](const std::vector<conv::ProblemDescription>& batch) {
+            regenerated.clear();
+            return FindDbRecord::TryLoadBatch(handle, batch, regenerator, "", prepare);
+        };
+
+        const auto check = [&](const std::vector<std::vector<Solution>>& results) {
+            EXPECT_EQUAL(results.size(), problems.size());
+            for(std::size_t i = 0; i < results.size(); ++i)
+            {
+                EXPECT_EQUAL(results[i].size(), 1u);
+                EXPECT_EQUAL(results[i].front().GetSolver().ToString(), solvers[i]);
+                EXPECT_EQUAL(results[i].front().GetTime(), 1.0f + i);
+            }
+        };
+
+        // Results that are not optimal are returned but not stored.
+        optimal = false;
+        check(load(problems));
+        EXPECT_EQUAL(regenerated.size(), problems.size());
+        check(load(problems));
+        EXPECT_EQUAL(regenerated.size(), problems.size());
+
+        // All misses are regenerated by a single call and stored together.
+        optimal = true;
+        check(load(problems));
+        EXPECT_EQUAL(regenerated.size(), problems.size());
+        check(load(problems));
+        EXPECT(regenerated.empty());
+
+        // Only the problems missing from the find-db are regenerated.
+        const TempFile partial_file{"miopen.test.find_db.batch"};
+        debug::testing_find_db_path_override() = partial_file;
+        std::ignore = load({problems.front()});
+        EXPECT(regenerated == std::vector<std::size_t>{0});
+        check(load(problems));
+        EXPECT(regenerated == (std::vector<std::size_t>{1, 2}));
+    }
+
     void Test(const std::function<void()>& func)
     {
         using mSeconds = std::chrono::duration<double, std::ratio<1, 1000>>;
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/base64.hpp>
+#include <miopen/errors.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::vector<std::uint8_t> Bytes(const std::string& s) { return {s.begin(), s.end()}; }
+
+} // namespace
+
+TEST(CPU_Base64_NONE, Empty)
+{
+    EXPECT_EQ(miopen::EncodeBase64({}), "");
+    EXPECT_TRUE(miopen::DecodeBase64("").empty());
+}
+
+TEST(CPU_Base64_NONE, Padding)
+{
+    // RFC 4648 test vectors cover no padding and both padding lengths.
+    const std::vector<std::pair<std::string, std::string>> vectors = {
+        {"f", "Zg=="},
+        {"fo", "Zm8="},
+        {"foo", "Zm9v"},
+        {"foob", "Zm9vYg=="},
+        {"fooba", "Zm9vYmE="},
+        {"foobar", "Zm9vYmFy"},
+    };
+
+    for(const auto& [decoded, encoded] : vectors)
+    {
+        EXPECT_EQ(miopen::EncodeBase64(Bytes(decoded)), encoded);
+        EXPECT_EQ(miopen::DecodeBase64(encoded), Bytes(decoded)) << encoded;
+    }
+}
+
+TEST(CPU_Base64_NONE, AllBytes)
+{
+    auto data = std::vector<std::uint8_t>(256);
+    for(auto i = 0u; i < data.size(); ++i)
+        data[i] = static_cast<std::uint8_t>(i);
+
+    const auto encoded = miopen::EncodeBase64(data);
+    EXPECT_EQ(encoded.size(), (data.size() + 2) / 3 * 4);
+    EXPECT_EQ(miopen::DecodeBase64(encoded), data);
+}
+
+TEST(CPU_Base64_NONE, Invalid)
+{
+    const std::vector<std::string> invalid = {
+        "Zg=",       // Not a multiple of 4.
+        "Zm9",       // Not a multiple of 4, no padding.
+        "Zm9v*A==",  // Not in the alphabet.
+        "Zm9v Zg=",  // Whitespace.
+        "Zm-v",      // URL-safe alphabet.
+        "Z===",      // Padding in the second position.
+        "=Zg=",      // Padding in the first position.
+        "Zg=A",      // Data after padding.
+        "Zg==Zm8=",  // Padding before the last quad.
+    };
+
+    for(const auto& encoded : invalid)
+        EXPECT_THROW(miopen::DecodeBase64(encoded), miopen::Exception) << encoded;
+}
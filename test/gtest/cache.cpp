@@ -27,8 +27,11 @@
 #include <miopen/binary_cache.hpp>
 #include <miopen/bz2.hpp>
 #include <miopen/kern_db.hpp>
+#include <miopen/md5.hpp>
 #include <miopen/temp_file.hpp>
 #include <algorithm>
+#include <chrono>
+#include <thread>
 #include <vector>
 #include "test.hpp"
 #include "random.hpp"
@@ -133,6 +136,268 @@ TEST(CPU_Cache_NONE, check_kern_db)
         EXPECT_TRUE(err_db.RemoveRecordUnsafe(cfg0));
     }
 }
+
+TEST(CPU_Cache_NONE, check_kern_db_write_batch)
+{
+    miopen::env::update(MIOPEN_DEBUG_SQLITE_WRITE_BATCH_SIZE, 4);
+    miopen::env::update(MIOPEN_DEBUG_SQLITE_WRITE_BATCH_MS, 60000);
+
+    std::vector<miopen::KernelConfig> cfgs(5);
+    for(std::size_t i = 0; i < cfgs.size(); ++i)
+    {
+        cfgs[i].kernel_name = "kernel" + std::to_string(i);
+        cfgs[i].kernel_args = "-O3";
+        cfgs[i].kernel_blob = random_bytes(1024);
+    }
+
+    miopen::TempFile temp_file("tmp-kerndb");
+    {
+        miopen::KernDb writer(miopen::DbKinds::KernelDb, temp_file, false);
+        miopen::KernDb reader(miopen::DbKinds::KernelDb, temp_file, false);
+
+        for(auto i = 0; i < 3; ++i)
+            EXPECT_TRUE(writer.StoreRecordUnsafe(cfgs[i]));
+        // Pending writes are visible through the writing connection only
+        EXPECT_TRUE(writer.FindRecordUnsafe(cfgs[0]));
+        EXPECT_FALSE(reader.FindRecordUnsafe(cfgs[0]));
+
+        // The fourth write completes the batch
+        EXPECT_TRUE(writer.StoreRecordUnsafe(cfgs[3]));
+        for(auto i = 0; i < 4; ++i)
+            EXPECT_TRUE(reader.FindRecordUnsafe(cfgs[i]));
+
+        EXPECT_TRUE(writer.StoreRecordUnsafe(cfgs[4]));
+        EXPECT_FALSE(reader.FindRecordUnsafe(cfgs[4]));
+    }
+
+    // The rest of the batch is committed when the connection is closed
+    miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false);
+    const auto readout = db.FindRecordUnsafe(cfgs[4]);
+    EXPECT_TRUE(readout);
+    EXPECT_TRUE(readout.get() == cfgs[4].kernel_blob);
+
+    miopen::env::clear(MIOPEN_DEBUG_SQLITE_WRITE_BATCH_SIZE);
+    miopen::env::clear(MIOPEN_DEBUG_SQLITE_WRITE_BATCH_MS);
+}
+
+TEST(CPU_Cache_NONE, check_kern_db_write_batch_flush)
+{
+    miopen::env::update(MIOPEN_DEBUG_SQLITE_WRITE_BATCH_SIZE, 4);
+    miopen::env::update(MIOPEN_DEBUG_SQLITE_WRITE_BATCH_MS, 50);
+
+    std::vector<miopen::KernelConfig> cfgs(3);
+    for(std::size_t i = 0; i < cfgs.size(); ++i)
+    {
+        cfgs[i].kernel_name = "kernel" + std::to_string(i);
+        cfgs[i].kernel_args = "-O3";
+        cfgs[i].kernel_blob = random_bytes(1024);
+    }
+
+    miopen::TempFile temp_file("tmp-kerndb");
+    miopen::KernDb writer(miopen::DbKinds::KernelDb, temp_file, false);
+    miopen::KernDb reader(miopen::DbKinds::KernelDb, temp_file, false);
+
+    // An idle batch is committed in the background
+    EXPECT_TRUE(writer.StoreRecordUnsafe(cfgs[0]));
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while(!reader.FindRecordUnsafe(cfgs[0]) && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    EXPECT_TRUE(reader.FindRecordUnsafe(cfgs[0]));
+
+    // A write which has thrown doesn't leave the batch open
+    miopen::env::update(MIOPEN_DEBUG_SQLITE_WRITE_BATCH_MS, 60000);
+    miopen::KernDb slow_writer(miopen::DbKinds::KernelDb, temp_file, false);
+    EXPECT_TRUE(slow_writer.StoreRecordUnsafe(cfgs[1]));
+    EXPECT_FALSE(reader.FindRecordUnsafe(cfgs[1]));
+    EXPECT_TRUE(throws([&]() {
+        const miopen::SQLite::WriteGuard guard{slow_writer.sql};
+        slow_writer.sql.Exec("INSERT INTO missing_table VALUES(1);");
+    }));
+    EXPECT_TRUE(reader.FindRecordUnsafe(cfgs[1]));
+
+    // As well as the batches of the finished operations
+    EXPECT_TRUE(slow_writer.StoreRecordUnsafe(cfgs[2]));
+    EXPECT_FALSE(reader.FindRecordUnsafe(cfgs[2]));
+    miopen::SQLite::FlushAll();
+    EXPECT_TRUE(reader.FindRecordUnsafe(cfgs[2]));
+
+    miopen::env::clear(MIOPEN_DEBUG_SQLITE_WRITE_BATCH_SIZE);
+    miopen::env::clear(MIOPEN_DEBUG_SQLITE_WRITE_BATCH_MS);
+}
+
+TEST(CPU_Cache_NONE, check_kern_db_index)
+{
+    std::vector<miopen::KernelConfig> cfgs(4);
+    for(std::size_t i = 0; i < cfgs.size(); ++i)
+    {
+        cfgs[i].kernel_name = "kernel" + std::to_string(i);
+        // Quotes are fine, the values are bound to the statements.
+        cfgs[i].kernel_args = "-O3 -DNAME='x" + std::to_string(i) + "'";
+        cfgs[i].kernel_blob = random_bytes(1024);
+    }
+
+    miopen::TempFile temp_file("tmp-kerndb");
+    {
+        miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false);
+        for(auto i = 0; i < 3; ++i)
+            EXPECT_TRUE(db.StoreRecordUnsafe(cfgs[i]));
+    }
+
+    miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false);
+    EXPECT_FALSE(db.HasIndex());
+    EXPECT_EQ(db.BuildIndex(), cfgs.size() - 1);
+    EXPECT_TRUE(db.HasIndex());
+    for(auto i = 0; i < 3; ++i)
+    {
+        const auto readout = db.FindRecordUnsafe(cfgs[i]);
+        ASSERT_TRUE(readout);
+        EXPECT_TRUE(readout.get() == cfgs[i].kernel_blob);
+    }
+    auto other_args        = cfgs[0];
+    other_args.kernel_args = "-O3";
+    EXPECT_FALSE(db.FindRecordUnsafe(other_args));
+    EXPECT_FALSE(db.FindRecordUnsafe(cfgs[3]));
+
+    // Other connections to the unchanged database can use the index.
+    {
+        miopen::KernDb other(miopen::DbKinds::KernelDb, temp_file, true);
+        other.ShareIndex(db);
+        EXPECT_TRUE(other.HasIndex());
+        const auto record = other.FetchRecordUnsafe(cfgs[0]);
+        ASSERT_TRUE(record);
+        EXPECT_TRUE(other.DecodeRecord(*record) == cfgs[0].kernel_blob);
+        EXPECT_FALSE(other.FetchRecordUnsafe(cfgs[3]));
+    }
+
+    // The changes made through the connection are reflected by the lookups.
+    EXPECT_TRUE(db.StoreRecordUnsafe(cfgs[3]));
+    EXPECT_TRUE(db.FindRecordUnsafe(cfgs[3]));
+    cfgs[1].kernel_blob = random_bytes(2048);
+    EXPECT_TRUE(db.StoreRecordUnsafe(cfgs[1]));
+    const auto replaced = db.FindRecordUnsafe(cfgs[1]);
+    ASSERT_TRUE(replaced);
+    EXPECT_TRUE(replaced.get() == cfgs[1].kernel_blob);
+    EXPECT_TRUE(db.RemoveRecordUnsafe(cfgs[2]));
+    EXPECT_FALSE(db.FindRecordUnsafe(cfgs[2]));
+}
+
+// Similar kernels share most of their structure.
+std::vector<miopen::KernelConfig> similar_kernels(std::size_t n)
+{
+    const auto common = random_bytes(2048);
+    std::vector<miopen::KernelConfig> cfgs(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        cfgs[i].kernel_name = "kernel" + std::to_string(i);
+        cfgs[i].kernel_args = "-O3";
+        cfgs[i].kernel_blob = common;
+        const auto unique   = random_bytes(512);
+        cfgs[i].kernel_blob.insert(
+            cfgs[i].kernel_blob.begin() + 1024, unique.begin(), unique.end());
+    }
+    return cfgs;
+}
+
+TEST(CPU_Cache_NONE, check_kern_db_codecs)
+{
+    const auto cfgs = similar_kernels(4);
+
+    miopen::TempFile temp_file("tmp-kerndb");
+    for(const auto codec :
+        {miopen::KernDbCodec::None, miopen::KernDbCodec::BZip2, miopen::KernDbCodec::Zstd})
+    {
+        if(!miopen::IsAvailable(codec))
+            continue;
+        miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false, codec);
+        EXPECT_EQ(db.GetCodec(), codec);
+        EXPECT_TRUE(db.StoreRecordUnsafe(cfgs[static_cast<int>(codec)]));
+    }
+
+    // Records written with every codec are read back by any connection.
+    miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false);
+    for(const auto codec :
+        {miopen::KernDbCodec::None, miopen::KernDbCodec::BZip2, miopen::KernDbCodec::Zstd})
+    {
+        if(!miopen::IsAvailable(codec))
+            continue;
+        const auto& cfg    = cfgs[static_cast<int>(codec)];
+        const auto readout = db.FindRecordUnsafe(cfg);
+        ASSERT_TRUE(readout) << miopen::ToString(codec);
+        EXPECT_TRUE(readout.get() == cfg.kernel_blob) << miopen::ToString(codec);
+    }
+}
+
+TEST(CPU_Cache_NONE, check_kern_db_without_codec_fields)
+{
+    const auto cfgs = similar_kernels(2);
+
+    // A database created before the codec fields were added, with a bz2 record.
+    miopen::TempFile temp_file("tmp-kerndb");
+    {
+        const miopen::SQLite sql{temp_file, false};
+        sql.Exec("CREATE TABLE `kern_db` (`id` INTEGER PRIMARY KEY ASC"
+                 ",`kernel_name` TEXT NOT NULL,`kernel_args` TEXT NOT NULL"
+                 ",`kernel_blob` BLOB NOT NULL,`kernel_hash` TEXT NOT NULL"
+                 ",`uncompressed_size` INT NOT NULL);");
+        auto stmt = miopen::SQLite::Statement{
+            sql,
+            "INSERT INTO kern_db(kernel_name, kernel_args, kernel_blob, kernel_hash, "
+            "uncompressed_size) VALUES(?, ?, ?, ?, ?);"};
+        stmt.BindPath(1, cfgs[0].kernel_name);
+        stmt.BindText(2, cfgs[0].kernel_args);
+        stmt.BindBlob(3, miopen::compress(cfgs[0].kernel_blob));
+        stmt.BindText(4, miopen::md5(cfgs[0].kernel_blob));
+        stmt.BindInt64(5, cfgs[0].kernel_blob.size());
+        ASSERT_EQ(stmt.Step(sql), SQLITE_DONE);
+    }
+
+    {
+        miopen::KernDb sys_db(miopen::DbKinds::KernelDb, temp_file, true);
+        const auto readout = sys_db.FindRecordUnsafe(cfgs[0]);
+        ASSERT_TRUE(readout);
+        EXPECT_TRUE(readout.get() == cfgs[0].kernel_blob);
+    }
+
+    // A user database is upgraded in place.
+    miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false);
+    EXPECT_TRUE(db.StoreRecordUnsafe(cfgs[1]));
+    for(const auto& cfg : cfgs)
+    {
+        const auto readout = db.FindRecordUnsafe(cfg);
+        ASSERT_TRUE(readout);
+        EXPECT_TRUE(readout.get() == cfg.kernel_blob);
+    }
+}
+
+TEST(CPU_Cache_NONE, check_kern_db_dictionary)
+{
+    if(!miopen::IsAvailable(miopen::KernDbCodec::Zstd))
+        GTEST_SKIP() << "MIOpen is built without zstd";
+
+    auto cfgs       = similar_kernels(65);
+    const auto last = cfgs.back();
+    cfgs.pop_back();
+
+    miopen::TempFile temp_file("tmp-kerndb");
+    {
+        miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false, miopen::KernDbCodec::Zstd);
+        for(const auto& cfg : cfgs)
+            EXPECT_TRUE(db.StoreRecordUnsafe(cfg));
+        ASSERT_TRUE(db.TrainDictionary(4096));
+        // New records use the dictionary as well.
+        EXPECT_TRUE(db.StoreRecordUnsafe(last));
+    }
+    cfgs.push_back(last);
+
+    miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false);
+    for(const auto& cfg : cfgs)
+    {
+        const auto readout = db.FindRecordUnsafe(cfg);
+        ASSERT_TRUE(readout);
+        EXPECT_TRUE(readout.get() == cfg.kernel_blob);
+    }
+    EXPECT_EQ(db.LoadRecords().size(), cfgs.size());
+}
 #endif
 
 TEST(CPU_Cache_NONE, check_cache_file)
@@ -0,0 +1,203 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "cpu_conv.hpp"
+#include "random.hpp"
+#include "tensor_holder.hpp"
+#include "verify.hpp"
+
+#include <gtest/gtest.h>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct ConvCase
+{
+    bool channels_last;
+    int n;
+    int c;
+    int k;
+    int group_count;
+    std::vector<int> spatial;
+    std::vector<int> filter;
+    std::vector<int> pads;
+    std::vector<int> strides;
+    std::vector<int> dilations;
+
+    friend std::ostream& operator<<(std::ostream& os, const ConvCase& tc)
+    {
+        const auto print = [&](const char* name, const std::vector<int>& v) {
+            os << " " << name;
+            for(const auto x : v)
+                os << " " << x;
+        };
+        os << (tc.channels_last ? "channels last" : "channels first") << " n " << tc.n << " c "
+           << tc.c << " k " << tc.k << " g " << tc.group_count;
+        print("spatial", tc.spatial);
+        print("filter", tc.filter);
+        print("pads", tc.pads);
+        print("strides", tc.strides);
+        print("dilations", tc.dilations);
+        return os;
+    }
+};
+
+std::vector<ConvCase> GetCases()
+{
+    return {
+        {false, 2, 4, 6, 1, {7, 7}, {3, 3}, {1, 1}, {1, 1}, {1, 1}},
+        {true, 2, 4, 6, 1, {7, 7}, {3, 3}, {1, 1}, {1, 1}, {1, 1}},
+        {false, 2, 4, 6, 2, {8, 8}, {3, 3}, {0, 0}, {2, 2}, {1, 1}},
+        {true, 2, 4, 6, 2, {8, 8}, {3, 3}, {2, 2}, {1, 1}, {2, 2}},
+        {false, 1, 6, 6, 3, {9, 5}, {3, 2}, {1, 0}, {2, 1}, {1, 2}},
+        {true, 1, 6, 6, 3, {9, 5}, {3, 2}, {1, 0}, {2, 1}, {1, 2}},
+        {false, 3, 3, 5, 1, {6, 6}, {1, 1}, {0, 0}, {2, 2}, {1, 1}},
+        {true, 2, 4, 4, 4, {5, 6, 5}, {3, 3, 2}, {1, 1, 1}, {2, 1, 1}, {1, 2, 1}},
+        {false, 2, 4, 4, 2, {5, 6, 5}, {3, 3, 2}, {1, 1, 1}, {2, 1, 1}, {1, 2, 1}},
+    };
+}
+
+struct ConvTensors
+{
+    tensor<float> in;
+    tensor<float> wei;
+    tensor<float> out;
+};
+
+ConvTensors MakeTensors(const ConvCase& tc)
+{
+    const auto spatial_dims = tc.spatial.size();
+    const auto layout       = spatial_dims == 2
+                                  ? (tc.channels_last ? miopenTensorNHWC : miopenTensorNCHW)
+                                  : (tc.channels_last ? miopenTensorNDHWC : miopenTensorNCDHW);
+
+    auto in_lens  = std::vector<int>{tc.n, tc.c};
+    auto wei_lens = std::vector<int>{tc.k, tc.c / tc.group_count};
+    auto out_lens = std::vector<int>{tc.n, tc.k};
+    for(auto i = 0u; i < spatial_dims; ++i)
+    {
+        in_lens.push_back(tc.spatial[i]);
+        wei_lens.push_back(tc.filter[i]);
+        out_lens.push_back(
+            (tc.spatial[i] + 2 * tc.pads[i] - tc.dilations[i] * (tc.filter[i] - 1) - 1) /
+                tc.strides[i] +
+            1);
+    }
+
+    const auto gen = [](auto...) { return prng::gen_A_to_B(-1.0, 1.0); };
+    auto tensors   = ConvTensors{tensor<float>{layout, in_lens},
+                               tensor<float>{layout, wei_lens},
+                               tensor<float>{layout, out_lens}};
+    tensors.in.generate(gen);
+    tensors.wei.generate(gen);
+    tensors.out.generate(gen);
+    return tensors;
+}
+
+enum class Direction
+{
+    Forward,
+    BackwardData,
+    BackwardWeights,
+};
+
+/// Runs the direction with the given algorithm and returns the tensor it writes.
+std::vector<float> RunConvolution(const ConvCase& tc, Direction direction, const std::string& algo)
+{
+    miopen::env::update(MIOPEN_DEBUG_TEST_CPU_CONV_ALGO, algo);
+    auto tensors           = MakeTensors(tc);
+    const auto spatial_dim = tc.spatial.size();
+    const auto group_count = static_cast<std::size_t>(tc.group_count);
+
+    switch(direction)
+    {
+    case Direction::Forward:
+        cpu_convolution_forward(spatial_dim,
+                                tensors.in,
+                                tensors.wei,
+                                tensors.out,
+                                tc.pads,
+                                tc.strides,
+                                tc.dilations,
+                                group_count);
+        return tensors.out.data;
+    case Direction::BackwardData:
+        cpu_convolution_backward_data(spatial_dim,
+                                      tensors.in,
+                                      tensors.wei,
+                                      tensors.out,
+                                      tc.pads,
+                                      tc.strides,
+                                      tc.dilations,
+                                      group_count);
+        return tensors.in.data;
+    case Direction::BackwardWeights:
+        cpu_convolution_backward_weight(spatial_dim,
+                                        tensors.in,
+                                        tensors.wei,
+                                        tensors.out,
+                                        tc.pads,
+                                        tc.strides,
+                                        tc.dilations,
+                                        group_count);
+        return tensors.wei.data;
+    }
+    return {};
+}
+
+class CPU_CpuConvAlgo_NONE : public ::testing::TestWithParam<ConvCase>
+{
+protected:
+    void TearDown() override { miopen::env::clear(MIOPEN_DEBUG_TEST_CPU_CONV_ALGO); }
+
+    static void Check(Direction direction)
+    {
+        const auto& tc   = GetParam();
+        const auto naive = RunConvolution(tc, direction, "naive");
+
+        // The direct algorithm keeps the accumulation order of the naive one.
+        EXPECT_EQ(RunConvolution(tc, direction, "direct"), naive);
+
+        // The fast one reorders it, the accumulator is double.
+        const auto fast = RunConvolution(tc, direction, "fast");
+        ASSERT_EQ(fast.size(), naive.size());
+        EXPECT_LE(miopen::rms_range(naive, fast), 1e-6);
+        EXPECT_LE(miopen::max_diff(naive, fast), 1e-5);
+    }
+};
+
+} // namespace
+
+TEST_P(CPU_CpuConvAlgo_NONE, Forward) { Check(Direction::Forward); }
+
+TEST_P(CPU_CpuConvAlgo_NONE, BackwardData) { Check(Direction::BackwardData); }
+
+TEST_P(CPU_CpuConvAlgo_NONE, BackwardWeights) { Check(Direction::BackwardWeights); }
+
+INSTANTIATE_TEST_SUITE_P(Full, CPU_CpuConvAlgo_NONE, testing::ValuesIn(GetCases()));
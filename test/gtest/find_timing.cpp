@@ -0,0 +1,119 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/find_timing.hpp>
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <vector>
+
+namespace {
+
+miopen::InvokerTiming Time(miopenFindTimingPolicy_t policy, float best, std::vector<float> times)
+{
+    auto timing = miopen::InvokerTiming{policy, best};
+    for(const auto time : times)
+    {
+        if(!timing.Add(time))
+            break;
+    }
+    return timing;
+}
+
+} // namespace
+
+TEST(CPU_FindTiming_NONE, FixedDiscardsWarmup)
+{
+    const auto timing = Time(miopenFindTimingPolicyFixed, 1.0f, {9, 9, 9, 1, 2, 3, 2, 2, 100});
+    EXPECT_EQ(timing.Runs(), 8);
+    EXPECT_FLOAT_EQ(timing.Estimate(), 2.0f);
+    EXPECT_FALSE(timing.IsAbandoned());
+}
+
+TEST(CPU_FindTiming_NONE, FixedStopsOnBudget)
+{
+    const auto timing = Time(miopenFindTimingPolicyFixed, 1.0f, {3000, 2000, 100});
+    EXPECT_EQ(timing.Runs(), 2);
+    EXPECT_FLOAT_EQ(timing.Estimate(), 2000.0f);
+}
+
+TEST(CPU_FindTiming_NONE, AdaptiveFirstCandidate)
+{
+    const auto timing = Time(miopenFindTimingPolicyAdaptive,
+                            std::numeric_limits<float>::max(),
+                            {50, 1.0f, 1.2f, 1.1f, 5, 5, 5});
+    EXPECT_EQ(timing.Runs(), 4);
+    EXPECT_FLOAT_EQ(timing.Estimate(), 1.1f);
+    EXPECT_FALSE(timing.IsAbandoned());
+}
+
+TEST(CPU_FindTiming_NONE, AdaptiveAbandonsAfterWarmup)
+{
+    const auto timing = Time(miopenFindTimingPolicyAdaptive, 1.0f, {11, 1, 1, 1});
+    EXPECT_EQ(timing.Runs(), 1);
+    EXPECT_TRUE(timing.IsAbandoned());
+}
+
+TEST(CPU_FindTiming_NONE, AdaptiveAbandonsSlower)
+{
+    const auto timing = Time(miopenFindTimingPolicyAdaptive, 1.0f, {5, 1.5f, 1.2f, 1, 1});
+    EXPECT_EQ(timing.Runs(), 3);
+    EXPECT_TRUE(timing.IsAbandoned());
+    EXPECT_FLOAT_EQ(timing.Estimate(), 1.35f);
+}
+
+TEST(CPU_FindTiming_NONE, AdaptiveKeepsFaster)
+{
+    const auto timing = Time(miopenFindTimingPolicyAdaptive, 1.0f, {5, 0.5f, 0.5f, 0.5f, 1, 1});
+    EXPECT_EQ(timing.Runs(), 4);
+    EXPECT_FALSE(timing.IsAbandoned());
+    EXPECT_FLOAT_EQ(timing.Estimate(), 0.5f);
+}
+
+TEST(CPU_FindTiming_NONE, AdaptiveMeasuresCloseCandidatesLonger)
+{
+    // Noisy and close to the best: the confidence interval keeps including it.
+    auto times = std::vector<float>{2};
+    for(auto i = 0; i < 30; ++i)
+        times.push_back(i % 2 == 0 ? 0.9f : 1.04f);
+
+    const auto close = Time(miopenFindTimingPolicyAdaptive, 1.0f, times);
+    EXPECT_FALSE(close.IsAbandoned());
+    EXPECT_EQ(close.Runs(), 21);
+    EXPECT_GT(close.Spread(), 0.0f);
+
+    const auto far = Time(miopenFindTimingPolicyAdaptive, 10.0f, times);
+    EXPECT_EQ(far.Runs(), 4);
+}
+
+TEST(CPU_FindTiming_NONE, AdaptiveStopsOnBudget)
+{
+    const auto timing = Time(miopenFindTimingPolicyAdaptive,
+                            std::numeric_limits<float>::max(),
+                            {2000, 2000, 2000, 2000});
+    EXPECT_EQ(timing.Runs(), 3);
+}
@@ -24,7 +24,15 @@
  *
  *******************************************************************************/
 
+#include <miopen/base64.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/graphapi/conv_bias_res_add_activ_forward_executor.hpp>
 #include <miopen/graphapi/execution_plan.hpp>
+#include <miopen/graphapi/opgraph.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/solution.hpp>
+
+#include <nlohmann/json.hpp>
 
 #include <gtest/gtest.h>
 
@@ -112,3 +120,148 @@ TEST(CPU_GraphApi_NONE, ExecutionPlan)
 
     execute();
 }
+
+namespace {
+
+using miopen::graphapi::ConvBiasResAddActivForwardExecutor;
+using miopen::graphapi::Convolution;
+using miopen::graphapi::EngineBuilder;
+using miopen::graphapi::ExecutionPlan;
+using miopen::graphapi::GraphExecutorFind20;
+using miopen::graphapi::OpGraph;
+using miopen::graphapi::Tensor;
+
+Tensor MakeTensor(int64_t id, std::vector<std::size_t> dims)
+{
+    return {miopenHalf, dims, miopen::TensorDescriptor{miopenHalf, dims}.GetStrides(), id, false};
+}
+
+class NotSerializableExecutor : public miopen::graphapi::GraphPatternExecutor
+{
+public:
+    void execute(miopenHandle_t, const miopen::graphapi::VariantPack&) override {}
+    size_t getWorkspaceSize() const override { return 0; }
+};
+
+} // namespace
+
+TEST(CPU_GraphApi_NONE, ExecutionPlanJsonRepresentation)
+{
+    miopenHandle_t handle;
+    auto status = miopenCreate(&handle);
+    ASSERT_EQ(status, miopenStatusSuccess) << "miopenCreate() failed";
+
+    auto x    = MakeTensor(1, {16, 64, 28, 28});
+    auto w    = MakeTensor(2, {128, 64, 3, 3});
+    auto z    = MakeTensor(3, {16, 128, 28, 28});
+    auto bias = MakeTensor(4, {1, 128, 1, 1});
+    auto y    = MakeTensor(5, {16, 128, 28, 28});
+    auto conv = Convolution{miopenFloat, miopenConvolution, 2, {1, 1}, {1, 1}, {1, 1}, {1, 1}};
+
+    OpGraph graph;
+    auto engine = EngineBuilder()
+                      .setGraph(&graph)
+                      .setGlobalIndex(3)
+                      .setSmCount(8)
+                      .setExecutor(ConvBiasResAddActivForwardExecutor::make(
+                          &x, &w, &conv, 1, &z, &bias, &y, 0.5f, 2.0f, 0.1f))
+                      .build();
+    auto plan = ExecutionPlanBuilder()
+                    .setHandle(handle)
+                    .setEngineCfg(engine)
+                    .setIntermediateIds({7, 9})
+                    .build();
+
+    const auto json = plan.getJsonRepresentation();
+    ASSERT_FALSE(json.empty());
+
+    ExecutionPlan restored;
+    ASSERT_NO_THROW({
+        restored = ExecutionPlanBuilder().setHandle(handle).setJsonRepresentation(json).build();
+    }) << "ExecutionPlanBuilder failed on a valid json representation";
+
+    const auto& restoredEngine = restored.getEngineCfg().getEngine();
+    EXPECT_EQ(restoredEngine.getGlobalIndex(), 3);
+    EXPECT_EQ(restoredEngine.getSmCount(), 8);
+    EXPECT_EQ(restoredEngine.getOpGraph(), nullptr);
+    EXPECT_EQ(restored.getIntermediateIds(), (std::vector<int64_t>{7, 9}));
+    EXPECT_EQ(restored.getWorkspaceSize(), plan.getWorkspaceSize());
+    EXPECT_EQ(restored.getJsonRepresentation(), json) << "Representation didn't round trip";
+
+    EXPECT_ANY_THROW({ ExecutionPlanBuilder().setJsonRepresentation("{"); })
+        << "ExecutionPlanBuilder accepted malformed json";
+    EXPECT_ANY_THROW({ ExecutionPlanBuilder().setJsonRepresentation("{\"version\": 1}"); })
+        << "ExecutionPlanBuilder accepted a representation without an engine";
+
+    auto unsupported = EngineBuilder()
+                           .setGraph(&graph)
+                           .setGlobalIndex(0)
+                           .setExecutor(std::make_shared<NotSerializableExecutor>())
+                           .build();
+    auto unsupportedPlan =
+        ExecutionPlanBuilder().setHandle(handle).setEngineCfg(unsupported).build();
+    EXPECT_ANY_THROW({ unsupportedPlan.getJsonRepresentation(); })
+        << "Serialized an executor that does not support it";
+
+    miopenDestroy(handle);
+}
+
+TEST(CPU_GraphApi_NONE, ExecutionPlanFind20JsonRepresentation)
+{
+    miopenHandle_t handle;
+    auto status = miopenCreate(&handle);
+    ASSERT_EQ(status, miopenStatusSuccess) << "miopenCreate() failed";
+
+    auto problem = miopen::Problem{};
+    problem.SetDirection(miopenProblemDirectionForward);
+    problem.SetOperatorDescriptor(miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}});
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionX,
+                                     miopen::TensorDescriptor{miopenFloat, {1, 8, 16, 16}});
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionW,
+                                     miopen::TensorDescriptor{miopenFloat, {16, 8, 3, 3}});
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionY,
+                                     miopen::TensorDescriptor{miopenFloat, {1, 16, 16, 16}});
+
+    auto solution = miopen::Solution{miopen::solver::Id{"ConvDirectNaiveConvFwd"}, 1.5f, 1024};
+    solution.SetProblem({problem});
+
+    auto tensorMap = std::make_shared<miopen::graphapi::TensorInfoMap>();
+    tensorMap->emplace(3, miopen::graphapi::TensorInfo{miopenTensorConvolutionY});
+    tensorMap->emplace(1, miopen::graphapi::TensorInfo{miopenTensorConvolutionX});
+    tensorMap->emplace(2, miopen::graphapi::TensorInfo{miopenTensorConvolutionW});
+
+    OpGraph graph;
+    auto engine = EngineBuilder()
+                      .setGraph(&graph)
+                      .setGlobalIndex(1)
+                      .setSmCount(4)
+                      .setExecutor(GraphExecutorFind20::make(&solution, tensorMap))
+                      .build();
+    auto plan = ExecutionPlanBuilder().setHandle(handle).setEngineCfg(engine).build();
+
+    const auto json = plan.getJsonRepresentation();
+    ASSERT_FALSE(json.empty());
+
+    ExecutionPlan restored;
+    ASSERT_NO_THROW({
+        restored = ExecutionPlanBuilder().setHandle(handle).setJsonRepresentation(json).build();
+    }) << "ExecutionPlanBuilder failed on a valid json representation";
+
+    const auto& restoredEngine = restored.getEngineCfg().getEngine();
+    EXPECT_EQ(restoredEngine.getGlobalIndex(), 1);
+    EXPECT_EQ(restoredEngine.getSmCount(), 4);
+    EXPECT_EQ(restored.getWorkspaceSize(), solution.GetWorkspaceSize());
+    EXPECT_EQ(restored.getJsonRepresentation(), json) << "Representation didn't round trip";
+
+    // The solution is embedded, not referenced.
+    const auto executor =
+        nlohmann::json::parse(json).at("engine").at("executor").get<nlohmann::json>();
+    const auto blob = miopen::DecodeBase64(executor.at("solution").get<std::string>());
+    const auto embedded =
+        miopen::Solution::Load(reinterpret_cast<const char*>(blob.data()), blob.size());
+    EXPECT_EQ(embedded.GetSolver(), solution.GetSolver());
+    EXPECT_EQ(embedded.GetTime(), solution.GetTime());
+    EXPECT_EQ(executor.at("tensors").size(), tensorMap->size());
+
+    miopenDestroy(handle);
+}
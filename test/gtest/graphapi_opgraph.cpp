@@ -98,3 +98,47 @@ TEST(CPU_GraphAPI_NONE, BuildDiamond)
 
     miopenDestroy(handle);
 }
+
+TEST(CPU_GraphAPI_NONE, BuildRejectsCycle)
+{
+    using namespace graphapi_opgraph_tests;
+
+    gr::PatternGraphGenerator gen;
+    using DummyNode = gr::PatternGraphGenerator::DummyNode;
+
+    auto t_in = gen.makeDummyTensor("t_in");
+    auto t_a  = gen.makeDummyTensor("t_a");
+    auto t_b  = gen.makeDummyTensor("t_b");
+    auto t_c  = gen.makeDummyTensor("t_c");
+
+    // top -> left -> right -> left
+    DummyNode top{"top", {t_in}, {t_a}};
+    DummyNode left{"left", {t_a, t_c}, {t_b}};
+    DummyNode right{"right", {t_b}, {t_c}};
+
+    gr::OpGraphBuilder graph_builder;
+    graph_builder.addNode(&top);
+    graph_builder.addNode(&left);
+    graph_builder.addNode(&right);
+
+    ASSERT_THROW(std::ignore = std::move(graph_builder).build(), miopen::Exception);
+}
+
+TEST(CPU_GraphAPI_NONE, AllPaths)
+{
+    using namespace graphapi_opgraph_tests;
+
+    auto dg    = makeDiamondGraph();
+    auto paths = dg->graph().getAllPaths();
+
+    std::vector<std::string> path_strs;
+    for(const auto& path : paths)
+    {
+        path_strs.emplace_back(gr::pathToStr(path));
+    }
+    std::sort(path_strs.begin(), path_strs.end());
+
+    ASSERT_EQ(path_strs,
+              std::vector<std::string>({"INTERNAL::SRC,top,left,bottom,INTERNAL::SINK,",
+                                        "INTERNAL::SRC,top,right,bottom,INTERNAL::SINK,"}));
+}
@@ -68,3 +68,53 @@ TEST(CPU_GraphMatchingAPI_NONE, DiamondGraphMatch)
         ASSERT_FALSE(gr::isIsomorphic(dg1->graph(), dg5->graph()));
     }
 }
+
+TEST(CPU_GraphMatchingAPI_NONE, SameNamesAndDegrees)
+{
+    using namespace graphapi_opgraph_tests;
+
+    auto chain1 = gr::PatternGraphGenerator::Make(
+        {{"a", {"t_in"}, {"t_0"}}, {"b", {"t_0"}, {"t_1"}}, {"c", {"t_1"}, {"t_out"}}});
+    auto chain2 = gr::PatternGraphGenerator::Make(
+        {{"b", {"t_in"}, {"t_0"}}, {"a", {"t_0"}, {"t_1"}}, {"c", {"t_1"}, {"t_out"}}});
+    auto chain3 = gr::PatternGraphGenerator::Make(
+        {{"c", {"t_1"}, {"t_out"}}, {"a", {"t_in"}, {"t_0"}}, {"b", {"t_0"}, {"t_1"}}});
+
+    ASSERT_FALSE(gr::isIsomorphic(chain1->graph(), chain2->graph()));
+    ASSERT_NE(gr::GraphSignature{chain1->graph()}, gr::GraphSignature{chain2->graph()});
+
+    // the order of nodes does not matter
+    ASSERT_TRUE(gr::isIsomorphic(chain1->graph(), chain3->graph()));
+    ASSERT_EQ(gr::GraphSignature{chain1->graph()}, gr::GraphSignature{chain3->graph()});
+}
+
+TEST(CPU_GraphMatchingAPI_NONE, DeepDiamonds)
+{
+    using namespace graphapi_opgraph_tests;
+
+    // 64 stacked diamonds have 2^64 paths, so only a polynomial check completes.
+    auto make = [](bool swap_last) {
+        std::vector<gr::PatternGraphGenerator::DummyNodeGenSpec> specs;
+        for(int i = 0; i < 64; ++i)
+        {
+            auto in  = "t_" + std::to_string(i);
+            auto out = "t_" + std::to_string(i + 1);
+            auto l   = "l_" + std::to_string(i);
+            auto r   = "r_" + std::to_string(i);
+            auto top = swap_last && i == 63 ? "join" : "split";
+            auto bot = swap_last && i == 63 ? "split" : "join";
+            specs.push_back({top, {in}, {l, r}});
+            specs.push_back({"left", {l}, {l + "_out"}});
+            specs.push_back({"right", {r}, {r + "_out"}});
+            specs.push_back({bot, {l + "_out", r + "_out"}, {out}});
+        }
+        return gr::PatternGraphGenerator::Make(specs);
+    };
+
+    auto g1 = make(false);
+    auto g2 = make(false);
+    auto g3 = make(true);
+
+    ASSERT_TRUE(gr::isIsomorphic(g1->graph(), g2->graph()));
+    ASSERT_FALSE(gr::isIsomorphic(g1->graph(), g3->graph()));
+}
@@ -0,0 +1,123 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "graphapi_opgraph_common.hpp"
+
+#include <miopen/graphapi/pattern_registry.hpp>
+
+namespace {
+
+using namespace graphapi_opgraph_tests;
+
+class DummyPattern : public gr::GraphPatternMatcher
+{
+    std::string mName;
+    std::unique_ptr<gr::PatternGraphGenerator> mGraphGen;
+
+public:
+    DummyPattern(std::string name, std::unique_ptr<gr::PatternGraphGenerator> graph_gen)
+        : mName(std::move(name)), mGraphGen(std::move(graph_gen))
+    {
+    }
+
+    bool matches(const gr::OpGraph* graph) const final
+    {
+        return gr::isIsomorphic(*graph, mGraphGen->graph());
+    }
+
+    std::vector<gr::Engine> getEngines(gr::OpGraph*) const final { return {}; }
+
+    std::string_view name() const final { return mName; }
+
+    const gr::OpGraph& patternGraph() const final { return mGraphGen->graph(); }
+};
+
+std::unique_ptr<gr::PatternGraphGenerator> makeChainGraph()
+{
+    return gr::PatternGraphGenerator::Make({{"top", {"t_in"}, {"t_a"}},
+                                            {"left", {"t_a"}, {"t_b"}},
+                                            {"right", {"t_b"}, {"t_c"}},
+                                            {"bottom", {"t_c"}, {"t_out"}}});
+}
+
+} // namespace
+
+TEST(CPU_GraphPatternRegistry_NONE, Signature)
+{
+    auto dg1 = makeDiamondGraph();
+    auto dg2 = makeDiamondGraph();
+    auto dg3 = gr::PatternGraphGenerator::Make({{"top", {"t_in"}, {"t_a", "t_b"}},
+                                                {"left", {"t_b"}, {"t_d"}},
+                                                {"right", {"t_a"}, {"t_c"}},
+                                                {"bottom", {"t_c", "t_d"}, {"t_out"}}});
+    auto chain = makeChainGraph();
+
+    const gr::GraphSignature sig1{dg1->graph()};
+    EXPECT_EQ(sig1, gr::GraphSignature{dg2->graph()});
+    EXPECT_EQ(sig1.hash(), gr::GraphSignature{dg2->graph()}.hash());
+    EXPECT_EQ(sig1, gr::GraphSignature{dg3->graph()});
+    // Same node names, different degrees.
+    EXPECT_NE(sig1, gr::GraphSignature{chain->graph()});
+}
+
+TEST(CPU_GraphPatternRegistry_NONE, Candidates)
+{
+    gr::GraphPatternRegistry registry;
+    registry.add(std::make_unique<DummyPattern>("diamond", makeDiamondGraph()));
+    registry.add(std::make_unique<DummyPattern>("chain", makeChainGraph()));
+    registry.add(std::make_unique<DummyPattern>("diamond2", makeDiamondGraph()));
+
+    auto dg    = makeDiamondGraph();
+    auto chain = makeChainGraph();
+    auto other = gr::PatternGraphGenerator::Make({{"top", {"t_in"}, {"t_out"}}});
+
+    auto candidates = registry.getCandidates(gr::GraphSignature{dg->graph()});
+    ASSERT_EQ(candidates.size(), 2);
+    EXPECT_EQ(candidates[0]->name(), "diamond");
+    EXPECT_EQ(candidates[1]->name(), "diamond2");
+
+    ASSERT_NE(registry.findMatch(dg->graph()), nullptr);
+    EXPECT_EQ(registry.findMatch(dg->graph())->name(), "diamond");
+    ASSERT_NE(registry.findMatch(chain->graph()), nullptr);
+    EXPECT_EQ(registry.findMatch(chain->graph())->name(), "chain");
+    EXPECT_TRUE(registry.getCandidates(gr::GraphSignature{other->graph()}).empty());
+    EXPECT_EQ(registry.findMatch(other->graph()), nullptr);
+}
+
+TEST(CPU_GraphPatternRegistry_NONE, Global)
+{
+    const auto& registry = gr::GraphPatternRegistry::global();
+    ASSERT_EQ(registry.getPatterns().size(), 3);
+
+    for(const auto& pattern : registry.getPatterns())
+    {
+        const auto candidates = registry.getCandidates(gr::GraphSignature{pattern->patternGraph()});
+        EXPECT_NE(std::find(candidates.begin(), candidates.end(), pattern.get()), candidates.end())
+            << pattern->name();
+    }
+
+    auto dg = makeDiamondGraph();
+    EXPECT_EQ(registry.findMatch(dg->graph()), nullptr);
+}
@@ -0,0 +1,162 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/kern_pack.hpp>
+#include <miopen/mapped_file.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::vector<char> Blob(const miopen::kpack::SourceRecord& record)
+{
+    auto blob = std::vector<char>(record.size);
+    for(std::size_t i = 0; i < blob.size(); ++i)
+        blob[i] = record.name[i % record.name.size()];
+    return blob;
+}
+
+const std::vector<miopen::kpack::SourceRecord> records = {
+    {"kernel_a.o", "-O3 -mcpu=gfx90a", 5000},
+    {"kernel_b.o", "-O3 -mcpu=gfx90a", 100},
+    {"kernel_a.o", "-O2 -mcpu=gfx90a", 1},
+    {"kernel_b.o", "-O3 -mcpu=gfx90a", 7}, // Duplicate, ignored.
+};
+
+std::string WritePack(const miopen::kpack::SourceStamp& source = {})
+{
+    auto out     = std::ostringstream{};
+    const auto n = miopen::kpack::WritePack(records, source, out, Blob);
+    EXPECT_EQ(n, 3u);
+    return out.str();
+}
+
+miopen::kpack::Entry* GetEntries(std::string& buffer)
+{
+    auto header = miopen::kpack::Header{};
+    std::memcpy(&header, buffer.data(), sizeof(header));
+    return reinterpret_cast<miopen::kpack::Entry*>(&buffer[header.entries_offset]);
+}
+
+bool IsValid(const std::string& buffer)
+{
+    return miopen::kpack::PackView{buffer.data(), buffer.size()}.IsValid();
+}
+
+} // namespace
+
+TEST(CPU_KernPack_NONE, Lookup)
+{
+    const auto buffer = WritePack();
+    const auto pack   = miopen::kpack::PackView{buffer.data(), buffer.size()};
+    ASSERT_TRUE(pack.IsValid());
+    ASSERT_FALSE((miopen::kpack::PackView{buffer.data(), buffer.size() - 1}.IsValid()));
+    EXPECT_EQ(pack.Count(), 3);
+
+    auto item = miopen::kpack::Item{};
+    for(auto i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(pack.Find(records[i].name, records[i].args, item));
+        EXPECT_EQ(item.name, records[i].name);
+        EXPECT_EQ(item.args, records[i].args);
+        const auto expected = Blob(records[i]);
+        EXPECT_EQ(item.blob, (std::string_view{expected.data(), expected.size()}));
+        // Each code object starts on its own page.
+        EXPECT_EQ((item.blob.data() - buffer.data()) % miopen::kpack::PageSize, 0);
+    }
+
+    EXPECT_FALSE(pack.Find("kernel_a.o", "-O3", item));
+    EXPECT_FALSE(pack.Find("kernel_c.o", "-O3 -mcpu=gfx90a", item));
+    // The name and the args are not just concatenated.
+    EXPECT_FALSE(pack.Find("kernel_a.o-O3", " -mcpu=gfx90a", item));
+}
+
+TEST(CPU_KernPack_NONE, WrongSizeThrows)
+{
+    auto out = std::ostringstream{};
+    EXPECT_THROW(miopen::kpack::WritePack(records,
+                                          {},
+                                          out,
+                                          [](const miopen::kpack::SourceRecord&) {
+                                              return std::vector<char>(3);
+                                          }),
+                 std::runtime_error);
+}
+
+TEST(CPU_KernPack_NONE, Mapped)
+{
+    miopen::TempFile file{"kern-pack"};
+    std::ofstream{file.Path(), std::ios::binary} << WritePack({42, 1700000000});
+
+    const auto mapped = miopen::MappedFile{file};
+    const auto pack   = miopen::kpack::PackView{mapped.Data(), mapped.Size()};
+    ASSERT_TRUE(pack.IsValid());
+    EXPECT_EQ(pack.GetSource(), (miopen::kpack::SourceStamp{42, 1700000000}));
+
+    auto item = miopen::kpack::Item{};
+    ASSERT_TRUE(pack.Find(records[0].name, records[0].args, item));
+    EXPECT_EQ(item.blob.size(), records[0].size);
+}
+
+TEST(CPU_KernPack_NONE, KeyOutOfBounds)
+{
+    auto buffer = WritePack();
+    ASSERT_TRUE(IsValid(buffer));
+    // Would wrap around if added to the key size.
+    GetEntries(buffer)[0].key_offset = std::numeric_limits<std::uint64_t>::max() - 1;
+    EXPECT_FALSE(IsValid(buffer));
+}
+
+TEST(CPU_KernPack_NONE, UnsortedEntries)
+{
+    auto buffer   = WritePack();
+    auto* entries = GetEntries(buffer);
+    ASSERT_NE(entries[0].hash, entries[1].hash);
+    std::swap(entries[0], entries[1]);
+    EXPECT_FALSE(IsValid(buffer));
+}
+
+TEST(CPU_KernPack_NONE, SourceStamp)
+{
+    miopen::TempFile file{"kern-pack-source"};
+    std::ofstream{file.Path(), std::ios::binary} << "kdb";
+
+    auto stamp = miopen::kpack::SourceStamp{};
+    ASSERT_TRUE(miopen::kpack::GetSourceStamp(file.Path().string(), stamp));
+    EXPECT_EQ(stamp.size, 3u);
+    EXPECT_NE(stamp.mtime, 0u);
+
+    EXPECT_FALSE(miopen::kpack::GetSourceStamp(file.Path().string() + ".missing", stamp));
+}
@@ -0,0 +1,123 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/kernel_cache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+miopen::Kernel MakeKernel(const std::string& name)
+{
+    auto kernel = miopen::Kernel{};
+    kernel.name = name;
+    return kernel;
+}
+
+} // namespace
+
+TEST(CPU_KernelCache_NONE, Lookup)
+{
+    auto cache = miopen::KernelCache{};
+    cache.AddKernel("algo", "config", MakeKernel("k0"), 0);
+    cache.AddKernel("algo", "config", MakeKernel("k1"), 1);
+
+    const auto& kernels = cache.GetKernels("algo", "config");
+    ASSERT_EQ(kernels.size(), 2);
+    EXPECT_EQ(kernels[0].name, "k0");
+    EXPECT_EQ(kernels[1].name, "k1");
+
+    EXPECT_EQ(&cache.GetKernels(std::string{"algo"}, std::string{"config"}), &kernels);
+
+    EXPECT_TRUE(cache.GetKernels("algo", "other").empty());
+    EXPECT_TRUE(cache.GetKernels("other", "config").empty());
+
+    cache.ClearKernels("algo", "config");
+    EXPECT_TRUE(cache.GetKernels("algo", "config").empty());
+    EXPECT_ANY_THROW(cache.ClearKernels("", "config"));
+}
+
+TEST(CPU_KernelCache_NONE, KeyOutlivesArguments)
+{
+    auto cache = miopen::KernelCache{};
+    {
+        const auto algorithm = std::string{"algo"};
+        const auto config    = std::string(64, 'x');
+        cache.AddKernel(algorithm, config, MakeKernel("k"), 0);
+    }
+
+    ASSERT_EQ(cache.GetKernels("algo", std::string(64, 'x')).size(), 1);
+    EXPECT_TRUE(cache.GetKernels("algo", std::string(64, 'y')).empty());
+}
+
+TEST(CPU_KernelCache_NONE, Programs)
+{
+    auto cache = miopen::KernelCache{};
+    EXPECT_FALSE(cache.HasProgram("prog.cl", "-DA=1"));
+
+    cache.AddProgram(miopen::Program{}, "prog.cl", "-DA=1");
+    EXPECT_TRUE(cache.HasProgram("prog.cl", "-DA=1"));
+    EXPECT_FALSE(cache.HasProgram("prog.cl", "-DA=2"));
+
+    cache.ClearProgram("prog.cl", "-DA=1");
+    EXPECT_FALSE(cache.HasProgram("prog.cl", "-DA=1"));
+}
+
+TEST(CPU_KernelCache_NONE, ConcurrentReads)
+{
+    constexpr auto configs = 64;
+    auto cache             = miopen::KernelCache{};
+    for(auto i = 0; i < configs; ++i)
+        cache.AddKernel("algo", std::to_string(i), MakeKernel(std::to_string(i)), 0);
+
+    auto readers = std::vector<std::thread>{};
+    auto failed  = std::vector<int>(4, 0);
+    for(auto t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&, t]() {
+            for(auto i = 0; i < 10000; ++i)
+            {
+                const auto config   = std::to_string((i + t) % configs);
+                const auto& kernels = cache.GetKernels("algo", config);
+                if(kernels.size() != 1 || kernels.front().name != config)
+                    ++failed[t];
+            }
+        });
+    }
+
+    // Writes to other keys may happen meanwhile.
+    for(auto i = 0; i < 1000; ++i)
+        cache.AddKernel("other", std::to_string(i), MakeKernel("k"), 0);
+
+    for(auto& reader : readers)
+        reader.join();
+    for(const auto f : failed)
+        EXPECT_EQ(f, 0);
+}
@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_LOG_ASYNC)
+
+namespace {
+
+/// The background writer doesn't touch std::cerr while there is nothing queued, so the
+/// queues are flushed before the buffer is swapped. Nothing is queued after that, as async
+/// logging is disabled before the capture ends, see AsyncLogging.
+struct CerrCapture
+{
+    std::stringstream buffer;
+    std::streambuf* old = nullptr;
+
+    CerrCapture()
+    {
+        miopen::LoggingFlush();
+        old = std::cerr.rdbuf(buffer.rdbuf());
+    }
+
+    CerrCapture(const CerrCapture&) = delete;
+    CerrCapture& operator=(const CerrCapture&) = delete;
+
+    ~CerrCapture()
+    {
+        miopen::LoggingFlush();
+        std::cerr.rdbuf(old);
+    }
+};
+
+struct AsyncLogging
+{
+    AsyncLogging() { miopen::env::update(MIOPEN_LOG_ASYNC, true); }
+
+    ~AsyncLogging()
+    {
+        // Disabled first, so nothing is queued after the flush.
+        miopen::env::clear(MIOPEN_LOG_ASYNC);
+        miopen::LoggingFlush();
+    }
+};
+
+} // namespace
+
+TEST(CPU_LogAsync_NONE, KeepsOrderOfEachThread)
+{
+    constexpr int n_threads = 4;
+    constexpr int n_records = 100;
+
+    auto capture = CerrCapture{};
+    {
+        const auto async = AsyncLogging{};
+
+        auto threads = std::vector<std::thread>{};
+        for(int t = 0; t < n_threads; ++t)
+        {
+            threads.emplace_back([t]() {
+                for(int i = 0; i < n_records; ++i)
+                    MIOPEN_LOG_W("log_async " << t << ' ' << i);
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+    }
+
+    auto next = std::vector<int>(n_threads, 0);
+    auto line = std::string{};
+    while(std::getline(capture.buffer, line))
+    {
+        const auto pos = line.find("log_async ");
+        if(pos == std::string::npos)
+            continue;
+        auto fields = std::istringstream{line.substr(pos + 10)};
+        int t, i;
+        fields >> t >> i;
+        ASSERT_EQ(i, next.at(t)) << line;
+        ++next[t];
+    }
+
+    for(int t = 0; t < n_threads; ++t)
+        EXPECT_EQ(next[t], n_records);
+}
+
+TEST(CPU_LogAsync_NONE, WritesErrorsImmediately)
+{
+    auto capture     = CerrCapture{};
+    const auto async = AsyncLogging{};
+
+    MIOPEN_LOG_E("log_async error");
+    EXPECT_NE(capture.buffer.str().find("log_async error"), std::string::npos);
+}
@@ -27,6 +27,7 @@
 #include <miopen/mt_queue.hpp>
 #include <thread>
 #include <chrono>
+#include <memory>
 
 #include "random.hpp"
 
@@ -67,7 +68,8 @@ TEST(CPU_UtilMultiThreadQueue_NONE, Basic)
     for(auto idx = 0; idx < data_len; ++idx)
     {
         auto res = comp_queue.pop();
-        std::cerr << res << std::endl;
+        ASSERT_TRUE(res);
+        std::cerr << *res << std::endl;
         num_cons++;
     }
 
@@ -79,3 +81,50 @@ TEST(CPU_UtilMultiThreadQueue_NONE, Basic)
         std::cout << tmp << std::endl;
     EXPECT_EQ(num_prod, num_cons);
 }
+
+TEST(CPU_UtilMultiThreadQueue_NONE, Bounded)
+{
+    ThreadSafeQueue<std::unique_ptr<int>> comp_queue{2};
+    std::atomic<int> pushed{0};
+
+    std::thread producer([&]() {
+        for(auto idx = 0; idx < 5; ++idx)
+        {
+            EXPECT_TRUE(comp_queue.push(std::make_unique<int>(idx)));
+            ++pushed;
+        }
+        comp_queue.close();
+    });
+
+    // The producer can't run more than two items ahead
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(pushed, 2);
+
+    for(auto idx = 0; idx < 5; ++idx)
+    {
+        const auto res = comp_queue.pop();
+        ASSERT_TRUE(res);
+        EXPECT_EQ(**res, idx);
+    }
+    // Closed and drained
+    EXPECT_FALSE(comp_queue.pop());
+    producer.join();
+}
+
+TEST(CPU_UtilMultiThreadQueue_NONE, CloseReleasesProducers)
+{
+    ThreadSafeQueue<int> comp_queue{1};
+    EXPECT_TRUE(comp_queue.push(0));
+
+    std::thread producer([&]() { EXPECT_FALSE(comp_queue.push(1)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    comp_queue.close();
+    producer.join();
+
+    EXPECT_TRUE(comp_queue.closed());
+    EXPECT_FALSE(comp_queue.push(2));
+    const auto res = comp_queue.pop();
+    ASSERT_TRUE(res);
+    EXPECT_EQ(*res, 0);
+    EXPECT_FALSE(comp_queue.pop());
+}
@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/par_for.hpp>
+#include <miopen/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(CPU_ParFor_NONE, VisitsEachIndexOnce)
+{
+    for(const std::size_t n : {0, 1, 7, 64, 1000, 100003})
+    {
+        auto visits = std::vector<std::atomic<int>>(n);
+        miopen::par_for(n, [&](std::size_t i) { ++visits[i]; });
+        for(std::size_t i = 0; i < n; ++i)
+            ASSERT_EQ(visits[i].load(), 1) << "n=" << n << ", i=" << i;
+    }
+}
+
+TEST(CPU_ParFor_NONE, MaxThreadsAndStrided)
+{
+    const std::size_t n = 1000;
+    auto visits         = std::vector<std::atomic<int>>(n);
+    miopen::par_for(n, miopen::max_threads{3}, [&](std::size_t i) { ++visits[i]; });
+    miopen::par_for_strided(n, miopen::max_threads{3}, [&](std::size_t i) { ++visits[i]; });
+    for(std::size_t i = 0; i < n; ++i)
+        ASSERT_EQ(visits[i].load(), 2) << "i=" << i;
+}
+
+TEST(CPU_ParFor_NONE, Nested)
+{
+    // Each outer iteration starts a loop of its own while all pool threads may be busy.
+    const std::size_t outer = 64;
+    const std::size_t inner = 512;
+    auto sums               = std::vector<std::size_t>(outer);
+    miopen::par_for(outer, miopen::min_grain{1}, [&](std::size_t i) {
+        auto sum = std::atomic<std::size_t>{0};
+        miopen::par_for(inner, miopen::min_grain{1}, [&](std::size_t j) { sum += j; });
+        sums[i] = sum;
+    });
+    for(const auto sum : sums)
+        ASSERT_EQ(sum, inner * (inner - 1) / 2);
+}
+
+TEST(CPU_ParFor_NONE, RethrowsException)
+{
+    auto& pool = miopen::ThreadPool::Get();
+    EXPECT_THROW(pool.ParallelFor(10000,
+                                  pool.Size(),
+                                  16,
+                                  [](std::size_t i) {
+                                      if(i == 5000)
+                                          throw std::runtime_error("failure");
+                                  }),
+                 std::runtime_error);
+
+    // The pool is still usable afterwards
+    auto count = std::atomic<std::size_t>{0};
+    pool.ParallelFor(10000, pool.Size(), 16, [&](std::size_t) { ++count; });
+    EXPECT_EQ(count.load(), 10000);
+}
+
+TEST(CPU_ParFor_NONE, OwnPool)
+{
+    auto pool  = miopen::ThreadPool{4};
+    auto count = std::atomic<std::size_t>{0};
+    pool.ParallelFor(1000, pool.Size(), 1, [&](std::size_t) { ++count; });
+    EXPECT_EQ(pool.Size(), 5);
+    EXPECT_EQ(count.load(), 1000);
+}
@@ -0,0 +1,206 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/program_cache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+using Key = miopen::ProgramCache::Key;
+
+const auto key_a = Key{0, "a.cl", "-DA=1", "", false};
+
+const auto handle_a = reinterpret_cast<const void*>(0x10);
+const auto handle_b = reinterpret_cast<const void*>(0x20);
+
+} // namespace
+
+TEST(CPU_ProgramCache_NONE, HitsAndMisses)
+{
+    auto cache = miopen::ProgramCache{};
+    auto loads = 0;
+    const auto load = [&]() {
+        ++loads;
+        return miopen::Program{};
+    };
+
+    const auto first = cache.GetOrLoad(key_a, handle_a, load);
+    EXPECT_EQ(cache.GetOrLoad(key_a, handle_a, load), first);
+    std::ignore = cache.GetOrLoad(Key{1, "a.cl", "-DA=1", "", false}, handle_a, load);
+    std::ignore = cache.GetOrLoad(Key{0, "a.cl", "-DA=1", "", true}, handle_a, load);
+    std::ignore = cache.GetOrLoad(Key{0, "a.cl", "-DA=2", "", false}, handle_a, load);
+
+    EXPECT_EQ(loads, 4);
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 4);
+    EXPECT_EQ(stats.deduplicated, 0);
+}
+
+TEST(CPU_ProgramCache_NONE, ConcurrentLoadsAreDeduplicated)
+{
+    constexpr auto n_threads = 8;
+
+    auto cache   = miopen::ProgramCache{};
+    auto loads   = std::atomic<int>{0};
+    auto results = std::vector<miopen::Program>(n_threads);
+    auto threads = std::vector<std::thread>{};
+
+    for(auto i = 0; i < n_threads; ++i)
+    {
+        threads.emplace_back([&, i]() {
+            results[i] = cache.GetOrLoad(key_a, handle_a, [&]() {
+                ++loads;
+                // Give the other threads time to find the build in flight.
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                return miopen::Program{};
+            });
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(loads, 1);
+    for(const auto& result : results)
+        EXPECT_EQ(result, results.front());
+
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.hits + stats.deduplicated, n_threads - 1);
+}
+
+TEST(CPU_ProgramCache_NONE, FailedLoadIsNotCached)
+{
+    auto cache = miopen::ProgramCache{};
+
+    EXPECT_THROW(cache.GetOrLoad(
+                     key_a, handle_a, []() -> miopen::Program { throw std::runtime_error{""}; }),
+                 std::runtime_error);
+
+    auto loads = 0;
+    std::ignore = cache.GetOrLoad(key_a, handle_a, [&]() {
+        ++loads;
+        return miopen::Program{};
+    });
+    EXPECT_EQ(loads, 1);
+}
+
+TEST(CPU_ProgramCache_NONE, Erase)
+{
+    auto cache = miopen::ProgramCache{};
+    auto loads = 0;
+    const auto load = [&]() {
+        ++loads;
+        return miopen::Program{};
+    };
+
+    std::ignore = cache.GetOrLoad(key_a, handle_a, load);
+    std::ignore = cache.GetOrLoad(Key{0, "a.cl", "-DA=1", "source", true}, handle_a, load);
+    std::ignore = cache.GetOrLoad(Key{0, "a.cl", "-DA=2", "", false}, handle_a, load);
+    std::ignore = cache.GetOrLoad(Key{1, "a.cl", "-DA=1", "", false}, handle_a, load);
+    EXPECT_EQ(loads, 4);
+
+    cache.Erase(0, "a.cl", "-DA=1");
+    std::ignore = cache.GetOrLoad(key_a, handle_a, load);
+    std::ignore = cache.GetOrLoad(Key{0, "a.cl", "-DA=1", "source", true}, handle_a, load);
+    std::ignore = cache.GetOrLoad(Key{0, "a.cl", "-DA=2", "", false}, handle_a, load);
+    std::ignore = cache.GetOrLoad(Key{1, "a.cl", "-DA=1", "", false}, handle_a, load);
+    EXPECT_EQ(loads, 6);
+
+    cache.Clear();
+    std::ignore = cache.GetOrLoad(key_a, handle_a, load);
+    EXPECT_EQ(loads, 7);
+}
+
+TEST(CPU_ProgramCache_NONE, Release)
+{
+    auto cache = miopen::ProgramCache{};
+    auto loads = 0;
+    const auto load = [&]() {
+        ++loads;
+        return miopen::Program{};
+    };
+
+    std::ignore = cache.GetOrLoad(key_a, handle_a, load);
+    std::ignore = cache.GetOrLoad(key_a, handle_b, load);
+    std::ignore = cache.GetOrLoad(Key{0, "a.cl", "-DA=2", "", false}, handle_a, load);
+    EXPECT_EQ(cache.Size(), 2);
+
+    // Programs used by another handle survive.
+    cache.Release(handle_a);
+    EXPECT_EQ(cache.Size(), 1);
+    std::ignore = cache.GetOrLoad(key_a, handle_b, load);
+    EXPECT_EQ(loads, 2);
+
+    cache.Release(handle_b);
+    EXPECT_EQ(cache.Size(), 0);
+    std::ignore = cache.GetOrLoad(key_a, handle_b, load);
+    EXPECT_EQ(loads, 3);
+}
+
+TEST(CPU_ProgramCache_NONE, FailedLoadKeepsNewerLoad)
+{
+    auto cache   = miopen::ProgramCache{};
+    auto started = std::promise<void>{};
+    auto fail    = std::promise<void>{};
+
+    auto failing = std::thread([&]() {
+        EXPECT_THROW(cache.GetOrLoad(key_a,
+                                     handle_a,
+                                     [&]() -> miopen::Program {
+                                         started.set_value();
+                                         fail.get_future().wait();
+                                         throw std::runtime_error{""};
+                                     }),
+                     std::runtime_error);
+    });
+
+    // Replace the load in flight by a newer one before the first fails.
+    started.get_future().wait();
+    cache.Erase(0, "a.cl", "-DA=1");
+    const auto program = cache.GetOrLoad(key_a, handle_b, []() { return miopen::Program{}; });
+    fail.set_value();
+    failing.join();
+
+    auto loads = 0;
+    EXPECT_EQ(cache.GetOrLoad(key_a,
+                              handle_b,
+                              [&]() {
+                                  ++loads;
+                                  return miopen::Program{};
+                              }),
+              program);
+    EXPECT_EQ(loads, 0);
+}
@@ -0,0 +1,175 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/readonly_db_image.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace {
+
+struct Values
+{
+    std::string str;
+    bool Deserialize(const std::string& s)
+    {
+        str = s;
+        return true;
+    }
+};
+
+const std::string text_db = "1x2x3=SolverA:1,2,3;SolverB:4\n"
+                            "\n"
+                            "ill-formed line\n"
+                            "0x0x0=SolverC:5\n"
+                            "1x2x3=SolverD:ignored duplicate\n";
+
+void WriteTextDb(const miopen::fs::path& path)
+{
+    std::ofstream{path, std::ios::binary} << text_db;
+}
+
+void WriteImage(const miopen::fs::path& path, std::uint64_t source_size)
+{
+    auto in  = std::istringstream{text_db};
+    auto out = std::ofstream{path + miopen::rodb::Extension, std::ios::binary};
+    miopen::rodb::WriteImage(in, source_size, out, [](unsigned) {});
+}
+
+std::string MakeImage()
+{
+    auto in  = std::istringstream{text_db};
+    auto out = std::ostringstream{};
+    miopen::rodb::WriteImage(in, text_db.size(), out, [](unsigned) {});
+    return out.str();
+}
+
+miopen::rodb::Entry* GetEntries(std::string& buffer)
+{
+    auto header = miopen::rodb::Header{};
+    std::memcpy(&header, buffer.data(), sizeof(header));
+    return reinterpret_cast<miopen::rodb::Entry*>(&buffer[header.entries_offset]);
+}
+
+bool IsValid(const std::string& buffer)
+{
+    return miopen::rodb::ImageView{buffer.data(), buffer.size()}.IsValid();
+}
+
+} // namespace
+
+TEST(CPU_ReadonlyDbImage_NONE, Lookup)
+{
+    auto in      = std::istringstream{text_db};
+    auto out     = std::ostringstream{};
+    const auto n = miopen::rodb::WriteImage(in, text_db.size(), out, [](unsigned) {});
+    ASSERT_EQ(n, 2);
+
+    const auto buffer = out.str();
+    const auto image  = miopen::rodb::ImageView{buffer.data(), buffer.size()};
+    ASSERT_TRUE(image.IsValid());
+    ASSERT_FALSE((miopen::rodb::ImageView{buffer.data(), buffer.size() - 1}.IsValid()));
+
+    auto item = miopen::rodb::Item{};
+    ASSERT_TRUE(image.Find("1x2x3", item));
+    EXPECT_EQ(item.content, "SolverA:1,2,3;SolverB:4");
+    EXPECT_EQ(item.line, 1);
+    ASSERT_TRUE(image.Find("0x0x0", item));
+    EXPECT_EQ(item.content, "SolverC:5");
+    EXPECT_FALSE(image.Find("1x2x", item));
+    EXPECT_FALSE(image.Find("2x2x3", item));
+}
+
+TEST(CPU_ReadonlyDbImage_NONE, KeyOutOfBounds)
+{
+    auto buffer = MakeImage();
+    ASSERT_TRUE(IsValid(buffer));
+    // Would wrap around if added to the key size.
+    GetEntries(buffer)[0].key_offset = std::numeric_limits<std::uint64_t>::max() - 1;
+    EXPECT_FALSE(IsValid(buffer));
+}
+
+TEST(CPU_ReadonlyDbImage_NONE, UnsortedEntries)
+{
+    auto buffer   = MakeImage();
+    auto* entries = GetEntries(buffer);
+    std::swap(entries[0], entries[1]);
+    EXPECT_FALSE(IsValid(buffer));
+}
+
+TEST(CPU_ReadonlyRamDbImage_NONE, MappedMatchesText)
+{
+    miopen::TempFile mapped{"rodb-mapped"};
+    miopen::TempFile text{"rodb-text"};
+    WriteTextDb(mapped);
+    WriteTextDb(text);
+    WriteImage(mapped, text_db.size());
+
+    using miopen::DbKinds;
+    const auto& mapped_db = miopen::ReadonlyRamDb::GetCached(DbKinds::PerfDb, mapped, false);
+    const auto& text_db_  = miopen::ReadonlyRamDb::GetCached(DbKinds::PerfDb, text, false);
+    ASSERT_TRUE(mapped_db.IsMapped());
+    ASSERT_FALSE(text_db_.IsMapped());
+
+    for(const auto& key : {"1x2x3", "0x0x0", "unknown"})
+    {
+        const auto from_image = mapped_db.FindRecord(std::string{key});
+        const auto from_text  = text_db_.FindRecord(std::string{key});
+        ASSERT_EQ(from_image.has_value(), from_text.has_value());
+        if(!from_text)
+            continue;
+
+        auto image_values = Values{};
+        auto text_values  = Values{};
+        for(const auto& id : {"SolverA", "SolverB", "SolverC", "SolverD"})
+        {
+            ASSERT_EQ(from_image->GetValues(id, image_values),
+                      from_text->GetValues(id, text_values));
+            EXPECT_EQ(image_values.str, text_values.str);
+        }
+    }
+
+    EXPECT_EQ(mapped_db.GetCacheMap().size(), text_db_.GetCacheMap().size());
+}
+
+TEST(CPU_ReadonlyRamDbImage_NONE, StaleImageIsIgnored)
+{
+    miopen::TempFile stale{"rodb-stale"};
+    WriteTextDb(stale);
+    WriteImage(stale, text_db.size() + 1);
+
+    const auto& db = miopen::ReadonlyRamDb::GetCached(miopen::DbKinds::PerfDb, stale, false);
+    EXPECT_FALSE(db.IsMapped());
+    EXPECT_TRUE(db.FindRecord(std::string{"0x0x0"}));
+}
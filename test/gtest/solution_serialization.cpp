@@ -0,0 +1,277 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/convolution.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/solution.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_SAVE_SOLUTION_AS_BINARY)
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_DEVICE_ARCH)
+
+namespace {
+
+std::vector<std::uint8_t> SaveBinary(const miopen::Solution& solution)
+{
+    struct BinaryFormat
+    {
+        BinaryFormat() { miopen::env::update(MIOPEN_SAVE_SOLUTION_AS_BINARY, true); }
+        ~BinaryFormat() { miopen::env::clear(MIOPEN_SAVE_SOLUTION_AS_BINARY); }
+    } const binary_format;
+
+    return solution.Save();
+}
+
+miopen::Solution Load(const std::vector<std::uint8_t>& data, std::size_t size)
+{
+    return miopen::Solution::Load(reinterpret_cast<const char*>(data.data()), size);
+}
+
+miopen::Solution Load(const std::vector<std::uint8_t>& data) { return Load(data, data.size()); }
+
+miopen::Solution MakeSolution()
+{
+    auto problem = miopen::Problem{};
+    problem.SetDirection(miopenProblemDirectionForward);
+    problem.SetOperatorDescriptor(miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}});
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionX,
+                                     miopen::TensorDescriptor{miopenFloat, {1, 8, 16, 16}});
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionW,
+                                     miopen::TensorDescriptor{miopenFloat, {16, 8, 3, 3}});
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionY,
+                                     miopen::TensorDescriptor{miopenFloat, {1, 16, 16, 16}});
+
+    auto solution = miopen::Solution{miopen::solver::Id{"ConvDirectNaiveConvFwd"}, 1.5f, 1024};
+    solution.SetProblem({problem});
+    solution.SetPerfConfig("1,2,3");
+    return solution;
+}
+
+void ExpectEqual(const miopen::Solution& l, const miopen::Solution& r)
+{
+    EXPECT_EQ(l.GetTime(), r.GetTime());
+    EXPECT_EQ(l.GetWorkspaceSize(), r.GetWorkspaceSize());
+    EXPECT_EQ(l.GetSolver(), r.GetSolver());
+    ASSERT_EQ(l.GetKernels().size(), r.GetKernels().size());
+    for(auto i = 0u; i < l.GetKernels().size(); ++i)
+    {
+        const auto& lk = l.GetKernels()[i];
+        const auto& rk = r.GetKernels()[i];
+        EXPECT_EQ(lk.kernel_name, rk.kernel_name);
+        EXPECT_EQ(lk.program_name, rk.program_name);
+        EXPECT_EQ(lk.local_work_dims, rk.local_work_dims);
+        EXPECT_EQ(lk.global_work_dims, rk.global_work_dims);
+    }
+
+    const auto& lp = std::get<miopen::Problem>(l.GetProblem().item);
+    const auto& rp = std::get<miopen::Problem>(r.GetProblem().item);
+    EXPECT_EQ(lp.GetDirection(), rp.GetDirection());
+    EXPECT_EQ(lp.GetTensorDescriptor(miopenTensorConvolutionX),
+              rp.GetTensorDescriptor(miopenTensorConvolutionX));
+    EXPECT_EQ(lp.GetTensorDescriptor(miopenTensorConvolutionW),
+              rp.GetTensorDescriptor(miopenTensorConvolutionW));
+}
+
+} // namespace
+
+TEST(CPU_SolutionSerialization_NONE, Default)
+{
+    // The binary format is opt-in, by default solutions are saved as msgpack encoded json.
+    const auto solution = MakeSolution();
+    const auto data     = solution.Save();
+    EXPECT_EQ(data, nlohmann::json::to_msgpack(nlohmann::json(solution)));
+    ExpectEqual(solution, Load(data));
+}
+
+TEST(CPU_SolutionSerialization_NONE, Binary)
+{
+    const auto solution = MakeSolution();
+    const auto data     = SaveBinary(solution);
+    ASSERT_GE(data.size(), 8u);
+    EXPECT_EQ(std::memcmp(data.data(), "MIOSOLN", 8), 0);
+    ExpectEqual(solution, Load(data));
+}
+
+TEST(CPU_SolutionSerialization_NONE, Msgpack)
+{
+    const auto solution = MakeSolution();
+    const auto data     = nlohmann::json::to_msgpack(nlohmann::json(solution));
+    ExpectEqual(solution, Load(data));
+}
+
+TEST(CPU_SolutionSerialization_NONE, Truncated)
+{
+    const auto solution = MakeSolution();
+    for(const auto& data : {solution.Save(), SaveBinary(solution)})
+    {
+        for(const auto size : {std::size_t{0}, std::size_t{8}, data.size() / 2, data.size() - 1})
+            EXPECT_THROW(Load(data, size), miopen::Exception) << size;
+    }
+}
+
+TEST(CPU_SolutionSerialization_NONE, Corrupt)
+{
+    auto data = SaveBinary(MakeSolution());
+
+    // Header: magic[8], version, code object count, description offset, description size.
+    auto version = data;
+    version[8] ^= 0xff;
+    EXPECT_THROW(Load(version), miopen::Exception);
+
+    auto description_offset = data;
+    std::fill_n(description_offset.begin() + 16, 8, 0xff);
+    EXPECT_THROW(Load(description_offset), miopen::Exception);
+
+    auto code_objects = data;
+    std::fill_n(code_objects.begin() + 12, 4, 0xff);
+    EXPECT_THROW(Load(code_objects), miopen::Exception);
+
+    auto description = data;
+    std::fill(description.begin() + 32, description.end(), 0xc1); // 0xc1 is never used in msgpack
+    EXPECT_THROW(Load(description), miopen::Exception);
+
+    auto msgpack = nlohmann::json::to_msgpack(nlohmann::json(MakeSolution()));
+    std::fill(msgpack.begin(), msgpack.begin() + msgpack.size() / 2, 0xc1);
+    EXPECT_THROW(Load(msgpack), miopen::Exception);
+}
+
+#if MIOPEN_BACKEND_HIP
+
+namespace {
+
+class CPU_SolutionSerializationCodeObjects_NONE : public ::testing::Test
+{
+protected:
+    // Skips loading the fake code objects as modules.
+    void SetUp() override { miopen::env::update(MIOPEN_DEVICE_ARCH, "gfx90a"); }
+    void TearDown() override { miopen::env::clear(MIOPEN_DEVICE_ARCH); }
+
+    static std::vector<char> MakeCodeObject(std::size_t size, char seed)
+    {
+        auto code_object = std::vector<char>(size);
+        for(auto i = 0u; i < size; ++i)
+            code_object[i] = static_cast<char>(seed + i * 7);
+        return code_object;
+    }
+
+    miopen::Solution MakeSolutionWithCodeObjects()
+    {
+        auto in_memory = miopen::HIPOCProgram{"in_memory.o", in_memory_code_object};
+        in_memory.AttachBinary(in_memory_code_object);
+
+        {
+            auto out = std::ofstream{file.Path(), std::ios::binary};
+            out.write(in_file_code_object.data(), in_file_code_object.size());
+        }
+        auto in_file = miopen::HIPOCProgram{"in_file.o", in_file_code_object};
+        in_file.AttachBinary(file.Path());
+
+        auto kernels = std::vector<miopen::solver::KernelInfo>{
+            {"", {64, 1, 1}, {1024, 1, 1}, "in_memory.o", "first"},
+            {"", {256, 1, 1}, {4096, 2, 1}, "in_file.o", "second"},
+        };
+
+        auto solution = MakeSolution();
+        solution.SetInvoker({}, {in_memory, in_file}, kernels);
+        return solution;
+    }
+
+    std::vector<char> in_memory_code_object = MakeCodeObject(1000, 1);
+    std::vector<char> in_file_code_object   = MakeCodeObject(333, 5);
+    miopen::TempFile file{"miopen-solution-serialization"};
+};
+
+bool Contains(const std::vector<std::uint8_t>& data,
+              const std::vector<char>& code_object,
+              std::size_t alignment)
+{
+    for(auto offset = std::size_t{0}; offset + code_object.size() <= data.size();
+        offset += alignment)
+    {
+        if(std::memcmp(data.data() + offset, code_object.data(), code_object.size()) == 0)
+            return true;
+    }
+    return false;
+}
+
+} // namespace
+
+TEST_F(CPU_SolutionSerializationCodeObjects_NONE, Binary)
+{
+    const auto solution = MakeSolutionWithCodeObjects();
+    const auto data     = SaveBinary(solution);
+
+    // Code objects are stored as is, at offsets aligned to 64 bytes.
+    EXPECT_TRUE(Contains(data, in_memory_code_object, 64));
+    EXPECT_TRUE(Contains(data, in_file_code_object, 64));
+
+    const auto loaded = Load(data);
+    ExpectEqual(solution, loaded);
+    EXPECT_FALSE(loaded.GetKernels()[0].program == loaded.GetKernels()[1].program);
+}
+
+TEST_F(CPU_SolutionSerializationCodeObjects_NONE, Msgpack)
+{
+    const auto solution = MakeSolutionWithCodeObjects();
+    ExpectEqual(solution, Load(solution.Save()));
+}
+
+TEST_F(CPU_SolutionSerializationCodeObjects_NONE, Corrupt)
+{
+    const auto data = SaveBinary(MakeSolutionWithCodeObjects());
+
+    for(const auto size : {std::size_t{40}, data.size() / 2, data.size() - 1})
+        EXPECT_THROW(Load(data, size), miopen::Exception) << size;
+
+    // The table of code objects follows the 32 byte header, each entry is {offset, size}.
+    auto offset = data;
+    std::fill_n(offset.begin() + 32, 8, 0xff);
+    EXPECT_THROW(Load(offset), miopen::Exception);
+
+    auto size = data;
+    std::fill_n(size.begin() + 48 + 8, 8, 0x7f);
+    EXPECT_THROW(Load(size), miopen::Exception);
+}
+
+TEST_F(CPU_SolutionSerializationCodeObjects_NONE, MissingCodeObjectFile)
+{
+    const auto solution = MakeSolutionWithCodeObjects();
+    miopen::fs::remove(file.Path());
+    EXPECT_THROW(solution.Save(), miopen::Exception);
+    EXPECT_THROW(SaveBinary(solution), miopen::Exception);
+}
+
+#endif
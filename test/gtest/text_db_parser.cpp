@@ -0,0 +1,141 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/text_db_parser.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct Item
+{
+    int line;
+    std::string content;
+};
+
+using Map = std::map<std::string, Item>;
+
+Map ParseSequentially(const std::string& text, std::vector<int>& ill_formed)
+{
+    auto items  = Map{};
+    auto input  = std::istringstream{text};
+    auto line   = std::string{};
+    auto n_line = 0;
+
+    while(std::getline(input, line))
+    {
+        ++n_line;
+        if(line.empty())
+            continue;
+        const auto key_size = line.find('=');
+        if(key_size == std::string::npos || key_size == 0)
+        {
+            ill_formed.push_back(n_line);
+            continue;
+        }
+        items.emplace(line.substr(0, key_size), Item{n_line, line.substr(key_size + 1)});
+    }
+
+    return items;
+}
+
+} // namespace
+
+TEST(CPU_TextDbParser_NONE, Small)
+{
+    const auto text = std::string{"1x2x3=SolverA:1,2,3;SolverB:4\n"
+                                  "\n"
+                                  "ill-formed line\n"
+                                  "=no key\n"
+                                  "0x0x0=SolverC:5\n"
+                                  "1x2x3=SolverD:ignored duplicate\n"
+                                  "4x4x4=not terminated"};
+
+    auto ill_formed = std::vector<int>{};
+    const auto items =
+        miopen::ParseTextDb<Map>(text, [&](int line) { ill_formed.push_back(line); });
+
+    ASSERT_EQ(items.size(), 3);
+    EXPECT_EQ(items.at("1x2x3").line, 1);
+    EXPECT_EQ(items.at("1x2x3").content, "SolverA:1,2,3;SolverB:4");
+    EXPECT_EQ(items.at("0x0x0").line, 5);
+    EXPECT_EQ(items.at("4x4x4").line, 7);
+    EXPECT_EQ(items.at("4x4x4").content, "not terminated");
+    EXPECT_EQ(ill_formed, (std::vector<int>{3, 4}));
+
+    EXPECT_TRUE(miopen::ParseTextDb<Map>("", [](int) { FAIL(); }).empty());
+}
+
+TEST(CPU_TextDbParser_NONE, ManyChunks)
+{
+    // Several megabytes with duplicates far apart, so they land in different chunks.
+    auto text = std::string{};
+    for(auto i = 0; i < 200000; ++i)
+    {
+        text += std::to_string(i % 150000) + "x3x3=SolverA:" + std::to_string(i) + ",1,2,3\n";
+        if(i % 9999 == 0)
+            text += "ill-formed\n\n";
+    }
+
+    auto expected_ill_formed = std::vector<int>{};
+    const auto expected      = ParseSequentially(text, expected_ill_formed);
+
+    auto mutex      = std::mutex{};
+    auto ill_formed = std::vector<int>{};
+    const auto items = miopen::ParseTextDb<std::unordered_map<std::string, Item>>(
+        text,
+        [&](int line) {
+            const auto lock = std::lock_guard<std::mutex>{mutex};
+            ill_formed.push_back(line);
+        },
+        4);
+
+    ASSERT_EQ(items.size(), expected.size());
+    for(const auto& [key, item] : expected)
+    {
+        const auto& actual = items.at(key);
+        EXPECT_EQ(actual.line, item.line) << key;
+        EXPECT_EQ(actual.content, item.content) << key;
+    }
+
+    std::sort(ill_formed.begin(), ill_formed.end());
+    EXPECT_EQ(ill_formed, expected_ill_formed);
+}
+
+TEST(CPU_TextDbParser_NONE, ReadTextDb)
+{
+    const auto text = std::string(3 * 1024 * 1024, 'x');
+    auto input      = std::istringstream{text};
+    EXPECT_EQ(miopen::ReadTextDb(input), text);
+}
@@ -0,0 +1,122 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/trace.hpp>
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Tracing
+{
+    Tracing()
+    {
+        miopen::trace::Clear();
+        miopen::debug::tracing_enabled = true;
+    }
+
+    ~Tracing()
+    {
+        miopen::debug::tracing_enabled = false;
+        miopen::trace::Clear();
+    }
+};
+
+nlohmann::json WriteTrace()
+{
+    auto ss = std::stringstream{};
+    miopen::trace::Write(ss);
+    return nlohmann::json::parse(ss.str());
+}
+
+} // namespace
+
+TEST(CPU_Trace_NONE, RecordsNestedSpansOfEachThread)
+{
+    constexpr int n_threads = 4;
+    const auto tracing      = Tracing{};
+
+    auto threads = std::vector<std::thread>{};
+    for(int t = 0; t < n_threads; ++t)
+    {
+        threads.emplace_back([t]() {
+            MIOPEN_TRACE_SCOPE("test", "outer");
+            MIOPEN_TRACE_SCOPE("test", [&]() { return "inner \"" + std::to_string(t) + "\""; });
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    const auto trace = WriteTrace();
+    auto spans       = std::map<int, std::map<std::string, nlohmann::json>>{};
+    for(const auto& event : trace.at("traceEvents"))
+    {
+        EXPECT_EQ(event.at("ph"), "X");
+        EXPECT_EQ(event.at("cat"), "test");
+        spans[event.at("tid").get<int>()][event.at("name").get<std::string>()] = event;
+    }
+
+    ASSERT_EQ(spans.size(), n_threads);
+    for(const auto& thread_spans : spans)
+    {
+        ASSERT_EQ(thread_spans.second.size(), 2);
+        const auto& outer = thread_spans.second.at("outer");
+        const auto inner  = std::find_if(thread_spans.second.begin(),
+                                        thread_spans.second.end(),
+                                        [](auto&& span) { return span.first != "outer"; });
+        ASSERT_EQ(inner->first.rfind("inner \"", 0), 0);
+
+        const auto outer_ts = outer.at("ts").get<double>();
+        const auto inner_ts = inner->second.at("ts").get<double>();
+        EXPECT_LE(outer_ts, inner_ts);
+        // Timestamps are rounded to nanoseconds.
+        EXPECT_GE(outer_ts + outer.at("dur").get<double>() + 0.002,
+                  inner_ts + inner->second.at("dur").get<double>());
+    }
+}
+
+TEST(CPU_Trace_NONE, RecordsNothingWhenDisabled)
+{
+    if(miopen::IsTracing())
+        GTEST_SKIP() << "MIOPEN_TRACE_FILE is set";
+
+    miopen::trace::Clear();
+    {
+        MIOPEN_TRACE_SCOPE("test", [&]() -> std::string {
+            ADD_FAILURE() << "The name must not be built when tracing is disabled.";
+            return {};
+        });
+    }
+    EXPECT_TRUE(WriteTrace().at("traceEvents").empty());
+}
@@ -135,6 +135,11 @@ void TestSolverPredictionModel(miopen::conv::ProblemDescription& problem,
     ASSERT_EQ(solver, expected_solver)
         << "TunaNet predicted solver: " << solver
         << " when it should've predicted solver: " << expected_solver << std::endl;
+
+    const auto batch = miopen::ai::immed_mode::PredictSolvers({problem, problem}, ctx, device);
+    ASSERT_EQ(batch.size(), 2);
+    EXPECT_EQ(batch[0], solvers);
+    EXPECT_EQ(batch[1], solvers);
 #else
     std::ignore = problem;
     std::ignore = expected_solver;
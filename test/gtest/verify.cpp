@@ -0,0 +1,246 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "tensor_holder.hpp"
+#include "verify.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <vector>
+
+namespace {
+
+template <class T, class Bits>
+T FromBits(Bits bits)
+{
+    static_assert(sizeof(T) == sizeof(Bits));
+    T value;
+    std::memcpy(static_cast<void*>(&value), &bits, sizeof(T));
+    return value;
+}
+
+/// Bit patterns of a floating point type with a sign bit on top.
+template <class Bits>
+struct Patterns
+{
+    Bits min_denorm;
+    Bits max_denorm;
+    Bits min_normal;
+    Bits sign;
+};
+
+template <class T, class Bits>
+void CheckUlpDistance(const Patterns<Bits>& p)
+{
+    const auto ulps = [](Bits x, Bits y) {
+        return miopen::verify_detail::ulp_distance(FromBits<T>(x), FromBits<T>(y));
+    };
+    const auto neg = [&](Bits x) { return static_cast<Bits>(x | p.sign); };
+
+    EXPECT_EQ(ulps(0, 0), 0);
+    EXPECT_EQ(ulps(p.min_normal, p.min_normal), 0);
+    EXPECT_EQ(ulps(p.min_normal, p.min_normal + 1), 1);
+    EXPECT_EQ(ulps(p.min_normal + 1, p.min_normal), 1);
+
+    // Denormals are consecutive with zero and with the normals.
+    EXPECT_EQ(ulps(0, p.min_denorm), 1);
+    EXPECT_EQ(ulps(p.min_denorm, p.max_denorm), p.max_denorm - p.min_denorm);
+    EXPECT_EQ(ulps(p.max_denorm, p.min_normal), 1);
+
+    // Across zero, the distances of both sides add up.
+    EXPECT_EQ(ulps(neg(p.min_denorm), p.min_denorm), 2);
+    EXPECT_EQ(ulps(neg(p.min_normal), p.min_normal), 2 * p.min_normal);
+    EXPECT_EQ(ulps(neg(p.min_normal), neg(p.min_normal + 1)), 1);
+}
+
+template <class T, class Bits>
+void CheckNonFinite(Bits inf, Bits nan, Bits finite)
+{
+    const auto ulps = [](Bits x, Bits y) {
+        return miopen::verify_detail::ulp_distance(FromBits<T>(x), FromBits<T>(y));
+    };
+
+    EXPECT_EQ(ulps(nan, finite), -1);
+    EXPECT_EQ(ulps(finite, nan), -1);
+    EXPECT_EQ(ulps(nan, nan), -1);
+    EXPECT_EQ(ulps(inf, finite), -1);
+    EXPECT_EQ(ulps(inf, inf), -1);
+}
+
+} // namespace
+
+TEST(CPU_UlpDistance_FP32, Finite)
+{
+    CheckUlpDistance<float, uint32_t>({0x00000001, 0x007FFFFF, 0x00800000, 0x80000000});
+    // Negative zero equals positive zero.
+    EXPECT_EQ(miopen::verify_detail::ulp_distance(0.0f, -0.0f), 0);
+    EXPECT_EQ(miopen::verify_detail::ulp_distance(1.0f, std::nextafter(1.0f, 2.0f)), 1);
+}
+
+TEST(CPU_UlpDistance_FP32, NonFinite)
+{
+    CheckNonFinite<float, uint32_t>(0x7F800000, 0x7FC00000, 0x3F800000);
+    CheckNonFinite<float, uint32_t>(0xFF800000, 0xFFC00000, 0xBF800000);
+}
+
+TEST(CPU_UlpDistance_FP16, Finite)
+{
+    CheckUlpDistance<half, uint16_t>({0x0001, 0x03FF, 0x0400, 0x8000});
+    EXPECT_EQ(miopen::verify_detail::ulp_distance(FromBits<half, uint16_t>(0x8000),
+                                                  FromBits<half, uint16_t>(0x0000)),
+              0);
+}
+
+TEST(CPU_UlpDistance_FP16, NonFinite)
+{
+    CheckNonFinite<half, uint16_t>(0x7C00, 0x7E00, 0x3C00);
+    CheckNonFinite<half, uint16_t>(0xFC00, 0xFE00, 0xBC00);
+}
+
+TEST(CPU_UlpDistance_BFP16, Finite)
+{
+    CheckUlpDistance<bfloat16, uint16_t>({0x0001, 0x007F, 0x0080, 0x8000});
+    EXPECT_EQ(miopen::verify_detail::ulp_distance(FromBits<bfloat16, uint16_t>(0x8000),
+                                                  FromBits<bfloat16, uint16_t>(0x0000)),
+              0);
+}
+
+TEST(CPU_UlpDistance_BFP16, NonFinite)
+{
+    CheckNonFinite<bfloat16, uint16_t>(0x7F80, 0x7FC0, 0x3F80);
+    CheckNonFinite<bfloat16, uint16_t>(0xFF80, 0xFFC0, 0xBF80);
+}
+
+TEST(CPU_UlpDistance_FP8, Finite)
+{
+    CheckUlpDistance<float8, uint8_t>({0x01, 0x07, 0x08, 0x80});
+}
+
+TEST(CPU_UlpDistance_FP8, NonFinite)
+{
+    const auto ulps = [](uint8_t x, uint8_t y) {
+        return miopen::verify_detail::ulp_distance(FromBits<float8>(x), FromBits<float8>(y));
+    };
+
+    if(miopen_f8::get_hip_f8_bias_mode())
+    {
+        // The negative zero pattern is the only NaN, there are no infinities.
+        EXPECT_EQ(ulps(0x80, 0x38), -1);
+        EXPECT_EQ(ulps(0x38, 0x80), -1);
+    }
+    else
+    {
+        CheckNonFinite<float8, uint8_t>(0x78, 0x79, 0x38);
+        EXPECT_EQ(ulps(0x80, 0x00), 0);
+    }
+}
+
+namespace {
+
+/// Larger than several chunks, with an incomplete last one.
+constexpr std::size_t ParallelSize = 3 * miopen::verify_detail::chunk_size + 123;
+
+std::vector<float> MakeData(float offset)
+{
+    auto data = std::vector<float>(ParallelSize);
+    for(std::size_t i = 0; i < data.size(); ++i)
+        data[i] = std::sin(static_cast<float>(i)) * 100.0f + offset;
+    return data;
+}
+
+} // namespace
+
+namespace {
+
+void ExpectSameResult(const miopen::range_compare_result& parallel,
+                      const miopen::range_compare_result& serial)
+{
+    EXPECT_EQ(parallel.count, serial.count);
+    EXPECT_EQ(parallel.mismatch_idx, serial.mismatch_idx);
+    EXPECT_EQ(parallel.max_diff, serial.max_diff);
+    EXPECT_EQ(parallel.max_diff_idx, serial.max_diff_idx);
+    EXPECT_EQ(parallel.max_mag1, serial.max_mag1);
+    EXPECT_EQ(parallel.max_mag2, serial.max_mag2);
+    EXPECT_EQ(parallel.non_finite_idx1, serial.non_finite_idx1);
+    EXPECT_EQ(parallel.non_finite_idx2, serial.non_finite_idx2);
+    EXPECT_EQ(parallel.ulp_histogram, serial.ulp_histogram);
+}
+
+} // namespace
+
+TEST(CPU_VerifyParallel_FP32, MatchesSerial)
+{
+    const auto x = MakeData(0.0f);
+    auto y       = MakeData(0.0f);
+    // Mismatches in the second and the third chunk, the largest one in the last.
+    const auto first_mismatch = miopen::verify_detail::chunk_size + 17;
+    y[first_mismatch] += 1.0f;
+    y[2 * miopen::verify_detail::chunk_size + 5] += 2.0f;
+    y[ParallelSize - 1] += 3.0f;
+
+    // Lists are not random access, so they take the serial code.
+    const auto x_list = std::list<float>(x.begin(), x.end());
+    auto y_list       = std::list<float>(y.begin(), y.end());
+    static_assert(miopen::verify_detail::is_parallel<const std::vector<float>&>);
+    static_assert(not miopen::verify_detail::is_parallel<const std::list<float>&>);
+
+    // Only the summation order differs.
+    EXPECT_NEAR(miopen::rms_range(x, y), miopen::rms_range(x_list, y_list), 1e-12);
+    EXPECT_EQ(miopen::max_diff(x, y), miopen::max_diff(x_list, y_list));
+    EXPECT_EQ(miopen::max_diff(x, y), 3.0);
+
+    const auto equal = [](float a, float b) { return a == b; };
+    EXPECT_EQ(miopen::mismatch_idx(x, y, equal), first_mismatch);
+    EXPECT_EQ(miopen::mismatch_idx(x_list, y_list, equal), first_mismatch);
+
+    const auto parallel = miopen::compare_range(x, y);
+    const auto serial   = miopen::compare_range(x_list, y_list);
+    EXPECT_EQ(parallel.count, ParallelSize);
+    EXPECT_EQ(parallel.max_diff_idx, ParallelSize - 1);
+    ExpectSameResult(parallel, serial);
+    EXPECT_NEAR(parallel.rms(), serial.rms(), 1e-12);
+
+    const auto is_nan = [](float v) { return std::isnan(v); };
+    EXPECT_EQ(miopen::find_idx(x, is_nan), -1);
+    EXPECT_EQ(miopen::find_idx(x_list, is_nan), -1);
+
+    // Non-finite values in two chunks, the first one found.
+    const auto first_nan = 2 * miopen::verify_detail::chunk_size + 9;
+    y[first_nan]         = std::numeric_limits<float>::quiet_NaN();
+    y[ParallelSize - 2]  = std::numeric_limits<float>::quiet_NaN();
+
+    *std::next(y_list.begin(), first_nan)        = y[first_nan];
+    *std::next(y_list.begin(), ParallelSize - 2) = y[ParallelSize - 2];
+
+    EXPECT_EQ(miopen::find_idx(y, is_nan), static_cast<int64_t>(first_nan));
+    EXPECT_EQ(miopen::find_idx(y_list, is_nan), static_cast<int64_t>(first_nan));
+    ExpectSameResult(miopen::compare_range(x, y), miopen::compare_range(x_list, y_list));
+    EXPECT_EQ(miopen::compare_range(x, y).non_finite_idx2, static_cast<int64_t>(first_nan));
+}
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/temp_file.hpp>
+#include <miopen/warm_start_db.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+namespace {
+
+miopen::WarmStartRecord MakeRecord(const std::string& perf_cfg)
+{
+    auto kernel         = miopen::solver::KernelInfo{};
+    kernel.comp_options = " -DMIOPEN_USE_FP32=1 -mcpu=gfx90a:xnack-";
+    kernel.l_wk         = {256, 1, 1};
+    kernel.g_wk         = {65536, 4, 1};
+    kernel.kernel_file  = "MIOpenConvDirUni.cl";
+    kernel.kernel_name  = "MIOpenConvUniC";
+    return {perf_cfg, {kernel, kernel}};
+}
+
+void ExpectEqual(const miopen::WarmStartRecord& l, const miopen::WarmStartRecord& r)
+{
+    EXPECT_EQ(l.perf_cfg, r.perf_cfg);
+    ASSERT_EQ(l.kernels.size(), r.kernels.size());
+    for(std::size_t i = 0; i < l.kernels.size(); ++i)
+    {
+        EXPECT_EQ(l.kernels[i].comp_options, r.kernels[i].comp_options);
+        EXPECT_EQ(l.kernels[i].l_wk, r.kernels[i].l_wk);
+        EXPECT_EQ(l.kernels[i].g_wk, r.kernels[i].g_wk);
+        EXPECT_EQ(l.kernels[i].kernel_file, r.kernels[i].kernel_file);
+        EXPECT_EQ(l.kernels[i].kernel_name, r.kernels[i].kernel_name);
+    }
+}
+
+} // namespace
+
+TEST(CPU_WarmStartDb_NONE, Serialization)
+{
+    const auto key    = miopen::WarmStartDb::Key{"1x2x3;float", "ConvDirectNaiveConvFwd"};
+    const auto record = MakeRecord("16,16,1,1");
+    const auto line   = miopen::WarmStartDb::Serialize(key, record);
+    EXPECT_EQ(line.find('\n'), std::string::npos);
+
+    auto read_key    = miopen::WarmStartDb::Key{};
+    auto read_record = miopen::WarmStartRecord{};
+    ASSERT_TRUE(miopen::WarmStartDb::Deserialize(line, read_key, read_record));
+    EXPECT_EQ(read_key, key);
+    ExpectEqual(read_record, record);
+
+    EXPECT_FALSE(miopen::WarmStartDb::Deserialize("{\"solver\":", read_key, read_record));
+    EXPECT_FALSE(miopen::WarmStartDb::Deserialize("{\"solver\":\"A\"}", read_key, read_record));
+}
+
+TEST(CPU_WarmStartDb_NONE, Persistence)
+{
+    const auto file = miopen::TempFile{"warm-start-db"};
+    const auto key  = miopen::WarmStartDb::Key{"1x2x3;float", "ConvDirectNaiveConvFwd"};
+
+    {
+        auto db = miopen::WarmStartDb{file.Path()};
+        EXPECT_FALSE(db.Find(key));
+        db.Store(key, MakeRecord("1"));
+        db.Store(key, MakeRecord("2"));
+        db.Store({"other", "ConvDirectNaiveConvFwd"}, MakeRecord(""));
+    }
+
+    std::ofstream{file.Path(), std::ios::app} << "ill-formed line" << std::endl;
+
+    auto db           = miopen::WarmStartDb{file.Path()};
+    const auto record = db.Find(key);
+    ASSERT_TRUE(record);
+    ExpectEqual(*record, MakeRecord("2"));
+    EXPECT_TRUE(db.Find({"other", "ConvDirectNaiveConvFwd"}));
+    EXPECT_FALSE(db.Find({"1x2x3;float", "ConvOclDirectFwd"}));
+}
+
+TEST(CPU_WarmStartDb_NONE, Compaction)
+{
+    const auto file        = miopen::TempFile{"warm-start-db"};
+    const auto key         = miopen::WarmStartDb::Key{"1x2x3;float", "ConvDirectNaiveConvFwd"};
+    const auto count_lines = [&]() {
+        auto stream = std::ifstream{file.Path()};
+        auto line   = std::string{};
+        auto n      = 0;
+        while(std::getline(stream, line))
+            ++n;
+        return n;
+    };
+
+    {
+        auto db = miopen::WarmStartDb{file.Path()};
+        for(auto i = 0; i < 5; ++i)
+            db.Store(key, MakeRecord(std::to_string(i)));
+        db.Store({"other", "ConvDirectNaiveConvFwd"}, MakeRecord(""));
+    }
+    EXPECT_EQ(count_lines(), 6);
+
+    auto db           = miopen::WarmStartDb{file.Path()};
+    const auto record = db.Find(key);
+    ASSERT_TRUE(record);
+    ExpectEqual(*record, MakeRecord("4"));
+    EXPECT_TRUE(db.Find({"other", "ConvDirectNaiveConvFwd"}));
+    EXPECT_EQ(count_lines(), 2);
+
+    // Below the threshold the file is left as is.
+    db.Store(key, MakeRecord("5"));
+    EXPECT_EQ(count_lines(), 3);
+    EXPECT_TRUE(miopen::WarmStartDb{file.Path()}.Find(key));
+    EXPECT_EQ(count_lines(), 3);
+}
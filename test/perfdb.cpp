@@ -378,6 +378,41 @@ public:
     }
 };
 
+template <class TDb>
+class DbStoreRecordsTest : public DbTest
+{
+public:
+    DbStoreRecordsTest(TempFile& temp_file_) : DbTest(temp_file_) {}
+
+    void Run() const
+    {
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default,
+                          "Test",
+                          "Testing " << ArgsHelper::db_class::Get<TDb>()
+                                     << " for reading data stored by StoreRecords...");
+
+        const TestData key2(9, 10);
+        const std::array<std::pair<const std::string, TestData>, 1> data2{{{id2(), value2()}}};
+
+        auto records = std::vector<DbRecord>{};
+        records.emplace_back(DbKinds::PerfDb, key());
+        EXPECT(records.back().SetValues(id0(), value0()));
+        EXPECT(records.back().SetValues(id1(), value1()));
+        records.emplace_back(DbKinds::PerfDb, key2);
+        EXPECT(records.back().SetValues(id2(), value2()));
+
+        {
+            TDb db(DbKinds::PerfDb, temp_file);
+
+            EXPECT(db.StoreRecords(records));
+        }
+
+        TDb db{DbKinds::PerfDb, temp_file};
+        ValidateSingleEntry(key(), common_data(), db);
+        ValidateSingleEntry(key2, data2, db);
+    }
+};
+
 template <class TDb>
 class DbUpdateTest : public DbTest
 {
@@ -1490,6 +1525,7 @@ private:
     {
         DbFindTest<TDb>{temp_file}.Run();
         DbStoreTest<TDb>{temp_file}.Run();
+        DbStoreRecordsTest<TDb>{temp_file}.Run();
         DbUpdateTest<TDb>{temp_file}.Run();
         DbRemoveTest<TDb>{temp_file}.Run();
         DbReadTest<TDb>{temp_file}.Run();
@@ -27,9 +27,14 @@
 #define GUARD_VERIFY_HPP
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <cstring>
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <miopen/float_equal.hpp>
 #include <miopen/returns.hpp>
 #include <numeric>
@@ -165,27 +170,271 @@ T range_product(R1&& r1, R2&& r2, T state, Reducer r, Product p)
     return std::inner_product(r1.begin(), r1.end(), r2.begin(), state, r, p);
 }
 
+namespace verify_detail {
+
+// Ranges are reduced in chunks of this many elements on the par_for pool. Partial results
+// are combined in chunk order, so they don't depend on the number of threads.
+constexpr std::size_t chunk_size = std::size_t{1} << 16;
+
+template <class R>
+using range_iterator = decltype(std::declval<R>().begin());
+
+template <class R>
+constexpr bool is_random_access_range = std::is_base_of_v<
+    std::random_access_iterator_tag,
+    typename std::iterator_traits<range_iterator<R>>::iterator_category>;
+
+template <class R1, class R2 = R1>
+constexpr bool is_parallel = is_random_access_range<R1> and is_random_access_range<R2>;
+
+/// Calls f(first, last) for the chunks of [0, n) in parallel and folds the results
+/// with combine, starting from init.
+template <class T, class F, class Combine>
+T reduce_chunks(std::size_t n, T init, F f, Combine combine)
+{
+    const auto chunks = (n + chunk_size - 1) / chunk_size;
+    std::vector<T> results(chunks, init);
+    par_for(chunks, 1, [&](std::size_t i) {
+        results[i] = f(i * chunk_size, std::min(n, (i + 1) * chunk_size));
+    });
+    return std::accumulate(results.begin(), results.end(), init, combine);
+}
+
+/// Index of the first element of [0, n) found by f(first, last), which returns last
+/// when its chunk has none, or n. Chunks after an already found element are skipped.
+template <class F>
+std::size_t find_first_chunked(std::size_t n, F f)
+{
+    std::atomic<std::size_t> found{n};
+    par_for((n + chunk_size - 1) / chunk_size, 1, [&](std::size_t i) {
+        const auto first = i * chunk_size;
+        const auto last  = std::min(n, first + chunk_size);
+        if(first >= found.load(std::memory_order_relaxed))
+            return;
+        const auto idx = f(first, last);
+        if(idx == last)
+            return;
+        auto prev = found.load(std::memory_order_relaxed);
+        while(idx < prev and not found.compare_exchange_weak(prev, idx)) {}
+    });
+    return found;
+}
+
+/// Distance in units in the last place between two values of the same floating point
+/// type, from their bit patterns, or -1 for non-finite values.
+template <class T>
+int64_t ulp_distance(T x, T y)
+{
+    if(not std::isfinite(static_cast<double>(x)) or not std::isfinite(static_cast<double>(y)))
+        return -1;
+
+    using bits_type = std::conditional_t<
+        sizeof(T) == 1,
+        uint8_t,
+        std::conditional_t<sizeof(T) == 2,
+                           uint16_t,
+                           std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+    static_assert(sizeof(T) == sizeof(bits_type), "Unsupported floating point type");
+
+    // Sign-magnitude bit patterns mapped to ordered integers, so +0 and -0 are equal
+    // and values of different signs are counted across zero.
+    const auto key = [](T v) {
+        bits_type bits;
+        std::memcpy(&bits, &v, sizeof(T));
+        constexpr auto sign = bits_type{1} << (8 * sizeof(T) - 1);
+        const auto mag      = static_cast<int64_t>(bits & static_cast<bits_type>(~sign));
+        return (bits & sign) != 0 ? -mag : mag;
+    };
+    const auto d = key(x) - key(y);
+    return d < 0 ? -d : d;
+}
+
+} // namespace verify_detail
+
+/// Metrics of two ranges collected in a single parallel pass by compare_range.
+struct range_compare_result
+{
+    static constexpr std::size_t ulp_buckets = 16;
+
+    std::size_t count         = 0;
+    double square_diff        = 0.0; // sum of (x - y)^2
+    double max_diff           = 0.0; // max |x - y|
+    std::size_t max_diff_idx  = 0;
+    double max_mag1           = 0.0; // max |x|
+    double max_mag2           = 0.0; // max |y|
+    std::size_t mismatch_idx  = 0;   // first index where !float_equal(x, y), or count
+    int64_t non_finite_idx1   = -1;
+    int64_t non_finite_idx2   = -1;
+    /// Bucket 0 counts equal values, bucket i the ones within [2^(i-1), 2^i) ulps and the
+    /// last one larger distances and non-finite values. Filled only when both ranges
+    /// have the same floating point type.
+    std::array<std::size_t, ulp_buckets> ulp_histogram{};
+
+    double rms() const
+    {
+        if(count == 0)
+            return 0;
+        const auto mag = std::max({max_mag1, max_mag2, std::numeric_limits<double>::min()});
+        return std::sqrt(square_diff) / (std::sqrt(count) * mag);
+    }
+
+    static range_compare_result combine(range_compare_result a, const range_compare_result& b)
+    {
+        if(b.max_diff > a.max_diff)
+        {
+            a.max_diff     = b.max_diff;
+            a.max_diff_idx = b.max_diff_idx;
+        }
+        if(a.mismatch_idx == a.count)
+            a.mismatch_idx = b.mismatch_idx;
+        if(a.non_finite_idx1 < 0)
+            a.non_finite_idx1 = b.non_finite_idx1;
+        if(a.non_finite_idx2 < 0)
+            a.non_finite_idx2 = b.non_finite_idx2;
+        a.count = b.count;
+        a.square_diff += b.square_diff;
+        a.max_mag1 = std::max(a.max_mag1, b.max_mag1);
+        a.max_mag2 = std::max(a.max_mag2, b.max_mag2);
+        for(std::size_t i = 0; i < ulp_buckets; ++i)
+            a.ulp_histogram[i] += b.ulp_histogram[i];
+        return a;
+    }
+};
+
+/// Computes RMS, max difference, first mismatch, non-finite values and the ULP histogram
+/// of two ranges of equal length in one pass, parallel for random access ranges.
+template <class R1, class R2>
+range_compare_result compare_range(R1&& r1, R2&& r2)
+{
+    using T1 = range_value<R1>;
+    using T2 = range_value<R2>;
+
+    const auto n = static_cast<std::size_t>(range_distance(r1));
+    assert(n == static_cast<std::size_t>(range_distance(r2)));
+
+    const auto chunk = [&](std::size_t first, std::size_t last) {
+        range_compare_result result;
+        // Indices are absolute and count is the end of the chunk, so results of
+        // consecutive chunks combine into the result of the whole range.
+        result.count        = last;
+        result.mismatch_idx = last;
+
+        auto it1 = std::next(r1.begin(), first);
+        auto it2 = std::next(r2.begin(), first);
+        for(auto i = first; i < last; ++i, ++it1, ++it2)
+        {
+            const T1 x = *it1;
+            const T2 y = *it2;
+
+            const auto dx   = static_cast<double>(x);
+            const auto dy   = static_cast<double>(y);
+            const auto diff = std::fabs(dx - dy);
+            result.square_diff += (dx - dy) * (dx - dy);
+            if(diff > result.max_diff)
+            {
+                result.max_diff     = diff;
+                result.max_diff_idx = i;
+            }
+            result.max_mag1 = std::max(result.max_mag1, std::fabs(dx));
+            result.max_mag2 = std::max(result.max_mag2, std::fabs(dy));
+
+            if(result.mismatch_idx == last and not float_equal(x, y))
+                result.mismatch_idx = i;
+            // Through double, which keeps inf and nan of every type including fp8
+            if(result.non_finite_idx1 < 0 and not std::isfinite(dx))
+                result.non_finite_idx1 = i;
+            if(result.non_finite_idx2 < 0 and not std::isfinite(dy))
+                result.non_finite_idx2 = i;
+
+            if constexpr(std::is_same_v<T1, T2> and not std::is_integral_v<T1>)
+            {
+                const auto ulps = verify_detail::ulp_distance(x, y);
+                auto bucket     = range_compare_result::ulp_buckets - 1;
+                if(ulps >= 0)
+                {
+                    bucket = 0;
+                    for(auto u = ulps; u != 0 and bucket < range_compare_result::ulp_buckets - 1;
+                        u >>= 1)
+                        ++bucket;
+                }
+                ++result.ulp_histogram[bucket];
+            }
+        }
+        return result;
+    };
+
+    auto init         = range_compare_result{};
+    init.mismatch_idx = 0;
+    if constexpr(verify_detail::is_parallel<R1, R2>)
+        return verify_detail::reduce_chunks(n, init, chunk, range_compare_result::combine);
+    else
+        return range_compare_result::combine(init, chunk(0, n));
+}
+
 template <class R1, class R2, class Compare>
 std::size_t mismatch_idx(R1&& r1, R2&& r2, Compare compare)
 {
-    auto p = std::mismatch(r1.begin(), r1.end(), r2.begin(), compare);
-    return std::distance(r1.begin(), p.first);
+    if constexpr(verify_detail::is_parallel<R1, R2>)
+    {
+        return verify_detail::find_first_chunked(
+            range_distance(r1), [&](std::size_t first, std::size_t last) {
+                auto p = std::mismatch(
+                    r1.begin() + first, r1.begin() + last, r2.begin() + first, compare);
+                return static_cast<std::size_t>(std::distance(r1.begin(), p.first));
+            });
+    }
+    else
+    {
+        auto p = std::mismatch(r1.begin(), r1.end(), r2.begin(), compare);
+        return std::distance(r1.begin(), p.first);
+    }
 }
 
 template <class R1, class Predicate>
 int64_t find_idx(R1&& r1, Predicate p)
 {
-    auto it = std::find_if(r1.begin(), r1.end(), p);
-    if(it == r1.end())
-        return -1;
+    if constexpr(verify_detail::is_parallel<R1>)
+    {
+        const std::size_t n = range_distance(r1);
+        const auto idx =
+            verify_detail::find_first_chunked(n, [&](std::size_t first, std::size_t last) {
+                auto it = std::find_if(r1.begin() + first, r1.begin() + last, p);
+                return static_cast<std::size_t>(std::distance(r1.begin(), it));
+            });
+        return idx == n ? -1 : static_cast<int64_t>(idx);
+    }
     else
-        return std::distance(r1.begin(), it);
+    {
+        auto it = std::find_if(r1.begin(), r1.end(), p);
+        if(it == r1.end())
+            return -1;
+        else
+            return std::distance(r1.begin(), it);
+    }
 }
 
 template <class R1, class R2>
 double max_diff(R1&& r1, R2&& r2)
 {
-    return range_product(r1, r2, 0.0, max, abs_diff);
+    if constexpr(verify_detail::is_parallel<R1, R2>)
+    {
+        return verify_detail::reduce_chunks(
+            range_distance(r1),
+            0.0,
+            [&](std::size_t first, std::size_t last) {
+                return std::inner_product(r1.begin() + first,
+                                          r1.begin() + last,
+                                          r2.begin() + first,
+                                          0.0,
+                                          max,
+                                          abs_diff);
+            },
+            max);
+    }
+    else
+    {
+        return range_product(r1, r2, 0.0, max, abs_diff);
+    }
 }
 
 template <class R1, class R2>
@@ -218,9 +467,42 @@ double rms_range(R1&& r1, R2&& r2)
     {
         if(n == 0)
             return 0;
-        double square_difference = range_product(r1, r2, 0.0, sum_fn{}, square_diff);
-        double mag1 = static_cast<double>(*std::max_element(r1.begin(), r1.end(), compare_mag));
-        double mag2 = static_cast<double>(*std::max_element(r2.begin(), r2.end(), compare_mag));
+        double square_difference = 0.0;
+        double mag1              = 0.0;
+        double mag2              = 0.0;
+        if constexpr(verify_detail::is_parallel<R1, R2>)
+        {
+            using partial = std::array<double, 3>; // square difference, mag1, mag2
+            const auto result = verify_detail::reduce_chunks(
+                n,
+                partial{},
+                [&](std::size_t first, std::size_t last) {
+                    auto chunk = partial{};
+                    auto it1   = r1.begin() + first;
+                    auto it2   = r2.begin() + first;
+                    for(auto i = first; i < last; ++i, ++it1, ++it2)
+                    {
+                        const auto x = static_cast<double>(*it1);
+                        const auto y = static_cast<double>(*it2);
+                        chunk[0] += (x - y) * (x - y);
+                        chunk[1] = std::max(chunk[1], std::fabs(x));
+                        chunk[2] = std::max(chunk[2], std::fabs(y));
+                    }
+                    return chunk;
+                },
+                [](partial a, const partial& b) {
+                    return partial{a[0] + b[0], std::max(a[1], b[1]), std::max(a[2], b[2])};
+                });
+            square_difference = result[0];
+            mag1              = result[1];
+            mag2              = result[2];
+        }
+        else
+        {
+            square_difference = range_product(r1, r2, 0.0, sum_fn{}, square_diff);
+            mag1 = static_cast<double>(*std::max_element(r1.begin(), r1.end(), compare_mag));
+            mag2 = static_cast<double>(*std::max_element(r2.begin(), r2.end(), compare_mag));
+        }
         double mag =
             std::max({std::fabs(mag1), std::fabs(mag2), std::numeric_limits<double>::min()});
         return std::sqrt(square_difference) / (std::sqrt(n) * mag);
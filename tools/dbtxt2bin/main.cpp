@@ -0,0 +1,54 @@
+#include <miopen/readonly_db_image.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+int main(int argn, char** args)
+{
+    if(argn < 2 || argn > 3)
+    {
+        std::cerr << "Usage:" << std::endl;
+        std::cerr << args[0] << " input_path [output_path]" << std::endl;
+        std::cerr << "input_path - path to the input file, expected to be text find-db or perf-db."
+                  << std::endl;
+        std::cerr << "output_path - optional path to the output file. Existing file would be "
+                     "replaced. Defaults to the input_path with .bin appended to the end"
+                  << std::endl;
+        return 1;
+    }
+
+    const std::string in_filename  = args[1];
+    const std::string out_filename = argn > 2 ? args[2] : (in_filename + miopen::rodb::Extension);
+
+    auto in = std::ifstream{in_filename, std::ios::binary};
+    if(!in)
+    {
+        std::cerr << "Unable to open " << in_filename << std::endl;
+        return 1;
+    }
+
+    // The same way as the MIOpen does it when checking if the image is stale.
+    in.seekg(0, std::ios::end);
+    const auto source_size = static_cast<std::uint64_t>(in.tellg());
+    in.seekg(0, std::ios::beg);
+
+    // Write to memory first to never leave a partial image on disk.
+    auto image   = std::ostringstream{};
+    const auto n = miopen::rodb::WriteImage(in, source_size, image, [&](unsigned line) {
+        std::cerr << "Ill-formed record: key not found: " << in_filename << "#" << line
+                  << std::endl;
+    });
+
+    auto out = std::ofstream{out_filename, std::ios::binary | std::ios::trunc};
+    out << image.str();
+    if(!out)
+    {
+        std::cerr << "Error writing " << out_filename << std::endl;
+        return 1;
+    }
+
+    std::cout << in_filename << ": " << n << " records" << std::endl;
+    return 0;
+}
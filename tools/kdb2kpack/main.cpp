@@ -0,0 +1,289 @@
+#include <miopen/kern_pack.hpp>
+#include <miopen/md5.hpp>
+
+#include <bzlib.h>
+#include <sqlite3.h>
+#if MIOPEN_USE_ZSTD
+#include <zstd.h>
+#endif
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Values of the `codec` column of the kernel cache, see miopen::KernDbCodec.
+constexpr std::int64_t CodecNone  = 0;
+constexpr std::int64_t CodecBZip2 = 1;
+constexpr std::int64_t CodecZstd  = 2;
+
+using Db        = std::unique_ptr<sqlite3, int (*)(sqlite3*)>;
+using Statement = std::unique_ptr<sqlite3_stmt, int (*)(sqlite3_stmt*)>;
+
+Statement Prepare(sqlite3* db, const std::string& sql)
+{
+    sqlite3_stmt* stmt = nullptr;
+    if(sqlite3_prepare_v2(db, sql.c_str(), static_cast<int>(sql.length()), &stmt, nullptr) !=
+           SQLITE_OK ||
+       stmt == nullptr)
+        throw std::runtime_error(std::string{"Error while preparing SQL statement: "} +
+                                 sqlite3_errmsg(db) + " {" + sql + "}");
+    return {stmt, &sqlite3_finalize};
+}
+
+std::string ColumnText(sqlite3_stmt* stmt, int idx)
+{
+    const auto* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, idx));
+    return {text, static_cast<std::size_t>(sqlite3_column_bytes(stmt, idx))};
+}
+
+std::vector<char> ColumnBlob(sqlite3_stmt* stmt, int idx)
+{
+    const auto* blob = static_cast<const char*>(sqlite3_column_blob(stmt, idx));
+    return {blob, blob + sqlite3_column_bytes(stmt, idx)};
+}
+
+bool HasColumn(sqlite3* db, const std::string& table, const std::string& column)
+{
+    auto stmt = Prepare(db, "PRAGMA table_info(" + table + ");");
+    while(sqlite3_step(stmt.get()) == SQLITE_ROW)
+    {
+        if(ColumnText(stmt.get(), 1) == column)
+            return true;
+    }
+    return false;
+}
+
+struct RecordCodec
+{
+    std::int64_t id;
+    std::int64_t codec;
+    std::int64_t dict_id;
+    /// md5 of the code object as it was before the compression.
+    std::string md5;
+    /// 0 if the code object is stored as is.
+    std::uint64_t uncompressed_size;
+};
+
+class KernelCache
+{
+public:
+    explicit KernelCache(const std::string& path) : db(Open(path))
+    {
+        has_codec_fields = HasColumn(db.get(), "kern_db", "codec");
+    }
+
+    /// The records in the order they were added.
+    void List(std::vector<miopen::kpack::SourceRecord>& records, std::vector<RecordCodec>& codecs)
+    {
+        auto stmt = Prepare(db.get(),
+                            std::string{"SELECT id, kernel_name, kernel_args, uncompressed_size, "
+                                        "length(kernel_blob), kernel_hash"} +
+                                (has_codec_fields ? ", codec, dict_id" : "") +
+                                " FROM kern_db ORDER BY id;");
+        while(sqlite3_step(stmt.get()) == SQLITE_ROW)
+        {
+            auto codec              = RecordCodec{};
+            codec.id                = sqlite3_column_int64(stmt.get(), 0);
+            codec.uncompressed_size = sqlite3_column_int64(stmt.get(), 3);
+            codec.md5               = ColumnText(stmt.get(), 5);
+            codec.codec   = has_codec_fields ? sqlite3_column_int64(stmt.get(), 6) : CodecBZip2;
+            codec.dict_id = has_codec_fields ? sqlite3_column_int64(stmt.get(), 7) : 0;
+
+            auto record = miopen::kpack::SourceRecord{};
+            record.name = ColumnText(stmt.get(), 1);
+            record.args = ColumnText(stmt.get(), 2);
+            record.size = codec.uncompressed_size != 0
+                              ? codec.uncompressed_size
+                              : static_cast<std::uint64_t>(sqlite3_column_int64(stmt.get(), 4));
+
+            records.push_back(std::move(record));
+            codecs.push_back(codec);
+        }
+    }
+
+    /// Decompresses the record and checks it against the md5 stored with it.
+    std::vector<char> Read(const RecordCodec& record)
+    {
+        auto code_object = Decode(record);
+        if(miopen::md5(code_object) != record.md5)
+            throw std::runtime_error("Record " + std::to_string(record.id) + " is corrupted");
+        return code_object;
+    }
+
+private:
+    Db db;
+    bool has_codec_fields = false;
+
+    std::vector<char> Decode(const RecordCodec& record)
+    {
+        auto stmt = Prepare(db.get(), "SELECT kernel_blob FROM kern_db WHERE id = ?;");
+        sqlite3_bind_int64(stmt.get(), 1, record.id);
+        if(sqlite3_step(stmt.get()) != SQLITE_ROW)
+            throw std::runtime_error("Record " + std::to_string(record.id) + " is missing");
+        auto blob = ColumnBlob(stmt.get(), 0);
+        if(record.uncompressed_size == 0 || record.codec == CodecNone)
+            return blob;
+
+        auto decompressed = std::vector<char>(record.uncompressed_size);
+        if(record.codec == CodecBZip2)
+        {
+            auto size = static_cast<unsigned int>(decompressed.size());
+            if(BZ2_bzBuffToBuffDecompress(decompressed.data(),
+                                          &size,
+                                          blob.data(),
+                                          static_cast<unsigned int>(blob.size()),
+                                          0,
+                                          0) != BZ_OK ||
+               size != decompressed.size())
+                throw std::runtime_error("Unable to decompress record " +
+                                         std::to_string(record.id));
+            return decompressed;
+        }
+#if MIOPEN_USE_ZSTD
+        if(record.codec == CodecZstd)
+        {
+            const auto size = record.dict_id != 0
+                                  ? ZSTD_decompress_usingDDict(GetContext(),
+                                                               decompressed.data(),
+                                                               decompressed.size(),
+                                                               blob.data(),
+                                                               blob.size(),
+                                                               GetDictionary(record.dict_id))
+                                  : ZSTD_decompressDCtx(GetContext(),
+                                                        decompressed.data(),
+                                                        decompressed.size(),
+                                                        blob.data(),
+                                                        blob.size());
+            if(ZSTD_isError(size) != 0 || size != decompressed.size())
+                throw std::runtime_error("Unable to decompress record " +
+                                         std::to_string(record.id));
+            return decompressed;
+        }
+#endif
+        throw std::runtime_error("Record " + std::to_string(record.id) +
+                                 " has unsupported codec " + std::to_string(record.codec));
+    }
+
+    static Db Open(const std::string& path)
+    {
+        sqlite3* raw = nullptr;
+        const auto rc = sqlite3_open_v2(
+            path.c_str(), &raw, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, nullptr);
+        auto db = Db{raw, &sqlite3_close_v2};
+        if(rc != SQLITE_OK)
+            throw std::runtime_error("Unable to open " + path);
+        return db;
+    }
+
+#if MIOPEN_USE_ZSTD
+    std::unique_ptr<ZSTD_DCtx, std::size_t (*)(ZSTD_DCtx*)> context{nullptr, &ZSTD_freeDCtx};
+    std::map<std::int64_t, std::unique_ptr<ZSTD_DDict, std::size_t (*)(ZSTD_DDict*)>>
+        dictionaries;
+
+    ZSTD_DCtx* GetContext()
+    {
+        if(!context)
+            context.reset(ZSTD_createDCtx());
+        if(!context)
+            throw std::runtime_error("Unable to create a decompression context");
+        return context.get();
+    }
+
+    const ZSTD_DDict* GetDictionary(std::int64_t id)
+    {
+        const auto it = dictionaries.find(id);
+        if(it != dictionaries.end())
+            return it->second.get();
+
+        auto stmt = Prepare(db.get(), "SELECT dict FROM kern_db_dict WHERE id = ?;");
+        sqlite3_bind_int64(stmt.get(), 1, id);
+        if(sqlite3_step(stmt.get()) != SQLITE_ROW)
+            throw std::runtime_error("Dictionary " + std::to_string(id) + " is missing");
+        const auto dict = ColumnBlob(stmt.get(), 0);
+        auto ddict      = std::unique_ptr<ZSTD_DDict, std::size_t (*)(ZSTD_DDict*)>{
+            ZSTD_createDDict(dict.data(), dict.size()), &ZSTD_freeDDict};
+        if(!ddict)
+            throw std::runtime_error("Unable to load dictionary " + std::to_string(id));
+        return dictionaries.emplace(id, std::move(ddict)).first->second.get();
+    }
+#endif
+};
+
+} // namespace
+
+int main(int argn, char** args)
+{
+    if(argn < 2 || argn > 3)
+    {
+        std::cerr << "Usage:" << std::endl;
+        std::cerr << args[0] << " input_path [output_path]" << std::endl;
+        std::cerr << "input_path - path to the input file, expected to be a system kernel cache "
+                     "(.kdb)."
+                  << std::endl;
+        std::cerr << "output_path - optional path to the output file. Existing file would be "
+                     "replaced. Defaults to the input_path with the extension replaced by "
+                  << miopen::kpack::Extension << std::endl;
+        return 1;
+    }
+
+    const std::string in_filename  = args[1];
+    const std::string out_filename = [&]() {
+        if(argn > 2)
+            return std::string{args[2]};
+        const auto dot = in_filename.find_last_of('.');
+        const auto sep = in_filename.find_last_of("/\\");
+        const auto stem =
+            dot != std::string::npos && (sep == std::string::npos || dot > sep)
+                ? in_filename.substr(0, dot)
+                : in_filename;
+        return stem + miopen::kpack::Extension;
+    }();
+
+    // Write to a temporary file first to never leave a partial pack in place.
+    const auto tmp_filename = out_filename + ".tmp";
+
+    try
+    {
+        // The same way as the MIOpen does it when checking if the pack is stale.
+        auto source = miopen::kpack::SourceStamp{};
+        if(!miopen::kpack::GetSourceStamp(in_filename, source))
+        {
+            std::cerr << "Unable to open " << in_filename << std::endl;
+            return 1;
+        }
+
+        auto cache   = KernelCache{in_filename};
+        auto records = std::vector<miopen::kpack::SourceRecord>{};
+        auto codecs  = std::vector<RecordCodec>{};
+        cache.List(records, codecs);
+
+        auto out     = std::ofstream{tmp_filename, std::ios::binary | std::ios::trunc};
+        const auto n = miopen::kpack::WritePack(
+            records, source, out, [&](const miopen::kpack::SourceRecord& record) {
+                return cache.Read(codecs[&record - records.data()]);
+            });
+        out.close();
+        if(!out || std::rename(tmp_filename.c_str(), out_filename.c_str()) != 0)
+        {
+            std::remove(tmp_filename.c_str());
+            std::cerr << "Error writing " << out_filename << std::endl;
+            return 1;
+        }
+
+        std::cout << in_filename << ": " << n << " kernels" << std::endl;
+        return 0;
+    }
+    catch(const std::exception& ex)
+    {
+        std::remove(tmp_filename.c_str());
+        std::cerr << in_filename << ": " << ex.what() << std::endl;
+        return 1;
+    }
+}
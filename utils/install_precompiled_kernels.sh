@@ -16,6 +16,13 @@ fi
 arches=$($ROCMINFO | grep -e ' gfx' -e 'Compute Unit:' | awk '/Name/{ arch= $2} /Compute Unit:/ {if(arch != "") { all_arches[(arch "-" $3)] }} END { for (a in all_arches) { print a}  }')
 backend="hip"
 
+KDB2KPACK=$(which kdb2kpack)
+if [ -z "$KDB2KPACK" ];
+then
+    KDB2KPACK=/opt/rocm/bin/kdb2kpack;
+fi
+MIOPEN_SYSTEM_DB_PATH=${MIOPEN_SYSTEM_DB_PATH:-/opt/rocm/share/miopen/db}
+
 while IFS= read -r line ; 
 do
     arch=$(echo $line | awk -F"-" '{print $1}')
@@ -36,4 +43,10 @@ do
         echo "Unknown distribution"
         echo "Please install the miopen-${backend}-${package}kdb package using an appropriate package manager"
     fi
+    # Memory-mapped packs of the installed kernels, see kdb2kpack.
+    if [ -x "$KDB2KPACK" ]; then
+        for kdb in "$MIOPEN_SYSTEM_DB_PATH"/${arch}*.kdb; do
+            [ -f "$kdb" ] && $SUDO "$KDB2KPACK" "$kdb"
+        done
+    fi
 done <<< "$arches"